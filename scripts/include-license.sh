@@ -1,6 +1,6 @@
 #!/bin/bash
 
-for i in $(find src -name '*.cpp' -o -name '*.h');
+for i in $(find src tools -name '*.cpp' -o -name '*.h');
 do
   if ! grep -q Copyright "$i"
   then
@@ -0,0 +1,240 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cli.h"
+#include "pack3r_daemon.h"
+#include "pack3r_process_handler.h"
+#include "preferences.h"
+
+#include <QCoreApplication>
+#include <cstdio>
+
+namespace {
+const QStringList cliModes = {"--daemon", "--submit", "--attach", "--cancel",
+                              "--list"};
+}
+
+bool Cli::isCliInvocation(const int argc, char *argv[]) {
+  for (int i = 1; i < argc; i++) {
+    const QString arg = QString::fromLocal8Bit(argv[i]);
+
+    // everything after '--' belongs to the submitted Pack3r command
+    if (arg == "--") {
+      break;
+    }
+
+    if (cliModes.contains(arg)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+int Cli::run(int argc, char *argv[]) {
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName(PROJECT_NAME);
+  QCoreApplication::setApplicationVersion(PROJECT_VERSION);
+
+  preferences.init();
+
+  QCommandLineParser parser{};
+  parser.setApplicationDescription(
+      "Headless interface to the QtPack3r pack daemon");
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addOptions({
+      {"daemon", "Run the pack daemon in the foreground."},
+      {"jobs", "Maximum number of concurrent jobs run by the daemon.", "count"},
+      {"submit", "Submit the Pack3r command after '--' to the daemon."},
+      {"attach", "Follow the output of a queued or running job.", "id"},
+      {"cancel", "Cancel a queued or running job.", "id"},
+      {"list", "List queued and running jobs."},
+      {"overwrite", "Answer 'yes' if Pack3r asks to overwrite the output."},
+  });
+  parser.addPositionalArgument("command",
+                               "Pack3r executable and arguments, the daemon "
+                               "runs the Pack3r set in its preferences.",
+                               "-- <pack3r> [args...]");
+  parser.process(app);
+
+  if (parser.isSet("daemon")) {
+    return runDaemon(parser);
+  }
+
+  if (parser.isSet("submit") || parser.isSet("attach")) {
+    return followJob(parser);
+  }
+
+  if (parser.isSet("cancel")) {
+    return cancelJob(parser);
+  }
+
+  return listJobs();
+}
+
+int Cli::runDaemon(const QCommandLineParser &parser) {
+  int maxJobs =
+      preferences.readSetting(Preferences::Settings::MAX_CONCURRENT_JOBS)
+          .toInt();
+
+  if (parser.isSet("jobs")) {
+    maxJobs = parser.value("jobs").toInt();
+  }
+
+  Pack3rDaemon daemon(nullptr, maxJobs);
+
+  if (!daemon.listen()) {
+    fprintf(stderr, "Unable to start pack daemon: %s\n",
+            qUtf8Printable(daemon.errorString()));
+    return EXIT_FAILURE;
+  }
+
+  fprintf(stderr, "Pack daemon listening on '%s' with %d concurrent jobs\n",
+          qUtf8Printable(Pack3rDaemon::socketName()), qMax(1, maxJobs));
+  return QCoreApplication::exec();
+}
+
+int Cli::followJob(const QCommandLineParser &parser) {
+  Pack3rDaemonClient client(nullptr);
+
+  if (!client.connectToDaemon()) {
+    fprintf(stderr, "Pack daemon is not running\n");
+    return EXIT_FAILURE;
+  }
+
+  const bool overwrite = parser.isSet("overwrite");
+  bool overwritePrompted = false;
+  quint64 jobId = 0;
+
+  QObject::connect(&client, &Pack3rDaemonClient::jobAccepted,
+                   [&](quint64, const quint64 id, const bool attached) {
+                     jobId = id;
+                     fprintf(stderr, "%s job #%llu\n",
+                             attached ? "Attached to running" : "Submitted",
+                             static_cast<unsigned long long>(id));
+                   });
+
+  QObject::connect(
+      &client, &Pack3rDaemonClient::jobOutput,
+      [&](const quint64 id, const QByteArray &data) {
+        if (id != jobId) {
+          return;
+        }
+
+        fwrite(data.constData(), 1, data.size(), stdout);
+        fflush(stdout);
+
+        if (!overwritePrompted && data.contains(PACK3R_OVERWRITE_PROMPT)) {
+          overwritePrompted = true;
+          client.write(id, overwrite ? "y\n" : "n\n");
+        }
+      });
+
+  QObject::connect(&client, &Pack3rDaemonClient::jobFinished,
+                   [&](const quint64 id, const int exitCode,
+                       const bool canceled) {
+                     if (id == jobId) {
+                       QCoreApplication::exit(canceled ? EXIT_FAILURE
+                                                       : exitCode);
+                     }
+                   });
+
+  QObject::connect(&client, &Pack3rDaemonClient::errorReceived,
+                   [](const QString &message) {
+                     fprintf(stderr, "%s\n", qUtf8Printable(message));
+                     QCoreApplication::exit(EXIT_FAILURE);
+                   });
+
+  QObject::connect(&client, &Pack3rDaemonClient::disconnected, [] {
+    fprintf(stderr, "Lost connection to pack daemon\n");
+    QCoreApplication::exit(EXIT_FAILURE);
+  });
+
+  if (parser.isSet("attach")) {
+    jobId = parser.value("attach").toULongLong();
+    client.attach(jobId);
+  } else {
+    const QStringList command = parser.positionalArguments();
+
+    if (command.isEmpty()) {
+      fprintf(stderr, "No Pack3r command given after '--'\n");
+      return EXIT_FAILURE;
+    }
+
+    client.submit(command.first(), command.mid(1), {});
+  }
+
+  return QCoreApplication::exec();
+}
+
+int Cli::cancelJob(const QCommandLineParser &parser) {
+  Pack3rDaemonClient client(nullptr);
+
+  if (!client.connectToDaemon()) {
+    fprintf(stderr, "Pack daemon is not running\n");
+    return EXIT_FAILURE;
+  }
+
+  client.cancel(parser.value("cancel").toULongLong());
+
+  // there's no reply to a cancel, the list reply just tells us that
+  // the daemon has processed the request before we disconnect
+  QObject::connect(&client, &Pack3rDaemonClient::jobListReceived,
+                   [] { QCoreApplication::exit(EXIT_SUCCESS); });
+  client.requestJobList();
+
+  return QCoreApplication::exec();
+}
+
+int Cli::listJobs() {
+  Pack3rDaemonClient client(nullptr);
+
+  if (!client.connectToDaemon()) {
+    fprintf(stderr, "Pack daemon is not running\n");
+    return EXIT_FAILURE;
+  }
+
+  QObject::connect(&client, &Pack3rDaemonClient::jobListReceived,
+                   [](const QJsonArray &jobs) {
+                     for (const auto &value : jobs) {
+                       const QJsonObject job = value.toObject();
+                       QStringList arguments{};
+
+                       for (const auto &arg : job["arguments"].toArray()) {
+                         arguments.append(arg.toString());
+                       }
+
+                       printf("#%lld\t%s\t%s %s\n", job["id"].toInteger(),
+                              qUtf8Printable(job["state"].toString()),
+                              qUtf8Printable(job["program"].toString()),
+                              qUtf8Printable(arguments.join(" ")));
+                     }
+
+                     QCoreApplication::exit(EXIT_SUCCESS);
+                   });
+  client.requestJobList();
+
+  return QCoreApplication::exec();
+}
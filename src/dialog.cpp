@@ -49,6 +49,15 @@ void Dialog::setupMessageBox(QMessageBox &messageBox, const MessageBox type) {
   case INVALID_PACK3R_BINARY:
     setupInvalidPack3rBinaryMessageBox(messageBox);
     break;
+  case ENQUEUE_MAPS:
+    setupEnqueueMapsMessageBox(messageBox);
+    break;
+  case RUN_DIAGNOSTICS:
+    setupRunDiagnosticsMessageBox(messageBox);
+    break;
+  case RUNTIME_BENCHMARK:
+    setupRuntimeBenchmarkMessageBox(messageBox);
+    break;
   default:
     break;
   }
@@ -108,3 +117,36 @@ void Dialog::setupInvalidPack3rBinaryMessageBox(QMessageBox &messageBox) {
          "Please select a different file."));
   messageBox.setWindowModality(Qt::ApplicationModal);
 }
+
+void Dialog::setupEnqueueMapsMessageBox(QMessageBox &messageBox) {
+  messageBox.setWindowTitle(tr("Pack multiple maps?"));
+  messageBox.setInformativeText(
+      tr("Each map is packed with the currently selected options, and the "
+         "output is written next to the map like it would be when selecting "
+         "a single map."));
+  messageBox.setIcon(QMessageBox::Question);
+  messageBox.setStandardButtons(QMessageBox::No | QMessageBox::Yes);
+  messageBox.setWindowModality(Qt::ApplicationModal);
+}
+
+void Dialog::setupRunDiagnosticsMessageBox(QMessageBox &messageBox) {
+  messageBox.setWindowTitle(tr("Run diagnostics"));
+  messageBox.setInformativeText(
+      tr("Event loop latency is how late the interface was able to react to "
+         "input and repaint during the last run. Output handling is the time "
+         "spent processing each piece of Pack3r output."));
+  messageBox.setIcon(QMessageBox::Information);
+  messageBox.setStandardButtons(QMessageBox::Ok);
+  messageBox.setWindowModality(Qt::ApplicationModal);
+}
+
+void Dialog::setupRuntimeBenchmarkMessageBox(QMessageBox &messageBox) {
+  messageBox.setWindowTitle(tr("Benchmark runtime profiles"));
+  messageBox.setInformativeText(
+      tr("The selected map is packed with the current options several times "
+         "under each runtime profile. Output is written to a temporary "
+         "directory and discarded."));
+  messageBox.setIcon(QMessageBox::Question);
+  messageBox.setStandardButtons(QMessageBox::No | QMessageBox::Yes);
+  messageBox.setWindowModality(Qt::ApplicationModal);
+}
@@ -37,6 +37,9 @@ class Dialog : public QWidget {
     PACK3R_RUN_ERROR, // does NOT call setText() nor setInformativeText()
     RESET_PREFERENCES,
     INVALID_PACK3R_BINARY,
+    ENQUEUE_MAPS,      // does NOT call setText()
+    RUN_DIAGNOSTICS,   // does NOT call setText()
+    RUNTIME_BENCHMARK, // does NOT call setText()
   };
 
   static void setupMessageBox(QMessageBox &messageBox, MessageBox type);
@@ -48,4 +51,7 @@ class Dialog : public QWidget {
   static void setupPack3rRunErrorMessageBox(QMessageBox &messageBox);
   static void setupResetPreferencesMessageBox(QMessageBox &messageBox);
   static void setupInvalidPack3rBinaryMessageBox(QMessageBox &messageBox);
+  static void setupEnqueueMapsMessageBox(QMessageBox &messageBox);
+  static void setupRunDiagnosticsMessageBox(QMessageBox &messageBox);
+  static void setupRuntimeBenchmarkMessageBox(QMessageBox &messageBox);
 };
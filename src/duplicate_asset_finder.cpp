@@ -0,0 +1,558 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "duplicate_asset_finder.h"
+#include "filesystem.h"
+#include "pk3_archive.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QLocale>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <algorithm>
+#include <optional>
+
+namespace {
+constexpr quint32 CACHE_MAGIC = 0x51504143; // "QPAC"
+constexpr quint32 CACHE_VERSION = 1;
+const QString cacheFilename = "asset_checksums.dat";
+
+// map sources and compiler output, which are never shipped
+const QStringList ignoredSuffixes = {
+    "map", "reg", "bak", "autosave", "prt", "lin", "srf", "pk3",
+};
+
+constexpr int MAX_LISTED_GROUPS = 50;
+constexpr int MAX_LISTED_MEMBERS = 10;
+
+QByteArray line(const QString &str) { return "[duplicates] " + str.toUtf8(); }
+
+std::optional<quint32> fileChecksum(const QString &path, const quint64 size) {
+  QFile file(path);
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    return std::nullopt;
+  }
+
+  // mapping avoids copying the file, but isn't possible everywhere
+  if (const uchar *data = file.map(0, static_cast<qint64>(size))) {
+    return Pk3Archive::crc32(
+        {reinterpret_cast<const char *>(data), static_cast<qsizetype>(size)});
+  }
+
+  quint32 crc = 0;
+
+  while (!file.atEnd()) {
+    const QByteArray chunk = file.read(1024 * 1024);
+
+    if (chunk.isEmpty()) {
+      return std::nullopt;
+    }
+
+    crc = Pk3Archive::crc32(chunk, crc);
+  }
+
+  return crc;
+}
+} // namespace
+
+DuplicateAssetFinder::DuplicateAssetFinder(QObject *parent)
+    : QObject(parent), watcher(new QFutureWatcher<QByteArray>(this)) {
+  connect(watcher, &QFutureWatcher<QByteArray>::resultReadyAt, this,
+          [this](const int index) {
+            emit outputLine(watcher->resultAt(index));
+          });
+  connect(watcher, &QFutureWatcher<QByteArray>::finished, this,
+          [this] { emit finished(); });
+}
+
+void DuplicateAssetFinder::run(const QString &mapsPath, const QString &mapPk3,
+                               const QStringList &noPackNames) {
+  if (isRunning()) {
+    return;
+  }
+
+  watcher->setFuture(QtConcurrent::run(&DuplicateAssetFinder::find, mapsPath,
+                                       mapPk3, noPackNames));
+}
+
+bool DuplicateAssetFinder::isRunning() const { return watcher->isRunning(); }
+
+void DuplicateAssetFinder::find(QPromise<QByteArray> &promise,
+                                const QString &mapsPath, const QString &mapPk3,
+                                const QStringList &noPackNames) {
+  const QLocale locale{};
+  QElapsedTimer timer{};
+  timer.start();
+
+  promise.addResult(line(QObject::tr("Scanning %1").arg(mapsPath)));
+
+  QStringList pk3Files{};
+  QList<Asset> assets = collectLooseFiles(mapsPath, pk3Files);
+
+  // the map's own pk3 is built from assets in the install,
+  // so it would duplicate all of them
+  const QFileInfo mapPk3Info(mapPk3);
+  pk3Files.removeIf([&mapPk3Info](const QString &pk3) {
+    return QFileInfo(pk3) == mapPk3Info;
+  });
+
+  assets += QtConcurrent::blockingMappedReduced<QList<Asset>>(
+      pk3Files, &DuplicateAssetFinder::readPk3,
+      [](QList<Asset> &result, const QList<Asset> &pk3Assets) {
+        result += pk3Assets;
+      });
+
+  const QList<Asset> mapAssets =
+      mapPk3Info.isFile() ? readPk3(mapPk3) : QList<Asset>{};
+
+  // only files with the same size can be identical,
+  // so loose files with a unique size are never read
+  QHash<quint64, int> sizeCounts{};
+
+  for (const auto &asset : assets) {
+    sizeCounts[asset.size]++;
+  }
+
+  for (const auto &asset : mapAssets) {
+    sizeCounts[asset.size]++;
+  }
+
+  const QHash<QString, CachedChecksum> cache = loadCache();
+  QHash<QString, CachedChecksum> newCache{};
+  QList<qsizetype> unhashed{};
+  QList<qsizetype> comparable{};
+
+  for (qsizetype i = 0; i < assets.size(); i++) {
+    Asset &asset = assets[i];
+
+    if (sizeCounts[asset.size] < 2) {
+      continue;
+    }
+
+    if (asset.entry >= 0) {
+      comparable.append(i);
+      continue;
+    }
+
+    const auto cached = cache.constFind(asset.filePath);
+
+    if (cached != cache.cend() && cached->size == asset.size &&
+        cached->modified == asset.modified) {
+      asset.crc32 = cached->crc32;
+      newCache.insert(asset.filePath, *cached);
+      comparable.append(i);
+    } else {
+      unhashed.append(i);
+    }
+  }
+
+  promise.addResult(
+      line(QObject::tr("%1 assets in %2 pk3s, reading %3 loose files with "
+                       "non-unique sizes (%4 cached)")
+               .arg(assets.size())
+               .arg(pk3Files.size())
+               .arg(unhashed.size())
+               .arg(newCache.size())));
+
+  const auto checksums =
+      QtConcurrent::blockingMapped<QList<std::optional<quint32>>>(
+          unhashed, [&assets](const qsizetype index) {
+            return fileChecksum(assets[index].filePath, assets[index].size);
+          });
+
+  for (qsizetype i = 0; i < unhashed.size(); i++) {
+    if (!checksums[i]) {
+      continue;
+    }
+
+    Asset &asset = assets[unhashed[i]];
+    asset.crc32 = *checksums[i];
+    newCache.insert(asset.filePath, {asset.size, asset.modified, asset.crc32});
+    comparable.append(unhashed[i]);
+  }
+
+  // only entries for files that still exist are kept
+  saveCache(newCache);
+
+  QHash<QPair<quint64, quint32>, QList<qsizetype>> groups{};
+
+  for (const auto i : comparable) {
+    groups[{assets[i].size, assets[i].crc32}].append(i);
+  }
+
+  // candidates are compared byte by byte, with every pk3 they're in
+  // opened once up front, as entries can be read from several threads
+  QList<QList<qsizetype>> candidates{};
+  Archives archives{};
+
+  const auto openArchive = [&archives](const QString &path) {
+    if (!archives.contains(path)) {
+      auto archive = std::make_shared<Pk3Archive>(path);
+
+      if (archive->open()) {
+        archives.insert(path, archive);
+      }
+    }
+  };
+
+  for (const auto &group : groups) {
+    if (group.size() < 2) {
+      continue;
+    }
+
+    candidates.append(group);
+
+    for (const auto i : group) {
+      if (assets[i].entry >= 0) {
+        openArchive(assets[i].filePath);
+      }
+    }
+  }
+
+  if (!mapAssets.isEmpty()) {
+    openArchive(mapPk3);
+  }
+
+  const auto confirmed =
+      QtConcurrent::blockingMapped<QList<QList<QList<qsizetype>>>>(
+          candidates, [&assets, &archives](const QList<qsizetype> &group) {
+            return confirmGroup(group, assets, archives);
+          });
+
+  QList<QList<qsizetype>> duplicates{};
+  quint64 wasted = 0;
+
+  for (const auto &identical : confirmed) {
+    for (const auto &group : identical) {
+      duplicates.append(group);
+      wasted += assets[group.first()].size * (group.size() - 1);
+    }
+  }
+
+  // largest waste first
+  std::sort(duplicates.begin(), duplicates.end(),
+            [&assets](const auto &a, const auto &b) {
+              return assets[a.first()].size * (a.size() - 1) >
+                     assets[b.first()].size * (b.size() - 1);
+            });
+
+  const auto displayName = [](const Asset &asset) {
+    return asset.container.isEmpty() ? asset.name
+                                     : asset.container + ":" + asset.name;
+  };
+
+  promise.addResult(
+      line(QObject::tr("%1 groups of identical assets, %2 wasted")
+               .arg(duplicates.size())
+               .arg(locale.formattedDataSize(static_cast<qint64>(wasted)))));
+
+  for (qsizetype i = 0; i < qMin<qsizetype>(duplicates.size(),
+                                             MAX_LISTED_GROUPS);
+       i++) {
+    const auto &group = duplicates[i];
+
+    promise.addResult(line(
+        QObject::tr("%1 copies of %2:")
+            .arg(group.size())
+            .arg(locale.formattedDataSize(
+                static_cast<qint64>(assets[group.first()].size)))));
+
+    for (qsizetype j = 0; j < qMin<qsizetype>(group.size(),
+                                               MAX_LISTED_MEMBERS);
+         j++) {
+      promise.addResult(line("  " + displayName(assets[group[j]])));
+    }
+
+    if (group.size() > MAX_LISTED_MEMBERS) {
+      promise.addResult(line(QObject::tr("  ... and %1 more")
+                                 .arg(group.size() - MAX_LISTED_MEMBERS)));
+    }
+  }
+
+  if (duplicates.size() > MAX_LISTED_GROUPS) {
+    promise.addResult(line(QObject::tr("... and %1 more groups")
+                               .arg(duplicates.size() - MAX_LISTED_GROUPS)));
+  }
+
+  if (!mapPk3Info.isFile()) {
+    promise.addResult(line(QObject::tr("%1 not found, pack the map to check "
+                                       "its assets against no-pack pk3s")
+                               .arg(mapPk3)));
+  } else {
+    // index of an asset in a no-pack pk3 identical to each map asset,
+    // or -1 if there is none
+    const auto shipped = QtConcurrent::blockingMapped<QList<qsizetype>>(
+        mapAssets, [&](const Asset &mapAsset) -> qsizetype {
+          const auto group = groups.constFind({mapAsset.size, mapAsset.crc32});
+
+          if (group == groups.cend()) {
+            return -1;
+          }
+
+          QByteArray mapContents{};
+          QByteArray contents{};
+
+          for (const auto i : *group) {
+            if (!noPackNames.contains(assets[i].container,
+                                      Qt::CaseInsensitive)) {
+              continue;
+            }
+
+            if (mapContents.isEmpty() &&
+                !readContents(mapAsset, archives, mapContents)) {
+              return -1;
+            }
+
+            if (readContents(assets[i], archives, contents) &&
+                contents == mapContents) {
+              return i;
+            }
+          }
+
+          return -1;
+        });
+
+    qsizetype mapDuplicates = 0;
+
+    for (qsizetype i = 0; i < mapAssets.size(); i++) {
+      if (shipped[i] >= 0) {
+        promise.addResult(line(QObject::tr("%1 is already shipped as %2")
+                                   .arg(mapAssets[i].name,
+                                        displayName(assets[shipped[i]]))));
+        mapDuplicates++;
+      }
+    }
+
+    promise.addResult(
+        line(QObject::tr("%1 of %2 assets in %3 are already in no-pack pk3s")
+                 .arg(mapDuplicates)
+                 .arg(mapAssets.size())
+                 .arg(mapPk3Info.fileName())));
+  }
+
+  promise.addResult(line(QObject::tr("Finished in %1 s")
+                             .arg(timer.elapsed() / 1000.0, 0, 'f', 2)));
+}
+
+QList<DuplicateAssetFinder::Asset>
+DuplicateAssetFinder::collectLooseFiles(const QString &root,
+                                        QStringList &pk3Files) {
+  QStringList subdirectories{};
+
+  // loose files directly in etmain are configs and logs, not assets
+  for (const auto &info : QDir(root).entryInfoList(
+           QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot)) {
+    if (info.isDir()) {
+      subdirectories.append(info.fileName());
+    } else if (info.suffix().compare("pk3", Qt::CaseInsensitive) == 0) {
+      pk3Files.append(info.absoluteFilePath());
+    }
+  }
+
+  // walk each subdirectory on its own thread, same as with map files
+  return QtConcurrent::blockingMappedReduced<QList<Asset>>(
+      subdirectories,
+      [&root](const QString &subdirectory) {
+        const bool isPk3Dir =
+            subdirectory.endsWith(".pk3dir", Qt::CaseInsensitive);
+        const QDir base(root + "/" + subdirectory);
+        QList<Asset> found{};
+        QDirIterator it(base.path(), QDir::Files,
+                        QDirIterator::Subdirectories);
+
+        while (it.hasNext()) {
+          it.next();
+          const QFileInfo info = it.fileInfo();
+
+          if (info.size() == 0 ||
+              ignoredSuffixes.contains(info.suffix(), Qt::CaseInsensitive)) {
+            continue;
+          }
+
+          // files in a pk3dir are in the same place as they'd be in a pk3
+          Asset asset{};
+          asset.container = isPk3Dir ? subdirectory : QString();
+          asset.name = base.relativeFilePath(info.absoluteFilePath());
+
+          if (!isPk3Dir) {
+            asset.name.prepend(subdirectory + "/");
+          }
+
+          asset.filePath = info.absoluteFilePath();
+          asset.size = static_cast<quint64>(info.size());
+          asset.modified = info.lastModified().toMSecsSinceEpoch();
+          found.append(asset);
+        }
+
+        return found;
+      },
+      [](QList<Asset> &result, const QList<Asset> &found) {
+        result += found;
+      });
+}
+
+QList<DuplicateAssetFinder::Asset>
+DuplicateAssetFinder::readPk3(const QString &path) {
+  Pk3Archive archive(path);
+
+  if (!archive.open()) {
+    return {};
+  }
+
+  const QString container = QFileInfo(path).fileName();
+  const auto &entries = archive.entries();
+  QList<Asset> assets{};
+
+  for (qsizetype i = 0; i < entries.size(); i++) {
+    const auto &entry = entries[i];
+
+    if (entry.isDirectory() || entry.uncompressedSize == 0) {
+      continue;
+    }
+
+    Asset asset{};
+    asset.container = container;
+    asset.name = entry.name;
+    asset.filePath = path;
+    asset.entry = i;
+    asset.size = entry.uncompressedSize;
+    asset.crc32 = entry.crc32;
+    assets.append(asset);
+  }
+
+  return assets;
+}
+
+// contents of a loose file or a pk3 entry
+bool DuplicateAssetFinder::readContents(const Asset &asset,
+                                        const Archives &archives,
+                                        QByteArray &out) {
+  if (asset.entry < 0) {
+    QFile file(asset.filePath);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+      return false;
+    }
+
+    out = file.readAll();
+    return static_cast<quint64>(out.size()) == asset.size;
+  }
+
+  const auto archive = archives.value(asset.filePath);
+  return archive && archive->extract(archive->entries()[asset.entry], out);
+}
+
+// splits assets with the same size and CRC32 into groups of identical ones,
+// assets which can't be read aren't part of any
+QList<QList<qsizetype>>
+DuplicateAssetFinder::confirmGroup(const QList<qsizetype> &group,
+                                   const QList<Asset> &assets,
+                                   const Archives &archives) {
+  QList<QList<qsizetype>> identical{};
+  QList<qsizetype> remaining = group;
+  QByteArray reference{};
+  QByteArray contents{};
+
+  // nearly all candidates are identical, so this is usually a single pass
+  while (remaining.size() > 1) {
+    if (!readContents(assets[remaining.first()], archives, reference)) {
+      remaining.removeFirst();
+      continue;
+    }
+
+    QList<qsizetype> same = {remaining.first()};
+    QList<qsizetype> different{};
+
+    for (qsizetype i = 1; i < remaining.size(); i++) {
+      if (readContents(assets[remaining[i]], archives, contents)) {
+        (contents == reference ? same : different).append(remaining[i]);
+      }
+    }
+
+    if (same.size() > 1) {
+      identical.append(same);
+    }
+
+    remaining = different;
+  }
+
+  return identical;
+}
+
+QHash<QString, DuplicateAssetFinder::CachedChecksum>
+DuplicateAssetFinder::loadCache() {
+  QFile file(FileSystem::getCacheFilePath(cacheFilename));
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    return {};
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+
+  quint32 magic{};
+  quint32 version{};
+  quint32 count{};
+  stream >> magic >> version >> count;
+
+  if (magic != CACHE_MAGIC || version != CACHE_VERSION) {
+    return {};
+  }
+
+  QHash<QString, CachedChecksum> cache{};
+  cache.reserve(count);
+
+  for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+    QString path;
+    CachedChecksum checksum{};
+    stream >> path >> checksum.size >> checksum.modified >> checksum.crc32;
+    cache.insert(path, checksum);
+  }
+
+  return stream.status() == QDataStream::Ok ? cache
+                                            : QHash<QString, CachedChecksum>{};
+}
+
+void DuplicateAssetFinder::saveCache(
+    const QHash<QString, CachedChecksum> &cache) {
+  QSaveFile file(FileSystem::getCacheFilePath(cacheFilename));
+
+  if (!file.open(QIODevice::WriteOnly)) {
+    return;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+  stream << CACHE_MAGIC << CACHE_VERSION << static_cast<quint32>(cache.size());
+
+  for (auto it = cache.cbegin(); it != cache.cend(); ++it) {
+    stream << it.key() << it->size << it->modified << it->crc32;
+  }
+
+  file.commit();
+}
@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QObject>
+#include <QPromise>
+#include <memory>
+
+class Pk3Archive;
+
+// Finds byte-identical assets in the mapping install, both loose files and
+// files inside pk3s, and reports which assets of the current map are
+// duplicates of something already shipped in a no-pack pk3.
+//
+// Candidates are found by size and CRC32. Entries in pk3s already have their
+// CRC32 in the central directory, so only loose files need to be read, and
+// only if some other asset has the same size. Loose file checksums are
+// cached by path, size and modification time between runs. As different
+// files can share both, candidates are compared byte by byte before they're
+// reported.
+class DuplicateAssetFinder : public QObject {
+  Q_OBJECT
+
+public:
+  explicit DuplicateAssetFinder(QObject *parent);
+
+  // 'noPackNames' are the pk3 and pk3dir names passed to -np
+  void run(const QString &mapsPath, const QString &mapPk3,
+           const QStringList &noPackNames);
+  bool isRunning() const;
+
+signals:
+  void outputLine(const QByteArray &line);
+  void finished();
+
+private:
+  struct Asset {
+    QString container;   // pk3 or pk3dir name, empty if loose in etmain
+    QString name;        // path inside the container
+    QString filePath;    // absolute path of the file, or of the pk3 it's in
+    qsizetype entry{-1}; // index of the pk3 entry, -1 for loose files
+    quint64 size{};
+    quint32 crc32{};
+    qint64 modified{};
+  };
+
+  // pk3s are opened once for every comparison, by path
+  using Archives = QHash<QString, std::shared_ptr<Pk3Archive>>;
+
+  struct CachedChecksum {
+    quint64 size{};
+    qint64 modified{};
+    quint32 crc32{};
+  };
+
+  static void find(QPromise<QByteArray> &promise, const QString &mapsPath,
+                   const QString &mapPk3, const QStringList &noPackNames);
+
+  static QList<Asset> collectLooseFiles(const QString &root,
+                                        QStringList &pk3Files);
+  static QList<Asset> readPk3(const QString &path);
+
+  static bool readContents(const Asset &asset, const Archives &archives,
+                           QByteArray &out);
+  static QList<QList<qsizetype>> confirmGroup(const QList<qsizetype> &group,
+                                              const QList<Asset> &assets,
+                                              const Archives &archives);
+
+  static QHash<QString, CachedChecksum> loadCache();
+  static void saveCache(const QHash<QString, CachedChecksum> &cache);
+
+  QFutureWatcher<QByteArray> *watcher;
+};
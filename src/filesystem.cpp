@@ -25,6 +25,11 @@
 #include "filesystem.h"
 #include "preferences.h"
 
+#include <QApplication>
+#include <QDirIterator>
+#include <QStandardPaths>
+#include <QtConcurrent>
+
 // TODO: support PATH env variable for discovering Pack3r executable?
 QString FileSystem::getPack3rPath(const QString &defaultPath) {
   QFileDialog fileDialog{};
@@ -110,3 +115,73 @@ QString FileSystem::getOutputPath(const QString &defaultPath) {
 QString FileSystem::getDefaultPath(const QString &defaultPath) {
   return defaultPath.isEmpty() ? QDir::homePath() : defaultPath;
 }
+
+QString FileSystem::getCacheFilePath(const QString &fileName) {
+  QString cacheDir =
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+
+  // same fallback as the preferences file
+  if (cacheDir.isEmpty()) {
+    cacheDir = QDir::homePath() + NATIVE_PATHSEP +
+               QApplication::applicationName() + NATIVE_PATHSEP + "cache";
+  }
+
+  QDir().mkpath(cacheDir);
+  return QDir::toNativeSeparators(cacheDir) + NATIVE_PATHSEP + fileName;
+}
+
+QString FileSystem::getDataFilePath(const QString &fileName) {
+  QString dataDir =
+      QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+
+  if (dataDir.isEmpty()) {
+    dataDir = QDir::homePath() + NATIVE_PATHSEP +
+              QApplication::applicationName() + NATIVE_PATHSEP + "data";
+  }
+
+  const QString path = QDir::toNativeSeparators(dataDir + "/" + fileName);
+  QDir().mkpath(QFileInfo(path).absolutePath());
+  return path;
+}
+
+QStringList FileSystem::findMapFiles(const QStringList &directories) {
+  // case-insensitive, as QDir::CaseSensitive is not set in the filters
+  const QStringList nameFilters = {"*.map", "*.reg"};
+  QStringList subdirectories{};
+  QStringList files{};
+
+  // split the walk by the immediate subdirectories of each directory,
+  // so each subtree can be walked on its own thread
+  for (const auto &directory : directories) {
+    const QDir dir(directory);
+
+    for (const auto &file : dir.entryInfoList(nameFilters, QDir::Files)) {
+      files.append(QDir::toNativeSeparators(file.absoluteFilePath()));
+    }
+
+    for (const auto &subdir :
+         dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+      subdirectories.append(subdir.absoluteFilePath());
+    }
+  }
+
+  const auto results = QtConcurrent::blockingMapped<QList<QStringList>>(
+      subdirectories, [&nameFilters](const QString &subdirectory) {
+        QStringList found{};
+        QDirIterator it(subdirectory, nameFilters, QDir::Files,
+                        QDirIterator::Subdirectories);
+
+        while (it.hasNext()) {
+          found.append(QDir::toNativeSeparators(it.next()));
+        }
+
+        return found;
+      });
+
+  for (const auto &result : results) {
+    files.append(result);
+  }
+
+  files.sort(Qt::CaseInsensitive);
+  return files;
+}
@@ -52,4 +52,14 @@ class FileSystem : public QObject {
   static QString getOutputPath(const QString &defaultPath);
 
   static QString getDefaultPath(const QString &defaultPath);
+
+  // path to a file in the cache directory, which is created if needed
+  static QString getCacheFilePath(const QString &fileName);
+  // path to a file in the application data directory, 'fileName' can
+  // include subdirectories, which are created if needed
+  static QString getDataFilePath(const QString &fileName);
+
+  // recursively collects all .map and .reg files in the given directories,
+  // blocks until done so it should be called from a worker thread
+  static QStringList findMapFiles(const QStringList &directories);
 };
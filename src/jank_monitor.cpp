@@ -0,0 +1,186 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "jank_monitor.h"
+
+#include <algorithm>
+
+namespace {
+// 4 ms is well under a frame at 60 fps, while still being cheap
+constexpr int HEARTBEAT_INTERVAL_MS = 4;
+constexpr qint64 HEARTBEAT_INTERVAL_NS = HEARTBEAT_INTERVAL_MS * 1000000LL;
+
+// roughly three dropped frames
+constexpr qint64 STALL_THRESHOLD_NS = 50 * 1000000LL;
+constexpr int MAX_RECORDED_STALLS = 10;
+} // namespace
+
+void JankMonitor::Histogram::add(const qint64 nsecs) {
+  const qint64 ms = nsecs / 1000000;
+  buckets[static_cast<size_t>(qBound<qint64>(0, ms, 1000))]++;
+  samples++;
+  maxNsecs = qMax(maxNsecs, nsecs);
+}
+
+void JankMonitor::Histogram::clear() {
+  buckets.fill(0);
+  samples = 0;
+  maxNsecs = 0;
+}
+
+quint64 JankMonitor::Histogram::count() const { return samples; }
+
+double JankMonitor::Histogram::percentile(const double p) const {
+  if (samples == 0) {
+    return 0;
+  }
+
+  const auto target = static_cast<quint64>(p / 100.0 * (samples - 1)) + 1;
+  quint64 seen = 0;
+
+  for (size_t i = 0; i < buckets.size(); i++) {
+    seen += buckets[i];
+
+    if (seen >= target) {
+      return static_cast<double>(i);
+    }
+  }
+
+  return max();
+}
+
+double JankMonitor::Histogram::max() const { return maxNsecs / 1000000.0; }
+
+JankMonitor::SlotTimer::SlotTimer(JankMonitor *monitor, const char *name)
+    : monitor(monitor), name(name) {
+  timer.start();
+}
+
+JankMonitor::SlotTimer::~SlotTimer() {
+  if (monitor->isRunning()) {
+    monitor->recordSlot(name, timer.nsecsElapsed());
+  }
+}
+
+JankMonitor::JankMonitor(QObject *parent)
+    : QObject(parent), heartbeatTimer(new QTimer(this)) {
+  heartbeatTimer->setTimerType(Qt::PreciseTimer);
+  heartbeatTimer->setInterval(HEARTBEAT_INTERVAL_MS);
+
+  connect(heartbeatTimer, &QTimer::timeout, this, &JankMonitor::heartbeat);
+}
+
+void JankMonitor::start() {
+  currentReport.eventLoop.clear();
+  currentReport.outputSlots.clear();
+  currentReport.longestStalls.clear();
+  currentReport.durationMs = 0;
+
+  longestSlot = nullptr;
+  longestSlotNsecs = 0;
+
+  runTimer.start();
+  lastBeat = 0;
+  heartbeatTimer->start();
+}
+
+void JankMonitor::stop() {
+  if (isRunning()) {
+    heartbeatTimer->stop();
+    currentReport.durationMs = runTimer.elapsed();
+  }
+}
+
+bool JankMonitor::isRunning() const { return heartbeatTimer->isActive(); }
+
+const JankMonitor::Report &JankMonitor::report() const {
+  return currentReport;
+}
+
+QStringList JankMonitor::formatReport(const Report &report,
+                                      const bool includeStalls) {
+  const auto formatHistogram = [](const Histogram &histogram) {
+    return tr("p50 %1 ms, p99 %2 ms, max %3 ms (%4 samples)")
+        .arg(histogram.percentile(50), 0, 'f', 0)
+        .arg(histogram.percentile(99), 0, 'f', 0)
+        .arg(histogram.max(), 0, 'f', 1)
+        .arg(histogram.count());
+  };
+
+  QStringList lines{};
+  lines.append(
+      tr("Event loop latency: %1").arg(formatHistogram(report.eventLoop)));
+  lines.append(
+      tr("Output handling: %1").arg(formatHistogram(report.outputSlots)));
+
+  if (includeStalls) {
+    for (const auto &stall : report.longestStalls) {
+      lines.append(tr("Stall of %1 ms at %2 s%3")
+                       .arg(stall.durationMs, 0, 'f', 1)
+                       .arg(stall.startMs / 1000.0, 0, 'f', 2)
+                       .arg(stall.slot ? tr(", in %1").arg(stall.slot)
+                                       : QString()));
+    }
+  }
+
+  return lines;
+}
+
+void JankMonitor::heartbeat() {
+  const qint64 now = runTimer.nsecsElapsed();
+  const qint64 latency =
+      qMax<qint64>(0, now - lastBeat - HEARTBEAT_INTERVAL_NS);
+  lastBeat = now;
+
+  currentReport.eventLoop.add(latency);
+
+  if (latency >= STALL_THRESHOLD_NS) {
+    auto &stalls = currentReport.longestStalls;
+    const Stall stall{(now - latency) / 1000000, latency / 1000000.0,
+                      longestSlot};
+
+    // kept sorted, longest first
+    const auto pos = std::upper_bound(
+        stalls.begin(), stalls.end(), stall, [](const auto &a, const auto &b) {
+          return a.durationMs > b.durationMs;
+        });
+    stalls.insert(pos, stall);
+
+    if (stalls.size() > MAX_RECORDED_STALLS) {
+      stalls.removeLast();
+    }
+  }
+
+  longestSlot = nullptr;
+  longestSlotNsecs = 0;
+}
+
+void JankMonitor::recordSlot(const char *name, const qint64 nsecs) {
+  currentReport.outputSlots.add(nsecs);
+
+  if (nsecs > longestSlotNsecs) {
+    longestSlot = name;
+    longestSlotNsecs = nsecs;
+  }
+}
@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <array>
+
+/* Measures how responsive the GUI thread is during a run.
+ *
+ * A high-frequency heartbeat timer measures how late each of its timeouts
+ * is delivered, which is how long the event loop was unable to process
+ * events such as input and painting. Output slots are timed separately with
+ * SlotTimer, so stalls can be attributed to output handling.
+ *
+ * Stalls are only recorded with the name of the slot that ran longest
+ * during them, not with stack traces.
+ */
+class JankMonitor : public QObject {
+  Q_OBJECT
+
+public:
+  // latencies in 1 ms buckets, anything over a second goes to the last one
+  class Histogram {
+  public:
+    void add(qint64 nsecs);
+    void clear();
+
+    quint64 count() const;
+    double percentile(double p) const; // in milliseconds
+    double max() const;                // in milliseconds
+
+  private:
+    std::array<quint32, 1001> buckets{};
+    quint64 samples{};
+    qint64 maxNsecs{};
+  };
+
+  struct Stall {
+    qint64 startMs{}; // since the start of the run
+    double durationMs{};
+    const char *slot{}; // longest slot during the stall, if any
+  };
+
+  struct Report {
+    Histogram eventLoop;
+    Histogram outputSlots;
+    QList<Stall> longestStalls; // longest first
+    qint64 durationMs{};
+  };
+
+  // RAII timer for slots handling output, e.g.
+  //   const JankMonitor::SlotTimer timer(jankMonitor, "appendOutputBatch");
+  class SlotTimer {
+  public:
+    SlotTimer(JankMonitor *monitor, const char *name);
+    ~SlotTimer();
+
+    SlotTimer(const SlotTimer &) = delete;
+    SlotTimer &operator=(const SlotTimer &) = delete;
+
+  private:
+    JankMonitor *monitor;
+    const char *name;
+    QElapsedTimer timer;
+  };
+
+  explicit JankMonitor(QObject *parent);
+
+  void start();
+  void stop();
+  bool isRunning() const;
+
+  // report of the current run, or the last one if none is running
+  const Report &report() const;
+  static QStringList formatReport(const Report &report, bool includeStalls);
+
+private:
+  void heartbeat();
+  void recordSlot(const char *name, qint64 nsecs);
+
+  QTimer *heartbeatTimer;
+  QElapsedTimer runTimer;
+  qint64 lastBeat{};
+
+  // longest slot since the last heartbeat
+  const char *longestSlot{};
+  qint64 longestSlotNsecs{};
+
+  Report currentReport;
+};
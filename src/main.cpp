@@ -22,6 +22,7 @@
  * SOFTWARE.
  */
 
+#include "cli.h"
 #include "mainwindow.h"
 #include "preferences.h"
 
@@ -32,6 +33,12 @@
 #endif
 
 int main(int argc, char *argv[]) {
+  // headless modes (pack daemon and its command line client) don't create
+  // the user interface at all, so handle them before QApplication is created
+  if (Cli::isCliInvocation(argc, argv)) {
+    return Cli::run(argc, argv);
+  }
+
   // Set 'Fusion' as the default style on Windows, as Qts default 'windowsvista'
   // style does not include dark variant, and therefore ignores the users
   // preference for light/dark mode in applications.
@@ -93,6 +93,7 @@ void MainWindow::setupGeometry() {
 void MainWindow::setupMenuBar() {
   setupFileMenu();
   setupEditMenu();
+  setupToolsMenu();
   setupHelpMenu();
 }
 
@@ -107,6 +108,12 @@ void MainWindow::setupFileMenu() {
   connect(openAction, &QAction::triggered, qtPack3rwidget,
           &QtPack3rWidget::openMap);
 
+  quickOpenAction = new QAction(tr("&Quick open map..."), this);
+  quickOpenAction->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_P));
+  fileMenu->addAction(quickOpenAction);
+  connect(quickOpenAction, &QAction::triggered, qtPack3rwidget,
+          &QtPack3rWidget::openMapPicker);
+
   fileMenu->addSeparator();
 
   quitAction = new QAction(tr("&Quit"), this);
@@ -128,6 +135,56 @@ void MainWindow::setupEditMenu() {
           &MainWindow::openPreferences);
 }
 
+void MainWindow::setupToolsMenu() {
+  toolsMenu = menuBar()->addMenu(tr("&Tools"));
+
+  findDuplicatesAction = new QAction(tr("Find &duplicate assets"), this);
+  toolsMenu->addAction(findDuplicatesAction);
+  connect(findDuplicatesAction, &QAction::triggered, qtPack3rwidget,
+          &QtPack3rWidget::findDuplicateAssets);
+
+  checkShadersAction = new QAction(tr("Check map &shaders"), this);
+  toolsMenu->addAction(checkShadersAction);
+  connect(checkShadersAction, &QAction::triggered, qtPack3rwidget,
+          &QtPack3rWidget::checkMapShaders);
+
+  mapAssetsAction = new QAction(tr("Show map &assets"), this);
+  toolsMenu->addAction(mapAssetsAction);
+  connect(mapAssetsAction, &QAction::triggered, qtPack3rwidget,
+          &QtPack3rWidget::showMapAssets);
+
+  runDiagnosticsAction = new QAction(tr("&Run diagnostics"), this);
+  toolsMenu->addAction(runDiagnosticsAction);
+  connect(runDiagnosticsAction, &QAction::triggered, qtPack3rwidget,
+          &QtPack3rWidget::showRunDiagnostics);
+
+  runHistoryAction = new QAction(tr("Run &history"), this);
+  toolsMenu->addAction(runHistoryAction);
+  connect(runHistoryAction, &QAction::triggered, qtPack3rwidget,
+          &QtPack3rWidget::showRunHistory);
+
+  referenceExplorerAction = new QAction(tr("Explore &references"), this);
+  toolsMenu->addAction(referenceExplorerAction);
+  connect(referenceExplorerAction, &QAction::triggered, qtPack3rwidget,
+          &QtPack3rWidget::showReferenceExplorer);
+
+  compareOutputAction =
+      new QAction(tr("&Compare output with previous build"), this);
+  toolsMenu->addAction(compareOutputAction);
+  connect(compareOutputAction, &QAction::triggered, qtPack3rwidget,
+          &QtPack3rWidget::compareOutput);
+
+  exportNinjaAction = new QAction(tr("Export &Ninja build file..."), this);
+  toolsMenu->addAction(exportNinjaAction);
+  connect(exportNinjaAction, &QAction::triggered, qtPack3rwidget,
+          &QtPack3rWidget::exportNinjaBuild);
+
+  benchmarkRuntimeAction = new QAction(tr("&Benchmark runtime profiles"), this);
+  toolsMenu->addAction(benchmarkRuntimeAction);
+  connect(benchmarkRuntimeAction, &QAction::triggered, qtPack3rwidget,
+          &QtPack3rWidget::benchmarkRuntimeProfiles);
+}
+
 void MainWindow::setupHelpMenu() {
   helpMenu = menuBar()->addMenu(tr("&Help"));
 
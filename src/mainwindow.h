@@ -59,6 +59,7 @@ class MainWindow : public QMainWindow {
 
   void setupFileMenu();
   void setupEditMenu();
+  void setupToolsMenu();
   void setupHelpMenu();
 
   void buildAboutDialog();
@@ -74,13 +75,25 @@ class MainWindow : public QMainWindow {
 
   QMenu *fileMenu{};
   QMenu *editMenu{};
+  QMenu *toolsMenu{};
   QMenu *helpMenu{};
 
   QAction *openAction{};
+  QAction *quickOpenAction{};
   QAction *quitAction{};
 
   QAction *preferencesAction{};
 
+  QAction *findDuplicatesAction{};
+  QAction *checkShadersAction{};
+  QAction *mapAssetsAction{};
+  QAction *runDiagnosticsAction{};
+  QAction *runHistoryAction{};
+  QAction *referenceExplorerAction{};
+  QAction *compareOutputAction{};
+  QAction *exportNinjaAction{};
+  QAction *benchmarkRuntimeAction{};
+
   QAction *aboutAction{};
   QAction *bugReportAction{};
   QAction *linkToPack3rAction{};
@@ -0,0 +1,354 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "map_index.h"
+#include "filesystem.h"
+#include "preferences.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+constexpr quint32 MAP_INDEX_MAGIC = 0x51504d49; // "QPMI"
+constexpr quint32 MAP_INDEX_VERSION = 1;
+const QString mapIndexFilename = "map_index.dat";
+
+constexpr int SCORE_MATCH = 16;
+constexpr int SCORE_BOUNDARY = 8;
+constexpr int SCORE_CONSECUTIVE = 8;
+constexpr int SCORE_FILENAME = 32;
+
+bool isBoundary(const QString &str, const qsizetype pos) {
+  if (pos == 0) {
+    return true;
+  }
+
+  const QChar prev = str[pos - 1];
+  return prev == '/' || prev == '_' || prev == '-' || prev == '.' ||
+         prev == ' ';
+}
+
+// finds the shortest window starting at or after 'from' which contains
+// the needle as a subsequence, returns the window start or -1
+qsizetype findWindow(const QString &haystack, const QString &needle,
+                     const qsizetype from) {
+  qsizetype pos = from;
+
+  for (const QChar c : needle) {
+    pos = haystack.indexOf(c, pos);
+
+    if (pos == -1) {
+      return -1;
+    }
+
+    pos++;
+  }
+
+  // walk back from the end of the match to find the latest possible start,
+  // so 'abc' in 'a_xxx_abc' matches the tight 'abc' instead of the spread out
+  qsizetype start = pos - 1;
+
+  for (qsizetype i = needle.size() - 1; i >= 0; i--) {
+    start = haystack.lastIndexOf(needle[i], start);
+
+    if (i > 0) {
+      start--;
+    }
+  }
+
+  return start;
+}
+} // namespace
+
+MapIndex::MapIndex(QObject *parent)
+    : QObject(parent), scanWatcher(new QFutureWatcher<Snapshot>(this)) {
+  connect(scanWatcher, &QFutureWatcher<Snapshot>::finished, this, [this] {
+    setSnapshot(scanWatcher->result());
+    save();
+
+    if (refreshPending) {
+      refreshPending = false;
+      refresh();
+    }
+  });
+}
+
+void MapIndex::load() {
+  QFile file(FileSystem::getCacheFilePath(mapIndexFilename));
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+
+  quint32 magic{};
+  quint32 version{};
+  stream >> magic >> version;
+
+  // the index is just a cache, discard anything we don't understand
+  if (magic != MAP_INDEX_MAGIC || version != MAP_INDEX_VERSION) {
+    return;
+  }
+
+  Snapshot loaded{};
+  quint32 count{};
+  stream >> loaded.root >> count;
+
+  for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+    QString path;
+    Directory dir{};
+    stream >> path >> dir.modified >> dir.subdirectories >> dir.files;
+    loaded.directories.insert(path, dir);
+  }
+
+  if (stream.status() == QDataStream::Ok) {
+    setSnapshot(loaded);
+  }
+}
+
+void MapIndex::save() const {
+  QSaveFile file(FileSystem::getCacheFilePath(mapIndexFilename));
+
+  if (!file.open(QIODevice::WriteOnly)) {
+    return;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+  stream << MAP_INDEX_MAGIC << MAP_INDEX_VERSION << snapshot.root
+         << static_cast<quint32>(snapshot.directories.size());
+
+  for (auto it = snapshot.directories.cbegin();
+       it != snapshot.directories.cend(); ++it) {
+    stream << it.key() << it->modified << it->subdirectories << it->files;
+  }
+
+  file.commit();
+}
+
+void MapIndex::refresh() {
+  if (scanWatcher->isRunning()) {
+    refreshPending = true;
+    return;
+  }
+
+  const QString mapsPath =
+      preferences.readSetting(Preferences::Settings::MAPS_PATH).toString();
+
+  if (mapsPath.isEmpty()) {
+    setSnapshot({});
+    return;
+  }
+
+  const QString root = QDir::cleanPath(QDir::fromNativeSeparators(mapsPath));
+  scanWatcher->setFuture(QtConcurrent::run(
+      [root, previous = snapshot] { return scan(root, previous); }));
+}
+
+bool MapIndex::isRefreshing() const { return scanWatcher->isRunning(); }
+
+qsizetype MapIndex::size() const { return entries.size(); }
+
+QString MapIndex::root() const {
+  return QDir::toNativeSeparators(snapshot.root);
+}
+
+const QString &MapIndex::path(const qsizetype index) const {
+  return entries[index].path;
+}
+
+const QString &MapIndex::displayName(const qsizetype index) const {
+  return entries[index].displayName;
+}
+
+MapIndex::Snapshot MapIndex::scan(const QString &root,
+                                  const Snapshot &previous) {
+  Snapshot result{};
+  result.root = root;
+
+  // valid map files are only ever inside 'maps' of the mapping install,
+  // or 'maps' of a pk3dir, so skip walking everything else in etmain
+  const QDir rootDir(root);
+  QStringList pending = {root + "/maps"};
+
+  for (const auto &pk3dir : rootDir.entryList(
+           {"*.pk3dir"}, QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name)) {
+    pending.append(root + "/" + pk3dir + "/maps");
+  }
+
+  const bool sameRoot = previous.root == root;
+
+  while (!pending.isEmpty()) {
+    const QString path = pending.takeLast();
+    const QFileInfo info(path);
+
+    if (!info.isDir()) {
+      continue;
+    }
+
+    // adding, removing or renaming an entry updates the modification time
+    // of the directory it's in, so an unchanged directory has the same
+    // files and subdirectories as the last time it was listed
+    const qint64 modified = info.lastModified().toMSecsSinceEpoch();
+    const auto cached = previous.directories.constFind(path);
+    Directory dir{};
+
+    if (sameRoot && cached != previous.directories.cend() &&
+        cached->modified == modified) {
+      dir = *cached;
+    } else {
+      const QDir qdir(path);
+      dir.modified = modified;
+      dir.subdirectories = qdir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+      dir.files = qdir.entryList({"*.map", "*.reg"}, QDir::Files);
+    }
+
+    for (const auto &subdirectory : dir.subdirectories) {
+      pending.append(path + "/" + subdirectory);
+    }
+
+    result.directories.insert(path, dir);
+  }
+
+  return result;
+}
+
+void MapIndex::setSnapshot(const Snapshot &newSnapshot) {
+  snapshot = newSnapshot;
+  entries.clear();
+
+  const qsizetype rootLength = snapshot.root.size() + 1;
+
+  for (auto it = snapshot.directories.cbegin();
+       it != snapshot.directories.cend(); ++it) {
+    for (const auto &file : it->files) {
+      Entry entry{};
+      const QString path = it.key() + "/" + file;
+
+      entry.path = QDir::toNativeSeparators(path);
+      entry.displayName = path.mid(rootLength);
+      entry.haystack = entry.displayName.toLower();
+      entry.nameOffset = entry.haystack.lastIndexOf('/') + 1;
+      entries.append(entry);
+    }
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) {
+              return a.haystack < b.haystack;
+            });
+
+  emit indexUpdated();
+}
+
+int MapIndex::score(const Entry &entry, const QString &needle) {
+  const QString &haystack = entry.haystack;
+
+  // prefer matching the file name, fall back to the whole relative path
+  qsizetype start = findWindow(haystack, needle, entry.nameOffset);
+  int total = 0;
+
+  if (start != -1) {
+    total += SCORE_FILENAME;
+  } else {
+    start = findWindow(haystack, needle, 0);
+
+    if (start == -1) {
+      return -1;
+    }
+  }
+
+  qsizetype pos = start;
+  qsizetype prev = -2;
+
+  for (const QChar c : needle) {
+    pos = haystack.indexOf(c, pos);
+    total += SCORE_MATCH;
+
+    if (isBoundary(haystack, pos)) {
+      total += SCORE_BOUNDARY;
+    }
+
+    if (pos == prev + 1) {
+      total += SCORE_CONSECUTIVE;
+    }
+
+    prev = pos++;
+  }
+
+  // penalize gaps inside the match, and slightly prefer shorter paths
+  total -= static_cast<int>(prev - start + 1 - needle.size());
+  total -= static_cast<int>(haystack.size() / 16);
+  return total;
+}
+
+QList<qsizetype> MapIndex::match(const QString &query, const int limit) const {
+  const QStringList needles =
+      query.toLower().split(' ', Qt::SkipEmptyParts);
+  QList<QPair<int, qsizetype>> scored{};
+
+  for (qsizetype i = 0; i < entries.size(); i++) {
+    int total = 0;
+
+    // every space-separated part of the query has to match
+    for (const auto &needle : needles) {
+      const int s = score(entries[i], needle);
+
+      if (s < 0) {
+        total = -1;
+        break;
+      }
+
+      total += s;
+    }
+
+    if (total >= 0) {
+      scored.append({total, i});
+    }
+  }
+
+  const auto count = std::min<qsizetype>(limit, scored.size());
+
+  // entries are sorted by name, so ties keep alphabetical order
+  std::partial_sort(scored.begin(), scored.begin() + count, scored.end(),
+                    [](const auto &a, const auto &b) {
+                      return a.first != b.first ? a.first > b.first
+                                                : a.second < b.second;
+                    });
+
+  QList<qsizetype> result{};
+  result.reserve(count);
+
+  for (qsizetype i = 0; i < count; i++) {
+    result.append(scored[i].second);
+  }
+
+  return result;
+}
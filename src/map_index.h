@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QObject>
+
+// Index of every .map and .reg file under the maps path, used by the map
+// picker. The index is built on a worker thread and saved to the cache
+// directory, so it's available right away on the next launch. A refresh
+// only lists directories whose modification time has changed since the
+// previous scan, the contents of every other directory are reused.
+class MapIndex : public QObject {
+  Q_OBJECT
+
+public:
+  explicit MapIndex(QObject *parent);
+
+  void load();
+  void refresh();
+  bool isRefreshing() const;
+
+  qsizetype size() const;
+  QString root() const;
+
+  // absolute path and the path relative to the maps path of an entry
+  const QString &path(qsizetype index) const;
+  const QString &displayName(qsizetype index) const;
+
+  // indices of the best matches for a fuzzy query, best match first
+  QList<qsizetype> match(const QString &query, int limit) const;
+
+signals:
+  void indexUpdated();
+
+private:
+  struct Directory {
+    qint64 modified{};
+    QStringList subdirectories;
+    QStringList files;
+  };
+
+  struct Snapshot {
+    QString root;
+    QHash<QString, Directory> directories;
+  };
+
+  struct Entry {
+    QString path;
+    QString displayName;
+
+    // lowercase display name, and offset of the file name in it
+    QString haystack;
+    qsizetype nameOffset{};
+  };
+
+  static Snapshot scan(const QString &root, const Snapshot &previous);
+  static int score(const Entry &entry, const QString &needle);
+
+  void setSnapshot(const Snapshot &newSnapshot);
+  void save() const;
+
+  Snapshot snapshot;
+  QList<Entry> entries;
+
+  QFutureWatcher<Snapshot> *scanWatcher;
+  bool refreshPending{};
+};
@@ -0,0 +1,127 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "map_picker_dialog.h"
+
+#include <QApplication>
+#include <QKeyEvent>
+
+MapPickerDialog::MapPickerDialog(QWidget *parent, MapIndex *mapIndex)
+    : QDialog(parent), index(mapIndex) {
+  setWindowTitle(tr("Open map"));
+  setAttribute(Qt::WA_DeleteOnClose);
+  resize(600, 400);
+
+  layout = new QVBoxLayout(this);
+
+  queryField = new QLineEdit(this);
+  queryField->setPlaceholderText(tr("Type to search maps..."));
+  queryField->setClearButtonEnabled(true);
+  queryField->installEventFilter(this);
+
+  resultList = new QListWidget(this);
+  resultList->setUniformItemSizes(true);
+
+  statusLabel = new QLabel(this);
+
+  layout->addWidget(queryField);
+  layout->addWidget(resultList);
+  layout->addWidget(statusLabel);
+
+  connect(queryField, &QLineEdit::textChanged, this,
+          [&] { updateResults(); });
+  connect(queryField, &QLineEdit::returnPressed, this,
+          [&] { selectCurrentMap(); });
+  connect(resultList, &QListWidget::itemActivated, this,
+          [&] { selectCurrentMap(); });
+  connect(index, &MapIndex::indexUpdated, this, [&] {
+    updateResults();
+    updateStatus();
+  });
+
+  // pick up maps added since the last time the index was refreshed
+  index->refresh();
+
+  updateResults();
+  updateStatus();
+}
+
+bool MapPickerDialog::eventFilter(QObject *object, QEvent *event) {
+  // keep typing in the query field, but navigate the results with arrow keys
+  if (object == queryField && event->type() == QEvent::KeyPress) {
+    const auto *keyEvent = static_cast<QKeyEvent *>(event);
+
+    switch (keyEvent->key()) {
+    case Qt::Key_Up:
+    case Qt::Key_Down:
+    case Qt::Key_PageUp:
+    case Qt::Key_PageDown:
+      QApplication::sendEvent(resultList, event);
+      return true;
+    default:
+      break;
+    }
+  }
+
+  return QDialog::eventFilter(object, event);
+}
+
+void MapPickerDialog::updateResults() const {
+  resultList->clear();
+
+  for (const auto i : index->match(queryField->text(), MAX_RESULTS)) {
+    auto *item = new QListWidgetItem(index->displayName(i), resultList);
+    item->setData(Qt::UserRole, index->path(i));
+    item->setToolTip(index->path(i));
+  }
+
+  resultList->setCurrentRow(0);
+}
+
+void MapPickerDialog::updateStatus() const {
+  if (index->root().isEmpty()) {
+    statusLabel->setText(
+        tr("Set the mapping install location in preferences to index maps."));
+  } else if (index->isRefreshing()) {
+    statusLabel->setText(tr("%n map(s) in %1, updating index...", "",
+                            static_cast<int>(index->size()))
+                             .arg(index->root()));
+  } else {
+    statusLabel->setText(
+        tr("%n map(s) in %1", "", static_cast<int>(index->size()))
+            .arg(index->root()));
+  }
+}
+
+void MapPickerDialog::selectCurrentMap() {
+  const QListWidgetItem *item = resultList->currentItem();
+
+  if (!item) {
+    return;
+  }
+
+  const QString path = item->data(Qt::UserRole).toString();
+  accept();
+  emit mapSelected(path);
+}
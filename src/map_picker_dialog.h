@@ -0,0 +1,63 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "map_index.h"
+
+#include <QDialog>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QVBoxLayout>
+
+// Type-ahead map picker, which fuzzy matches the query against the map index
+class MapPickerDialog : public QDialog {
+  Q_OBJECT
+
+public:
+  MapPickerDialog(QWidget *parent, MapIndex *mapIndex);
+
+signals:
+  void mapSelected(const QString &path);
+
+protected:
+  bool eventFilter(QObject *object, QEvent *event) override;
+
+private:
+  void updateResults() const;
+  void updateStatus() const;
+  void selectCurrentMap();
+
+  // more results than this are never useful, and filling the list
+  // with every map on an empty query would be slow
+  static constexpr int MAX_RESULTS = 100;
+
+  MapIndex *index;
+
+  QVBoxLayout *layout{};
+  QLineEdit *queryField{};
+  QListWidget *resultList{};
+  QLabel *statusLabel{};
+};
@@ -0,0 +1,167 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "memory_admission.h"
+#include "filesystem.h"
+#include "system_memory.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QLocale>
+#include <QObject>
+#include <QSaveFile>
+#include <algorithm>
+
+namespace {
+constexpr quint32 CACHE_MAGIC = 0x5150504d; // "QPPM"
+constexpr quint32 CACHE_VERSION = 1;
+const QString cacheFilename = "job_memory.dat";
+
+// for maps which haven't been packed yet
+constexpr qint64 DEFAULT_PEAK_KB = 1024 * 1024;
+
+// maps grow between runs, and peaks are sampled
+constexpr int PEAK_MARGIN_PERCENT = 10;
+
+// left for the editor, the game and everything else
+constexpr qint64 MIN_HEADROOM_KB = 512 * 1024;
+constexpr int HEADROOM_PERCENT = 5;
+
+// some task stalled on memory for this much of the last 10 seconds
+constexpr double PRESSURE_LIMIT = 5.0;
+
+QString formatKb(const qint64 kb) {
+  return QLocale().formattedDataSize(kb * 1024);
+}
+} // namespace
+
+MemoryAdmission::MemoryAdmission() { load(); }
+
+bool MemoryAdmission::admit(const QString &key,
+                            const QList<RunningJob> &running,
+                            QString &reason) const {
+  if (running.isEmpty() || !SystemMemory::isSupported()) {
+    return true;
+  }
+
+  const double pressure = SystemMemory::pressure();
+
+  if (pressure >= PRESSURE_LIMIT) {
+    reason = QObject::tr("memory pressure at %1%").arg(pressure, 0, 'f', 1);
+    return false;
+  }
+
+  const qint64 available = SystemMemory::availableKb();
+
+  if (available < 0) {
+    return true;
+  }
+
+  // memory already used by running jobs isn't available anymore,
+  // only what they'll still grow into has to be reserved for them
+  qint64 reserved = 0;
+
+  for (const auto &job : running) {
+    reserved += qMax(0LL, expectedPeakKb(job.key) - qMax(0LL, job.rssKb));
+  }
+
+  const qint64 headroom = qMax(
+      MIN_HEADROOM_KB, SystemMemory::totalKb() * HEADROOM_PERCENT / 100);
+  const qint64 needed = expectedPeakKb(key) + reserved + headroom;
+
+  if (needed > available) {
+    reason = QObject::tr("needs %1, %2 available")
+                 .arg(formatKb(needed), formatKb(available));
+    return false;
+  }
+
+  return true;
+}
+
+void MemoryAdmission::recordPeak(const QString &key, const qint64 peakKb) {
+  if (key.isEmpty() || peakKb <= 0) {
+    return;
+  }
+
+  peaks.insert(key, peakKb);
+  save();
+}
+
+// the latest peak of the map, or the median peak of every map if it hasn't
+// been packed yet, as maps in the same install tend to be of similar size
+qint64 MemoryAdmission::expectedPeakKb(const QString &key) const {
+  qint64 peak = peaks.value(key, -1);
+
+  if (peak < 0) {
+    if (peaks.isEmpty()) {
+      return DEFAULT_PEAK_KB;
+    }
+
+    QList<qint64> values = peaks.values();
+    std::nth_element(values.begin(), values.begin() + values.size() / 2,
+                     values.end());
+    peak = values[values.size() / 2];
+  }
+
+  return peak + peak * PEAK_MARGIN_PERCENT / 100;
+}
+
+void MemoryAdmission::load() {
+  QFile file(FileSystem::getCacheFilePath(cacheFilename));
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+
+  quint32 magic{};
+  quint32 version{};
+  QHash<QString, qint64> loaded{};
+  stream >> magic >> version;
+
+  if (magic != CACHE_MAGIC || version != CACHE_VERSION) {
+    return;
+  }
+
+  stream >> loaded;
+
+  if (stream.status() == QDataStream::Ok) {
+    peaks = loaded;
+  }
+}
+
+void MemoryAdmission::save() const {
+  QSaveFile file(FileSystem::getCacheFilePath(cacheFilename));
+
+  if (!file.open(QIODevice::WriteOnly)) {
+    return;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+  stream << CACHE_MAGIC << CACHE_VERSION << peaks;
+  file.commit();
+}
@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+// Decides whether another Pack3r job fits in memory, so that concurrent jobs
+// on large maps don't push the machine into swap, which is far slower than
+// running them one after another.
+//
+// A job is admitted if its expected peak memory, plus what the running jobs
+// are still expected to grow into, fits in the available memory with some
+// headroom left for everything else. Expected peaks come from earlier runs
+// of the same map. No jobs are admitted while the kernel reports memory
+// pressure, and a job is always admitted when nothing else is running.
+class MemoryAdmission {
+public:
+  struct RunningJob {
+    QString key;
+    qint64 rssKb{-1};
+  };
+
+  MemoryAdmission();
+
+  // 'key' identifies the map of a job, 'reason' is set if it's not admitted
+  bool admit(const QString &key, const QList<RunningJob> &running,
+             QString &reason) const;
+
+  void recordPeak(const QString &key, qint64 peakKb);
+  qint64 expectedPeakKb(const QString &key) const;
+
+private:
+  void load();
+  void save() const;
+
+  QHash<QString, qint64> peaks;
+};
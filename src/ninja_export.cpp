@@ -0,0 +1,185 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ninja_export.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
+
+namespace {
+// relative to the build file, as Ninja runs in its directory
+const QString depsDirectory = "pack3r_deps";
+
+bool saveFile(const QString &path, const QByteArray &contents,
+              QString &error) {
+  QSaveFile file(path);
+
+  if (!file.open(QIODevice::WriteOnly) || file.write(contents) == -1 ||
+      !file.commit()) {
+    error = QObject::tr("Unable to write %1: %2").arg(path, file.errorString());
+    return false;
+  }
+
+  return true;
+}
+
+// rule names can only have letters, digits, '_', '.' and '-'
+QString ruleName(const QString &mapPath, QSet<QString> &used) {
+  static const QRegularExpression invalid(R"([^\w.-])");
+  const QString base =
+      "pack_" + QFileInfo(mapPath).completeBaseName().replace(invalid, "_");
+  QString name = base;
+
+  for (int i = 2; used.contains(name); i++) {
+    name = base + "_" + QString::number(i);
+  }
+
+  used.insert(name);
+  return name;
+}
+} // namespace
+
+bool NinjaExport::write(const QString &path, const QList<Target> &targets,
+                        QString &error) {
+  const QDir buildDir = QFileInfo(path).absoluteDir();
+
+  if (!buildDir.mkpath(depsDirectory)) {
+    error = QObject::tr("Unable to create %1")
+                .arg(buildDir.filePath(depsDirectory));
+    return false;
+  }
+
+  QString ninja = QString("# Generated by %1 %2, export again once maps use "
+                          "new assets\n"
+                          "ninja_required_version = 1.3\n")
+                      .arg(PROJECT_NAME, PROJECT_VERSION);
+
+  QSet<QString> ruleNames{};
+  QStringList outputs{};
+
+  for (const auto &target : targets) {
+    const QString rule = ruleName(target.mapPath, ruleNames);
+    const QString output = QDir::fromNativeSeparators(target.output);
+    const QString depfile = depsDirectory + "/" + rule + ".d";
+
+    QString dependencies = escapeDepfilePath(output) + ":";
+
+    for (const auto &dependency : target.dependencies) {
+      dependencies += " \\\n  " +
+                      escapeDepfilePath(QDir::fromNativeSeparators(dependency));
+    }
+
+    if (!saveFile(buildDir.filePath(depfile), (dependencies + "\n").toUtf8(),
+                  error)) {
+      return false;
+    }
+
+    QStringList command{quoteArgument(target.program)};
+
+    for (const auto &argument :
+         buildArguments(target.arguments, target.output)) {
+      command.append(quoteArgument(argument));
+    }
+
+    ninja += "\nrule " + rule + "\n";
+    ninja += "  command = " + command.join(' ').replace('$', "$$") + "\n";
+    ninja += "  description = Packing " +
+             QFileInfo(target.mapPath).fileName().replace('$', "$$") + "\n";
+    ninja += "  depfile = " + depfile + "\n";
+    // the map is an explicit input, so a missing map is an error in Ninja
+    // instead of a rule which always runs
+    ninja += "build " + escapePath(output) + ": " + rule + " " +
+             escapePath(QDir::fromNativeSeparators(target.mapPath)) + "\n";
+
+    outputs.append(escapePath(output));
+  }
+
+  ninja += "\nbuild all: phony " + outputs.join(' ') + "\n";
+  ninja += "default all\n";
+
+  return saveFile(path, ninja.toUtf8(), error);
+}
+
+QStringList NinjaExport::buildArguments(const QStringList &arguments,
+                                        const QString &output) {
+  QStringList result{};
+
+  for (qsizetype i = 0; i < arguments.size(); i++) {
+    const QString &argument = arguments[i];
+
+    if (argument == "-o" || argument == "-r") {
+      i++;
+    } else if (argument != "-d" && argument != "-f") {
+      result.append(argument);
+    }
+  }
+
+  result << "-o" << output << "-f";
+  return result;
+}
+
+// paths in build statements end at spaces and colons
+QString NinjaExport::escapePath(const QString &path) {
+  QString escaped = path;
+  escaped.replace('$', "$$");
+  escaped.replace(' ', "$ ");
+  escaped.replace(':', "$:");
+  return escaped;
+}
+
+// depfiles are in Makefile syntax, which Ninja reads with its own parser
+QString NinjaExport::escapeDepfilePath(const QString &path) {
+  QString escaped = path;
+  escaped.replace('$', "$$");
+  escaped.replace(' ', "\\ ");
+  escaped.replace('#', "\\#");
+  return escaped;
+}
+
+// commands are run through the shell on Unix, and on Windows arguments are
+// split by the C runtime of the program
+QString NinjaExport::quoteArgument(const QString &argument) {
+  static const QRegularExpression plain(R"(^[\w@%+=:,./-]+$)");
+
+  if (plain.match(argument).hasMatch()) {
+    return argument;
+  }
+
+#ifdef Q_OS_WIN
+  // backslashes are only special in front of a quote
+  static const QRegularExpression beforeQuote(R"((\\*)")");
+  static const QRegularExpression trailing(R"((\\+)$)");
+
+  QString quoted = argument;
+  quoted.replace(beforeQuote, R"(\1\1\")");
+  quoted.replace(trailing, R"(\1\1)");
+  return '"' + quoted + '"';
+#else
+  QString quoted = argument;
+  return "'" + quoted.replace("'", R"('\'')") + "'";
+#endif
+}
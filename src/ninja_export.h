@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QStringList>
+
+// Writes a Ninja build file which packs maps with Pack3r, so packing can be
+// a part of an existing Ninja build. Each map gets its own rule with the
+// Pack3r command, and a depfile listing the files its pk3 is built from, so
+// Ninja only repacks maps whose map or assets changed, running the rest in
+// parallel by itself.
+//
+// Depfiles are written to a directory next to the build file, Ninja reads
+// them on every build. They're only as current as the export, so it has to
+// be redone once a map starts using new assets.
+class NinjaExport {
+public:
+  struct Target {
+    QString mapPath;
+    QString output;
+    QString program;
+    QStringList arguments;
+    QStringList dependencies; // absolute paths
+  };
+
+  static bool write(const QString &path, const QList<Target> &targets,
+                    QString &error);
+
+  // Pack3r arguments as run by Ninja, which never answers the overwrite
+  // prompt, and expects the pk3 to be written to the output of the build
+  // statement, so any -o and -r of the arguments are replaced
+  static QStringList buildArguments(const QStringList &arguments,
+                                    const QString &output);
+
+private:
+  static QString escapePath(const QString &path);
+  static QString escapeDepfilePath(const QString &path);
+  static QString quoteArgument(const QString &argument);
+};
@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "output_recording.h"
+
+namespace {
+constexpr quint32 RECORDING_MAGIC = 0x51505243; // "QPRC"
+constexpr quint32 RECORDING_VERSION = 1;
+} // namespace
+
+bool OutputRecording::open(const QString &path) {
+  close();
+  file.setFileName(path);
+
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    return false;
+  }
+
+  stream.setDevice(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+  stream << RECORDING_MAGIC << RECORDING_VERSION;
+  timer.start();
+  return true;
+}
+
+bool OutputRecording::isOpen() const { return file.isOpen(); }
+
+void OutputRecording::append(const QByteArrayView data) {
+  stream << timer.nsecsElapsed();
+  stream.writeBytes(data.data(), static_cast<uint>(data.size()));
+}
+
+void OutputRecording::close() {
+  if (file.isOpen()) {
+    stream.setDevice(nullptr);
+    file.close();
+  }
+}
+
+QString OutputRecording::errorString() const { return file.errorString(); }
+
+bool OutputRecording::read(const QString &path, QList<Chunk> &chunks,
+                           QString &error) {
+  QFile input(path);
+
+  if (!input.open(QIODevice::ReadOnly)) {
+    error = input.errorString();
+    return false;
+  }
+
+  QDataStream in(&input);
+  in.setVersion(QDataStream::Qt_6_2);
+
+  quint32 magic{};
+  quint32 version{};
+  in >> magic >> version;
+
+  if (magic != RECORDING_MAGIC || version != RECORDING_VERSION) {
+    error = QObject::tr("Not a QtPack3r output recording");
+    return false;
+  }
+
+  chunks.clear();
+
+  while (!in.atEnd()) {
+    Chunk chunk{};
+    in >> chunk.nsecs >> chunk.data;
+
+    if (in.status() != QDataStream::Ok) {
+      error = QObject::tr("Recording is truncated");
+      return false;
+    }
+
+    chunks.append(chunk);
+  }
+
+  return true;
+}
@@ -0,0 +1,54 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
+
+// Timestamped recording of Pack3r standard output. QtPack3r writes one for
+// every local run if QTPACK3R_RECORD_OUTPUT is set to a file path, and the
+// Pack3r stand-in in tools/ replays it with the original timing, so output
+// handling can be load tested without depending on a map or the disk.
+class OutputRecording {
+public:
+  struct Chunk {
+    qint64 nsecs{}; // since the start of the recording
+    QByteArray data;
+  };
+
+  bool open(const QString &path);
+  bool isOpen() const;
+  void append(QByteArrayView data);
+  void close();
+  QString errorString() const;
+
+  static bool read(const QString &path, QList<Chunk> &chunks, QString &error);
+
+private:
+  QFile file;
+  QDataStream stream;
+  QElapsedTimer timer;
+};
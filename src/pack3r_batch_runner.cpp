@@ -0,0 +1,252 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pack3r_batch_runner.h"
+#include "pk3_diff.h"
+#include "preferences.h"
+
+Pack3rBatchRunner::Pack3rBatchRunner(QObject *parent)
+    : QObject(parent),
+      queue(new Pack3rJobQueue(
+          this,
+          preferences.readSetting(Preferences::Settings::MAX_CONCURRENT_JOBS)
+              .toInt())),
+      daemonClient(new Pack3rDaemonClient(this)),
+      workerThread(new QThread(this)) {
+  workerThread->setObjectName("Batch output worker");
+  workerThread->start();
+
+  setupQueueConnections();
+  setupDaemonConnections();
+}
+
+Pack3rBatchRunner::~Pack3rBatchRunner() {
+  workerThread->quit();
+  workerThread->wait();
+}
+
+void Pack3rBatchRunner::enqueue(const QList<BatchJob> &batchJobs) {
+  // a finished batch is not counted towards the progress of a new one
+  if (!isRunning()) {
+    finishedJobs = 0;
+    totalJobs = 0;
+  }
+
+  totalJobs += static_cast<int>(batchJobs.size());
+  emit progressChanged(finishedJobs, totalJobs);
+
+  const bool useDaemon =
+      preferences.readSetting(Preferences::Settings::USE_DAEMON).toBool() &&
+      daemonClient->connectToDaemon();
+
+  queue->setMaxConcurrentJobs(
+      preferences.readSetting(Preferences::Settings::MAX_CONCURRENT_JOBS)
+          .toInt());
+
+  for (const auto &job : batchJobs) {
+    // kept for comparing the new build against, see Pk3Diff
+    if (!job.arguments.contains("-d")) {
+      Pk3Diff::savePrevious(job.outputFile);
+    }
+
+    if (useDaemon) {
+      const quint64 tag =
+          daemonClient->submit(job.program, job.arguments, job.outputFile,
+                               job.priority, job.runtime,
+                               !job.prePack.isEmpty());
+      pendingRemoteJobs.insert(tag, job.label);
+    } else {
+      // the id isn't known until enqueue() returns,
+      // so the job is tracked from the jobQueued() signal instead
+      pendingLocalLabel = job.label;
+      queue->enqueue(job.program, job.arguments, job.outputFile,
+                     job.priority, job.runtime, job.prePack);
+    }
+  }
+}
+
+void Pack3rBatchRunner::cancelAll() {
+  for (const auto id : localJobs.keys()) {
+    queue->cancel(id);
+  }
+
+  for (const auto id : remoteJobs.keys()) {
+    daemonClient->cancel(id);
+  }
+}
+
+bool Pack3rBatchRunner::isRunning() const {
+  return !localJobs.isEmpty() || !remoteJobs.isEmpty() ||
+         !pendingRemoteJobs.isEmpty() || finishingJobs > 0;
+}
+
+void Pack3rBatchRunner::setupQueueConnections() {
+  connect(queue, &Pack3rJobQueue::jobQueued, this, [this](const quint64 id) {
+    trackJob(localJobs, id, pendingLocalLabel);
+  });
+
+  connect(queue, &Pack3rJobQueue::jobOutput, this,
+          [this](const quint64 id, const QByteArray &data) {
+            handleOutput(localJobs, id, data);
+          });
+
+  connect(queue, &Pack3rJobQueue::jobFinished, this,
+          [this](const quint64 id, const int exitCode,
+                 const Pack3rJobQueue::JobState state) {
+            finishJob(localJobs, id, exitCode,
+                      state == Pack3rJobQueue::CANCELED);
+          });
+
+  connect(queue, &Pack3rJobQueue::admissionHeld, this,
+          [this](const QString &reason) {
+            emit outputLine(
+                tr("Waiting for memory before starting the next job (%1)")
+                    .arg(reason)
+                    .toUtf8());
+          });
+}
+
+void Pack3rBatchRunner::setupDaemonConnections() {
+  connect(daemonClient, &Pack3rDaemonClient::jobAccepted, this,
+          [this](const quint64 tag, const quint64 id) {
+            if (pendingRemoteJobs.contains(tag)) {
+              trackJob(remoteJobs, id, pendingRemoteJobs.take(tag));
+            }
+          });
+
+  connect(daemonClient, &Pack3rDaemonClient::jobOutput, this,
+          [this](const quint64 id, const QByteArray &data) {
+            handleOutput(remoteJobs, id, data);
+          });
+
+  connect(daemonClient, &Pack3rDaemonClient::jobFinished, this,
+          [this](const quint64 id, const int exitCode, const bool canceled) {
+            finishJob(remoteJobs, id, exitCode, canceled);
+          });
+
+  connect(daemonClient, &Pack3rDaemonClient::disconnected, this, [this] {
+    for (const auto id : remoteJobs.keys()) {
+      finishJob(remoteJobs, id, -1, true);
+    }
+
+    finishedJobs += static_cast<int>(pendingRemoteJobs.size());
+    pendingRemoteJobs.clear();
+    emit outputLine(tr("Lost connection to pack daemon").toUtf8());
+    emit progressChanged(finishedJobs, totalJobs);
+  });
+}
+
+// the worker is only used to parse output, the process itself is run by
+// the job queue or the daemon
+void Pack3rBatchRunner::trackJob(QHash<quint64, RunningJob> &jobs,
+                                 const quint64 id, const QString &label) {
+  RunningJob job{};
+  job.label = label;
+  job.worker = new Pack3rProcessWorker();
+  job.worker->reset(false, false);
+  job.worker->moveToThread(workerThread);
+  connect(workerThread, &QThread::finished, job.worker, &QObject::deleteLater);
+
+  const bool local = &jobs == &localJobs;
+
+  // receivers are done with the batch once outputReady() returns
+  connect(job.worker, &Pack3rProcessWorker::outputReady, this,
+          [this, label, worker = job.worker](const QByteArray &lines) {
+            emit outputReady(label, lines);
+            QMetaObject::invokeMethod(
+                worker, [worker, lines] { worker->recycleBatch(lines); });
+          });
+
+  // batch jobs are not interactive, so never overwrite existing files
+  // unless the overwrite option was passed to Pack3r
+  connect(job.worker, &Pack3rProcessWorker::overwritePrompted, this,
+          [this, id, local, worker = job.worker] {
+            if (local) {
+              queue->write(id, "n\n");
+            } else {
+              daemonClient->write(id, "n\n");
+            }
+
+            QMetaObject::invokeMethod(worker, [worker] {
+              worker->processOutput("Output exists, skipping\n");
+            });
+          });
+
+  // finished() is emitted after the last batch of output
+  connect(job.worker, &Pack3rProcessWorker::finished, this,
+          [this, label, worker = job.worker](const int exitCode) {
+            if (canceledWorkers.remove(worker)) {
+              emit jobStatus(label, tr("Canceled").toUtf8(),
+                             Pack3rOutputParser::LOG_WARN);
+            } else {
+              emit jobStatus(
+                  label,
+                  tr("Finished with exit code %1").arg(exitCode).toUtf8(),
+                  exitCode == 0 ? Pack3rOutputParser::LOG_INFO
+                                : Pack3rOutputParser::LOG_ERROR);
+            }
+
+            worker->deleteLater();
+
+            finishingJobs--;
+            finishedJobs++;
+            emit progressChanged(finishedJobs, totalJobs);
+          });
+
+  jobs.insert(id, job);
+}
+
+void Pack3rBatchRunner::handleOutput(QHash<quint64, RunningJob> &jobs,
+                                     const quint64 id, const QByteArray &data) {
+  const auto it = jobs.find(id);
+
+  if (it == jobs.end()) {
+    return;
+  }
+
+  QMetaObject::invokeMethod(it->worker, [worker = it->worker, data] {
+    worker->processOutput(data);
+  });
+}
+
+void Pack3rBatchRunner::finishJob(QHash<quint64, RunningJob> &jobs,
+                                  const quint64 id, const int exitCode,
+                                  const bool canceled) {
+  const auto it = jobs.find(id);
+
+  if (it == jobs.end()) {
+    return;
+  }
+
+  Pack3rProcessWorker *worker = it->worker;
+  jobs.erase(it);
+  finishingJobs++;
+
+  if (canceled) {
+    canceledWorkers.insert(worker);
+  }
+
+  QMetaObject::invokeMethod(
+      worker, [worker, exitCode] { worker->finish(exitCode); });
+}
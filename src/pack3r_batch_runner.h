@@ -0,0 +1,102 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "pack3r_daemon.h"
+#include "pack3r_job_queue.h"
+#include "pack3r_process_worker.h"
+
+#include <QSet>
+#include <QThread>
+
+// Runs multiple Pack3r jobs non-interactively, either on a local job queue
+// or on the pack daemon if it's enabled and running. Output of each job is
+// parsed by a worker of its own on the batch output thread, and delivered
+// in batches along with the label of the job, so interleaved output remains
+// readable.
+class Pack3rBatchRunner : public QObject {
+  Q_OBJECT
+
+public:
+  struct BatchJob {
+    QString label;
+    QString program;
+    QStringList arguments;
+    QString outputFile;
+    ProcessPriority::Profile priority;
+    RuntimeProfile::Profile runtime;
+    PrePackCommand::Command prePack;
+  };
+
+  explicit Pack3rBatchRunner(QObject *parent);
+  ~Pack3rBatchRunner() override;
+
+  void enqueue(const QList<BatchJob> &batchJobs);
+  void cancelAll();
+  bool isRunning() const;
+
+signals:
+  // status lines of the batch as a whole
+  void outputLine(const QByteArray &line);
+  // '\n' terminated lines of parsed output of the job labeled 'label'
+  void outputReady(const QString &label, const QByteArray &lines);
+  void jobStatus(const QString &label, const QByteArray &line,
+                 Pack3rOutputParser::LogLevel level);
+  void progressChanged(int finished, int total);
+
+private:
+  struct RunningJob {
+    QString label;
+    Pack3rProcessWorker *worker{};
+  };
+
+  void setupQueueConnections();
+  void setupDaemonConnections();
+
+  void trackJob(QHash<quint64, RunningJob> &jobs, quint64 id,
+                const QString &label);
+  void handleOutput(QHash<quint64, RunningJob> &jobs, quint64 id,
+                    const QByteArray &data);
+  void finishJob(QHash<quint64, RunningJob> &jobs, quint64 id, int exitCode,
+                 bool canceled);
+
+  Pack3rJobQueue *queue;
+  Pack3rDaemonClient *daemonClient;
+  QThread *workerThread;
+
+  // local and daemon job ids are not unique between each other
+  QHash<quint64, RunningJob> localJobs;
+  QHash<quint64, RunningJob> remoteJobs;
+
+  // labels of jobs submitted to the daemon, but not yet accepted
+  QHash<quint64, QString> pendingRemoteJobs;
+  QString pendingLocalLabel;
+
+  // jobs which have finished, but whose output is still being flushed
+  int finishingJobs{};
+  QSet<const Pack3rProcessWorker *> canceledWorkers;
+  int finishedJobs{};
+  int totalJobs{};
+};
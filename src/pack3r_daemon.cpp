@@ -0,0 +1,393 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pack3r_daemon.h"
+#include "preferences.h"
+
+#include <QJsonDocument>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr qsizetype MAX_OUTPUT_HISTORY = 4 * 1024 * 1024;
+
+#ifdef Q_OS_LINUX
+// uid of the process on the other end of the socket, -1 if it can't be
+// known. Elsewhere the socket permissions are all there is
+qint64 peerUid(const QLocalSocket *socket) {
+  ucred credentials{};
+  socklen_t length = sizeof(credentials);
+
+  if (getsockopt(static_cast<int>(socket->socketDescriptor()), SOL_SOCKET,
+                 SO_PEERCRED, &credentials, &length) == 0) {
+    return credentials.uid;
+  }
+
+  return -1;
+}
+#endif
+} // namespace
+
+Pack3rDaemon::Pack3rDaemon(QObject *parent, const int maxConcurrentJobs)
+    : QObject(parent), server(new QLocalServer(this)),
+      queue(new Pack3rJobQueue(this, maxConcurrentJobs)) {
+  connect(server, &QLocalServer::newConnection, this,
+          &Pack3rDaemon::acceptConnection);
+
+  connect(queue, &Pack3rJobQueue::jobStarted, this, [this](const quint64 id) {
+    broadcast(id, {{"type", "started"}, {"id", static_cast<qint64>(id)}});
+  });
+
+  connect(queue, &Pack3rJobQueue::jobOutput, this,
+          [this](const quint64 id, const QByteArray &data) {
+            outputHistory[id].append(data);
+            broadcast(id, {{"type", "output"},
+                           {"id", static_cast<qint64>(id)},
+                           {"data", QString::fromLatin1(data.toBase64())}});
+          });
+
+  connect(queue, &Pack3rJobQueue::jobFinished, this,
+          [this](const quint64 id, const int exitCode,
+                 const Pack3rJobQueue::JobState state) {
+            broadcast(id, {{"type", "finished"},
+                           {"id", static_cast<qint64>(id)},
+                           {"exitCode", exitCode},
+                           {"canceled", state == Pack3rJobQueue::CANCELED}});
+            subscribers.remove(id);
+            outputHistory.remove(id);
+          });
+}
+
+bool Pack3rDaemon::listen() {
+  server->setSocketOptions(QLocalServer::UserAccessOption);
+
+  if (server->listen(socketName())) {
+    return true;
+  }
+
+  // a stale socket file is left behind if a previous daemon crashed,
+  // but don't remove it if there's an actual daemon still listening on it
+  if (server->serverError() == QAbstractSocket::AddressInUseError) {
+    QLocalSocket probe{};
+    probe.connectToServer(socketName());
+
+    if (probe.waitForConnected(500)) {
+      return false;
+    }
+
+    QLocalServer::removeServer(socketName());
+    return server->listen(socketName());
+  }
+
+  return false;
+}
+
+QString Pack3rDaemon::errorString() const { return server->errorString(); }
+
+QString Pack3rDaemon::socketName() {
+#ifdef Q_OS_LINUX
+  const QString user = QString::number(getuid());
+#else
+  const QString user =
+      qEnvironmentVariable("USER", qEnvironmentVariable("USERNAME"));
+#endif
+
+  return QString("%1-%2").arg(DAEMON_SOCKET_NAME, user);
+}
+
+void Pack3rDaemon::acceptConnection() {
+  while (QLocalSocket *socket = server->nextPendingConnection()) {
+#ifdef Q_OS_LINUX
+    // the socket permissions should already keep other users out
+    if (peerUid(socket) != static_cast<qint64>(getuid())) {
+      socket->abort();
+      socket->deleteLater();
+      continue;
+    }
+#endif
+
+    connect(socket, &QLocalSocket::readyRead, this,
+            [this, socket] { readMessages(socket); });
+    connect(socket, &QLocalSocket::disconnected, this, [this, socket] {
+      dropClient(socket);
+      socket->deleteLater();
+    });
+  }
+}
+
+void Pack3rDaemon::readMessages(QLocalSocket *socket) {
+  while (socket->canReadLine()) {
+    const QJsonDocument doc = QJsonDocument::fromJson(socket->readLine());
+
+    if (!doc.isObject()) {
+      send(socket, {{"type", "error"}, {"message", "Malformed message"}});
+      continue;
+    }
+
+    handleMessage(socket, doc.object());
+  }
+}
+
+void Pack3rDaemon::handleMessage(QLocalSocket *socket,
+                                 const QJsonObject &message) {
+  const QString type = message["type"].toString();
+  const auto id = static_cast<quint64>(message["id"].toInteger());
+
+  if (type == "submit") {
+    const QString program =
+        preferences.readSetting(Preferences::Settings::PACK3R_PATH).toString();
+    QStringList arguments{};
+
+    for (const auto &arg : message["arguments"].toArray()) {
+      arguments.append(arg.toString());
+    }
+
+    if (program.isEmpty()) {
+      send(socket,
+           {{"type", "error"},
+            {"message", "Path to Pack3r is not set in daemon preferences"}});
+      return;
+    }
+
+    const PrePackCommand::Command prePack =
+        message["prePack"].toBool() ? PrePackCommand::forMap(arguments.value(0))
+                                    : PrePackCommand::Command{};
+
+    quint64 jobId = queue->findActiveJob(program, arguments, prePack);
+    const bool attached = jobId != 0;
+
+    if (!attached) {
+      jobId = queue->enqueue(
+          program, arguments, message["outputFile"].toString(),
+          ProcessPriority::fromJson(message["priority"].toObject()),
+          RuntimeProfile::fromJson(message["runtime"].toObject()), prePack);
+    }
+
+    // the queue starts jobs from the event loop, so the client is
+    // subscribed before anything about the job is broadcast
+    send(socket, {{"type", "accepted"},
+                  {"tag", message["tag"]},
+                  {"id", static_cast<qint64>(jobId)},
+                  {"attached", attached}});
+    attachClient(socket, jobId);
+  } else if (type == "attach") {
+    if (!queue->isActive(id)) {
+      send(socket,
+           {{"type", "error"},
+            {"message", QString("No active job with id %1").arg(id)}});
+      return;
+    }
+
+    attachClient(socket, id);
+  } else if (type == "cancel") {
+    queue->cancel(id);
+  } else if (type == "input") {
+    queue->write(id,
+                 QByteArray::fromBase64(message["data"].toString().toLatin1()));
+  } else if (type == "list") {
+    static const QStringList stateNames = {"queued", "running", "finished",
+                                           "canceled"};
+    QJsonArray jobs{};
+
+    for (const auto &job : queue->activeJobs()) {
+      jobs.append(QJsonObject{
+          {"id", static_cast<qint64>(job.id)},
+          {"program", job.program},
+          {"arguments", QJsonArray::fromStringList(job.arguments)},
+          {"state", stateNames[job.state]}});
+    }
+
+    send(socket, {{"type", "jobs"}, {"jobs", jobs}});
+  } else {
+    send(socket, {{"type", "error"},
+                  {"message", QString("Unknown message '%1'").arg(type)}});
+  }
+}
+
+void Pack3rDaemon::attachClient(QLocalSocket *socket, const quint64 id) {
+  auto &clients = subscribers[id];
+
+  if (clients.contains(socket)) {
+    return;
+  }
+
+  clients.append(socket);
+
+  // replay everything the job has printed so far
+  const QByteArray history = outputHistory.value(id).contents();
+
+  if (!history.isEmpty()) {
+    send(socket, {{"type", "output"},
+                  {"id", static_cast<qint64>(id)},
+                  {"data", QString::fromLatin1(history.toBase64())}});
+  }
+}
+
+void Pack3rDaemon::dropClient(QLocalSocket *socket) {
+  for (auto &clients : subscribers) {
+    clients.removeAll(socket);
+  }
+}
+
+void Pack3rDaemon::OutputHistory::append(QByteArrayView data) {
+  if (data.size() >= MAX_OUTPUT_HISTORY) {
+    buffer = data.last(MAX_OUTPUT_HISTORY).toByteArray();
+    next = 0;
+    return;
+  }
+
+  // the buffer grows until it's full, after which it's overwritten in place
+  if (buffer.size() < MAX_OUTPUT_HISTORY) {
+    const qsizetype count =
+        qMin(MAX_OUTPUT_HISTORY - buffer.size(), data.size());
+    buffer.append(data.first(count));
+    data = data.sliced(count);
+  }
+
+  while (!data.isEmpty()) {
+    const qsizetype count = qMin(MAX_OUTPUT_HISTORY - next, data.size());
+    std::memcpy(buffer.data() + next, data.data(), count);
+    next = (next + count) % MAX_OUTPUT_HISTORY;
+    data = data.sliced(count);
+  }
+}
+
+QByteArray Pack3rDaemon::OutputHistory::contents() const {
+  if (buffer.size() < MAX_OUTPUT_HISTORY) {
+    return buffer;
+  }
+
+  const QByteArray ordered = buffer.mid(next) + buffer.left(next);
+  return ordered.mid(ordered.indexOf('\n') + 1);
+}
+
+void Pack3rDaemon::broadcast(const quint64 id, const QJsonObject &message) {
+  for (const auto &socket : subscribers.value(id)) {
+    if (socket) {
+      send(socket, message);
+    }
+  }
+}
+
+void Pack3rDaemon::send(QLocalSocket *socket, const QJsonObject &message) {
+  socket->write(QJsonDocument(message).toJson(QJsonDocument::Compact) + '\n');
+}
+
+Pack3rDaemonClient::Pack3rDaemonClient(QObject *parent)
+    : QObject(parent), socket(new QLocalSocket(this)) {
+  connect(socket, &QLocalSocket::readyRead, this,
+          &Pack3rDaemonClient::readMessages);
+  connect(socket, &QLocalSocket::disconnected, this,
+          &Pack3rDaemonClient::disconnected);
+}
+
+bool Pack3rDaemonClient::connectToDaemon(const int timeoutMs) {
+  if (isConnected()) {
+    return true;
+  }
+
+  socket->connectToServer(Pack3rDaemon::socketName());
+  return socket->waitForConnected(timeoutMs);
+}
+
+bool Pack3rDaemonClient::isConnected() const {
+  return socket->state() == QLocalSocket::ConnectedState;
+}
+
+quint64 Pack3rDaemonClient::submit(const QString &program,
+                                   const QStringList &arguments,
+                                   const QString &outputFile,
+                                   const ProcessPriority::Profile &priority,
+                                   const RuntimeProfile::Profile &runtime,
+                                   const bool prePack) {
+  const quint64 tag = nextTag++;
+  const QJsonObject message = {
+      {"type", "submit"},
+      {"tag", static_cast<qint64>(tag)},
+      {"program", program},
+      {"arguments", QJsonArray::fromStringList(arguments)},
+      {"outputFile", outputFile},
+      {"priority", ProcessPriority::toJson(priority)},
+      {"runtime", RuntimeProfile::toJson(runtime)},
+      {"prePack", prePack}};
+
+  send(message);
+  return tag;
+}
+
+void Pack3rDaemonClient::attach(const quint64 id) {
+  send({{"type", "attach"}, {"id", static_cast<qint64>(id)}});
+}
+
+void Pack3rDaemonClient::cancel(const quint64 id) {
+  send({{"type", "cancel"}, {"id", static_cast<qint64>(id)}});
+}
+
+void Pack3rDaemonClient::write(const quint64 id, const QByteArray &data) {
+  send({{"type", "input"},
+        {"id", static_cast<qint64>(id)},
+        {"data", QString::fromLatin1(data.toBase64())}});
+}
+
+void Pack3rDaemonClient::requestJobList() { send({{"type", "list"}}); }
+
+void Pack3rDaemonClient::send(const QJsonObject &message) const {
+  socket->write(QJsonDocument(message).toJson(QJsonDocument::Compact) + '\n');
+}
+
+void Pack3rDaemonClient::readMessages() {
+  while (socket->canReadLine()) {
+    const QJsonDocument doc = QJsonDocument::fromJson(socket->readLine());
+
+    if (doc.isObject()) {
+      handleMessage(doc.object());
+    }
+  }
+}
+
+void Pack3rDaemonClient::handleMessage(const QJsonObject &message) {
+  const QString type = message["type"].toString();
+  const auto id = static_cast<quint64>(message["id"].toInteger());
+
+  if (type == "accepted") {
+    emit jobAccepted(static_cast<quint64>(message["tag"].toInteger()), id,
+                     message["attached"].toBool());
+  } else if (type == "started") {
+    emit jobStarted(id);
+  } else if (type == "output") {
+    emit jobOutput(
+        id, QByteArray::fromBase64(message["data"].toString().toLatin1()));
+  } else if (type == "finished") {
+    emit jobFinished(id, message["exitCode"].toInt(),
+                     message["canceled"].toBool());
+  } else if (type == "jobs") {
+    emit jobListReceived(message["jobs"].toArray());
+  } else if (type == "error") {
+    emit errorReceived(message["message"].toString());
+  }
+}
@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "pack3r_job_queue.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+
+// Prefix of the local socket the daemon listens on, see socketName()
+#define DAEMON_SOCKET_NAME "QtPack3r-daemon"
+
+/* The daemon owns a single job queue for the user, and clients talk to it
+ * over a local socket only that user can connect to. Messages are compact
+ * JSON objects, one per line, with a 'type' field identifying the message:
+ *
+ * client -> daemon
+ *   submit   { tag, program, arguments, outputFile, priority, runtime,
+ *              prePack: bool }
+ *   attach   { id }
+ *   cancel   { id }
+ *   input    { id, data }
+ *   list     {}
+ *
+ * daemon -> client
+ *   accepted { tag, id, attached }
+ *   started  { id }
+ *   output   { id, data }
+ *   finished { id, exitCode, canceled }
+ *   jobs     { jobs: [{ id, program, arguments, state }] }
+ *   error    { message }
+ *
+ * Process output and input is base64 encoded, as it's not guaranteed to be
+ * valid UTF-8. Submitting a command identical to a job that is already queued
+ * or running attaches the client to that job instead of starting a new one.
+ *
+ * The daemon never runs a program sent by a client. 'program' is replaced
+ * with the Pack3r path from the daemon's own preferences, and 'prePack' only
+ * selects whether the pre-pack command from them is run.
+ *
+ * Concurrency is limited per user, not machine-wide. Jobs run as the user
+ * who started the daemon, so sharing one daemon between users would let
+ * them run Pack3r as each other.
+ */
+class Pack3rDaemon : public QObject {
+  Q_OBJECT
+
+public:
+  Pack3rDaemon(QObject *parent, int maxConcurrentJobs);
+
+  bool listen();
+  QString errorString() const;
+
+  // the daemon runs programs as the user who started it,
+  // so each user has a daemon and a socket of their own
+  static QString socketName();
+
+private:
+  void acceptConnection();
+  void readMessages(QLocalSocket *socket);
+  void handleMessage(QLocalSocket *socket, const QJsonObject &message);
+  void attachClient(QLocalSocket *socket, quint64 id);
+  void dropClient(QLocalSocket *socket);
+
+  void broadcast(quint64 id, const QJsonObject &message);
+  static void send(QLocalSocket *socket, const QJsonObject &message);
+
+  // the most recent output of a job, kept in a fixed size ring so jobs
+  // printing a lot of output don't grow the daemon without bound
+  class OutputHistory {
+  public:
+    void append(QByteArrayView data);
+    // starts at a line boundary once older output has been dropped
+    QByteArray contents() const;
+
+  private:
+    QByteArray buffer;
+    // where the next byte goes once the buffer is full
+    qsizetype next{};
+  };
+
+  QLocalServer *server;
+  Pack3rJobQueue *queue;
+
+  // clients interested in each job, and the recent output of the job so
+  // clients attaching to a running job see the end of its log
+  QHash<quint64, QList<QPointer<QLocalSocket>>> subscribers;
+  QHash<quint64, OutputHistory> outputHistory;
+};
+
+class Pack3rDaemonClient : public QObject {
+  Q_OBJECT
+
+public:
+  explicit Pack3rDaemonClient(QObject *parent);
+
+  bool connectToDaemon(int timeoutMs = 500);
+  bool isConnected() const;
+
+  // returns a tag which is passed back in jobAccepted()
+  quint64 submit(const QString &program, const QStringList &arguments,
+                 const QString &outputFile,
+                 const ProcessPriority::Profile &priority = {},
+                 const RuntimeProfile::Profile &runtime = {},
+                 bool prePack = false);
+  void attach(quint64 id);
+  void cancel(quint64 id);
+  void write(quint64 id, const QByteArray &data);
+  void requestJobList();
+
+signals:
+  void jobAccepted(quint64 tag, quint64 id, bool attached);
+  void jobStarted(quint64 id);
+  void jobOutput(quint64 id, const QByteArray &data);
+  void jobFinished(quint64 id, int exitCode, bool canceled);
+  void jobListReceived(const QJsonArray &jobs);
+  void errorReceived(const QString &message);
+  void disconnected();
+
+private:
+  void send(const QJsonObject &message) const;
+  void readMessages();
+  void handleMessage(const QJsonObject &message);
+
+  QLocalSocket *socket;
+  quint64 nextTag = 1;
+};
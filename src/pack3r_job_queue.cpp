@@ -0,0 +1,343 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pack3r_job_queue.h"
+#include "system_memory.h"
+
+#include <algorithm>
+
+namespace {
+// memory of running jobs is sampled, and held back jobs are retried,
+// at this interval
+constexpr int MEMORY_SAMPLE_INTERVAL = 500;
+} // namespace
+
+Pack3rJobQueue::Pack3rJobQueue(QObject *parent, const int maxConcurrentJobs)
+    : QObject(parent), memoryTimer(new QTimer(this)),
+      maxJobs(qMax(1, maxConcurrentJobs)) {
+  childrenPeakKb = SystemMemory::childrenPeakKb();
+
+  memoryTimer->setInterval(MEMORY_SAMPLE_INTERVAL);
+  connect(memoryTimer, &QTimer::timeout, this, [this] {
+    sampleMemory();
+    startPendingJobs();
+  });
+}
+
+quint64 Pack3rJobQueue::enqueue(const QString &program,
+                                const QStringList &arguments,
+                                const QString &outputFile,
+                                const ProcessPriority::Profile &priority,
+                                const RuntimeProfile::Profile &runtime,
+                                const PrePackCommand::Command &prePack) {
+  Job job{};
+  job.id = nextJobId++;
+  job.program = program;
+  job.arguments = arguments;
+  job.outputFile = outputFile;
+  job.priority = priority;
+  job.runtime = runtime;
+  job.prePack = prePack;
+  job.state = QUEUED;
+  job.stage = prePack.isEmpty() ? PACK : PRE_PACK;
+
+  jobs.insert(job.id, job);
+  pendingJobs.enqueue(job.id);
+  emit jobQueued(job.id);
+
+  // started from the event loop, so whoever enqueued the job can connect to
+  // it before it starts, or fails to start, and emits anything about it
+  QMetaObject::invokeMethod(
+      this, [this] { startPendingJobs(); }, Qt::QueuedConnection);
+  return job.id;
+}
+
+void Pack3rJobQueue::cancel(const quint64 id) {
+  const auto it = jobs.find(id);
+
+  if (it == jobs.end()) {
+    return;
+  }
+
+  if (it->state == QUEUED) {
+    pendingJobs.removeOne(id);
+    it->state = CANCELED;
+    finishJob(id, -1);
+    return;
+  }
+
+  // the finished() signal of the process takes care of the cleanup
+  if (it->state == RUNNING) {
+    it->state = CANCELED;
+    it->process->kill();
+  }
+}
+
+void Pack3rJobQueue::write(const quint64 id, const QByteArray &data) {
+  const auto it = jobs.constFind(id);
+
+  if (it != jobs.constEnd() && it->state == RUNNING) {
+    it->process->write(data);
+  }
+}
+
+quint64 Pack3rJobQueue::findActiveJob(
+    const QString &program, const QStringList &arguments,
+    const PrePackCommand::Command &prePack) const {
+  for (const auto &job : jobs) {
+    if ((job.state == QUEUED || job.state == RUNNING) &&
+        job.program == program && job.arguments == arguments &&
+        job.prePack == prePack) {
+      return job.id;
+    }
+  }
+
+  return 0;
+}
+
+bool Pack3rJobQueue::isActive(const quint64 id) const {
+  const auto it = jobs.constFind(id);
+  return it != jobs.constEnd() && (it->state == QUEUED || it->state == RUNNING);
+}
+
+QList<Pack3rJobQueue::Job> Pack3rJobQueue::activeJobs() const {
+  QList<Job> active;
+
+  for (const auto &job : jobs) {
+    if (job.state == QUEUED || job.state == RUNNING) {
+      active.append(job);
+    }
+  }
+
+  std::sort(active.begin(), active.end(),
+            [](const Job &a, const Job &b) { return a.id < b.id; });
+  return active;
+}
+
+int Pack3rJobQueue::maxConcurrentJobs() const { return maxJobs; }
+
+void Pack3rJobQueue::setMaxConcurrentJobs(const int count) {
+  maxJobs = qMax(1, count);
+  startPendingJobs();
+}
+
+void Pack3rJobQueue::startPendingJobs() {
+  while (runningJobs < maxJobs && !pendingJobs.isEmpty()) {
+    QList<MemoryAdmission::RunningJob> running{};
+
+    for (const auto &job : std::as_const(jobs)) {
+      if (job.state == RUNNING) {
+        running.append({memoryKey(job), job.rssKb});
+      }
+    }
+
+    QString reason{};
+
+    // the memory timer keeps retrying while jobs are running
+    if (!admission.admit(memoryKey(jobs[pendingJobs.head()]), running,
+                         reason)) {
+      if (!admissionHeldBack) {
+        admissionHeldBack = true;
+        emit admissionHeld(reason);
+      }
+
+      return;
+    }
+
+    admissionHeldBack = false;
+    startJob(jobs[pendingJobs.dequeue()]);
+  }
+}
+
+void Pack3rJobQueue::startJob(Job &job) {
+  const quint64 id = job.id;
+  const bool isPrePack = job.stage == PRE_PACK;
+
+  job.state = RUNNING;
+  job.process = new QProcess(this);
+  job.process->setProgram(isPrePack ? job.prePack.program : job.program);
+  job.process->setArguments(isPrePack ? job.prePack.arguments
+                                      : job.arguments);
+  ProcessPriority::apply(job.process, job.priority);
+  RuntimeProfile::apply(job.process, job.runtime);
+
+  // Pack3r doesn't write to stderr at the moment, but if it ever does,
+  // we want it interleaved with stdout in the order it was written
+  job.process->setProcessChannelMode(QProcess::MergedChannels);
+
+  connect(job.process, &QProcess::started, this, [this, id] {
+    const auto it = jobs.find(id);
+
+    if (it != jobs.end()) {
+      it->pid = it->process->processId();
+    }
+  });
+
+  connect(job.process, &QProcess::readyReadStandardOutput, this, [this, id] {
+    const auto it = jobs.constFind(id);
+
+    if (it != jobs.constEnd()) {
+      emit jobOutput(id, it->process->readAllStandardOutput());
+    }
+  });
+
+  connect(job.process, &QProcess::finished, this,
+          [this, id, isPrePack](const int exitCode,
+                                const QProcess::ExitStatus status) {
+            const int code = status == QProcess::NormalExit ? exitCode : -1;
+
+            if (isPrePack) {
+              finishPrePack(id, code);
+            } else {
+              finishJob(id, code);
+            }
+          });
+
+  // finished() is never emitted if the process could not be started
+  connect(job.process, &QProcess::errorOccurred, this,
+          [this, id, isPrePack](const QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart) {
+              const QString message =
+                  isPrePack ? tr("Failed to start pre-pack command: %1\n")
+                            : tr("Failed to start Pack3r: %1\n");
+              emit jobOutput(
+                  id, message.arg(jobs[id].process->errorString()).toUtf8());
+              finishJob(id, -1);
+            }
+          });
+
+  runningJobs++;
+  memoryTimer->start();
+
+  // the pack stage of a job with a pre-pack command continues the same job
+  if (isPrePack || job.prePack.isEmpty()) {
+    emit jobStarted(id);
+  }
+
+  if (isPrePack) {
+    emit jobOutput(id, tr("Running pre-pack command: %1\n")
+                           .arg(PrePackCommand::toString(job.prePack))
+                           .toUtf8());
+  }
+
+  job.process->start();
+}
+
+// the slot is freed for the pack stage, which is queued first so the map
+// isn't held up by every other map of the batch compiling before it
+void Pack3rJobQueue::finishPrePack(const quint64 id, const int exitCode) {
+  const auto it = jobs.find(id);
+
+  if (it == jobs.end()) {
+    return;
+  }
+
+  if (it->state != RUNNING || exitCode != 0) {
+    if (it->state == RUNNING) {
+      emit jobOutput(id, tr("Pre-pack command failed with exit code %1\n")
+                             .arg(exitCode)
+                             .toUtf8());
+    }
+
+    finishJob(id, exitCode);
+    return;
+  }
+
+  releaseProcess(*it, exitCode);
+  it->stage = PACK;
+  it->state = QUEUED;
+  it->pid = 0;
+  it->rssKb = -1;
+  it->peakMemoryKb = -1;
+  pendingJobs.prepend(id);
+
+  startPendingJobs();
+}
+
+void Pack3rJobQueue::finishJob(const quint64 id, const int exitCode) {
+  const auto it = jobs.find(id);
+
+  if (it == jobs.end()) {
+    return;
+  }
+
+  if (it->process) {
+    releaseProcess(*it, exitCode);
+  }
+
+  const JobState state = it->state == CANCELED ? CANCELED : FINISHED;
+  jobs.erase(it);
+
+  emit jobFinished(id, exitCode, state);
+  startPendingJobs();
+}
+
+// QProcess has already reaped the process by the time it has finished, so
+// its peak can't be read from /proc anymore. The largest peak of all reaped
+// children only grows when a child exceeds every one before it, in which
+// case it's the peak of this one. Otherwise it's still an upper bound, which
+// is used for jobs which finished before their memory was ever sampled.
+// Children reaped by other threads in between can only make it too high
+void Pack3rJobQueue::releaseProcess(Job &job, const int exitCode) {
+  const qint64 previousChildrenPeakKb = childrenPeakKb;
+  childrenPeakKb = SystemMemory::childrenPeakKb();
+
+  // the peak of a canceled job doesn't tell how much a full run needs
+  if (job.state == RUNNING && exitCode == 0) {
+    qint64 peakKb = job.peakMemoryKb;
+
+    if (childrenPeakKb > previousChildrenPeakKb || peakKb < 0) {
+      peakKb = qMax(peakKb, childrenPeakKb);
+    }
+
+    admission.recordPeak(memoryKey(job), peakKb);
+  }
+
+  job.process->disconnect(this);
+  job.process->deleteLater();
+  job.process = nullptr;
+  runningJobs--;
+
+  if (runningJobs == 0) {
+    memoryTimer->stop();
+  }
+}
+
+void Pack3rJobQueue::sampleMemory() {
+  for (auto &job : jobs) {
+    if (job.state != RUNNING) {
+      continue;
+    }
+
+    const auto memory = SystemMemory::process(job.pid);
+    job.rssKb = memory.rssKb;
+    job.peakMemoryKb = qMax(job.peakMemoryKb, memory.peakKb);
+  }
+}
+
+// compiling a map uses a different amount of memory than packing it
+QString Pack3rJobQueue::memoryKey(const Job &job) {
+  return job.stage == PRE_PACK ? "compile:" + job.arguments.value(0)
+                               : job.arguments.value(0);
+}
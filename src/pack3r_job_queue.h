@@ -0,0 +1,135 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "memory_admission.h"
+#include "pre_pack_command.h"
+#include "process_priority.h"
+#include "runtime_profile.h"
+
+#include <QHash>
+#include <QObject>
+#include <QProcess>
+#include <QQueue>
+#include <QTimer>
+
+// Runs Pack3r jobs with a bounded number of concurrent processes.
+// Jobs over the limit wait in FIFO order until a running job finishes.
+// A job is also held back while it doesn't fit in the available memory,
+// see MemoryAdmission.
+//
+// Jobs with a pre-pack command run it in a slot of their own first. Once it
+// succeeds, the pack stage is queued ahead of jobs which haven't started, so
+// maps are packed while the next ones are still compiling.
+class Pack3rJobQueue : public QObject {
+  Q_OBJECT
+
+public:
+  enum JobState {
+    QUEUED,
+    RUNNING,
+    FINISHED,
+    CANCELED,
+  };
+
+  enum Stage {
+    PRE_PACK,
+    PACK,
+  };
+
+  struct Job {
+    quint64 id{};
+    QString program;
+    QStringList arguments;
+    QString outputFile;
+    ProcessPriority::Profile priority;
+    RuntimeProfile::Profile runtime;
+    PrePackCommand::Command prePack;
+
+    JobState state{};
+    Stage stage{};
+    int exitCode{};
+    QProcess *process{};
+    // processId() is 0 again once the process has finished
+    qint64 pid{};
+
+    qint64 rssKb{-1};
+    qint64 peakMemoryKb{-1};
+  };
+
+  Pack3rJobQueue(QObject *parent, int maxConcurrentJobs);
+
+  quint64 enqueue(const QString &program, const QStringList &arguments,
+                  const QString &outputFile,
+                  const ProcessPriority::Profile &priority = {},
+                  const RuntimeProfile::Profile &runtime = {},
+                  const PrePackCommand::Command &prePack = {});
+  void cancel(quint64 id);
+  void write(quint64 id, const QByteArray &data);
+
+  // returns the id of a queued or running job with an identical command
+  // and pre-pack command, or 0 if there is none
+  quint64 findActiveJob(const QString &program, const QStringList &arguments,
+                        const PrePackCommand::Command &prePack) const;
+  bool isActive(quint64 id) const;
+  QList<Job> activeJobs() const;
+
+  int maxConcurrentJobs() const;
+  void setMaxConcurrentJobs(int count);
+
+signals:
+  void jobQueued(quint64 id);
+  void jobStarted(quint64 id);
+  void jobOutput(quint64 id, const QByteArray &data);
+  void jobFinished(quint64 id, int exitCode, Pack3rJobQueue::JobState state);
+
+  // emitted when a job which could otherwise start is first held back
+  void admissionHeld(const QString &reason);
+
+private:
+  void startPendingJobs();
+  void startJob(Job &job);
+  void finishPrePack(quint64 id, int exitCode);
+  void finishJob(quint64 id, int exitCode);
+  void releaseProcess(Job &job, int exitCode);
+  void sampleMemory();
+
+  // jobs of the same map use about the same amount of memory
+  static QString memoryKey(const Job &job);
+
+  QHash<quint64, Job> jobs;
+  QQueue<quint64> pendingJobs;
+
+  MemoryAdmission admission;
+  QTimer *memoryTimer;
+  bool admissionHeldBack{};
+
+  // see releaseProcess()
+  qint64 childrenPeakKb{-1};
+
+  quint64 nextJobId = 1;
+  int runningJobs{};
+  int maxJobs;
+};
@@ -0,0 +1,191 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pack3r_log_store.h"
+#include "reference_graph.h"
+
+namespace {
+constexpr qsizetype CHUNK_SIZE = 256 * 1024;
+
+// -sd and -rd print at the debug level in the shapes the reference graph
+// parses, lines at other levels which mention shaders or references aren't
+// debug output. Returns NUM_FILTERS for anything else
+Pack3rLogStore::Filter debugFilter(const Pack3rOutputParser::LogLevel level,
+                                   const QByteArrayView line) {
+  ReferenceGraph::Reference reference{};
+
+  if (level < Pack3rOutputParser::LOG_DEBUG ||
+      !ReferenceGraph::parseLine(line, reference)) {
+    return Pack3rLogStore::NUM_FILTERS;
+  }
+
+  return ReferenceGraph::isShaderReference(reference)
+             ? Pack3rLogStore::FILTER_SHADER_DEBUG
+             : Pack3rLogStore::FILTER_REFERENCE_DEBUG;
+}
+} // namespace
+
+bool Pack3rLogStore::append(const QByteArrayView line, const quint16 source) {
+  auto &currentLevel = currentLevels[source];
+  const auto tagged = Pack3rOutputParser::logLevel(line);
+
+  if (tagged != Pack3rOutputParser::LOG_NONE) {
+    currentLevel = tagged;
+  }
+
+  return add(line, currentLevel, source, debugFilter(currentLevel, line));
+}
+
+bool Pack3rLogStore::append(const QByteArrayView line,
+                            const Pack3rOutputParser::LogLevel level,
+                            const quint16 source) {
+  return add(line, level, source, NUM_FILTERS);
+}
+
+quint16 Pack3rLogStore::source(const QString &label) {
+  const qsizetype existing = labels.indexOf(label);
+
+  if (existing >= 0) {
+    return static_cast<quint16>(existing);
+  }
+
+  labels.append(label);
+  currentLevels.append(Pack3rOutputParser::LOG_INFO);
+  return static_cast<quint16>(labels.size() - 1);
+}
+
+// 'debug' is the debug filter the line also belongs to, if any
+bool Pack3rLogStore::add(const QByteArrayView line,
+                         const Pack3rOutputParser::LogLevel level,
+                         const quint16 source, const Filter debug) {
+  const auto index = static_cast<quint32>(lines.size());
+  const qsizetype capacity = lines.capacity();
+  LineRef ref{};
+  ref.source = source;
+  ref.level = static_cast<quint8>(level);
+  store(line, ref);
+  lines.append(ref);
+
+  if (lines.capacity() != capacity) {
+    allocations++;
+  }
+
+  // labels are shown as a "[label] " prefix
+  const qsizetype length =
+      source == 0 ? line.size() : line.size() + labels[source].size() + 3;
+
+  // level filters are in the same order as log levels, offset by LOG_NONE
+  for (int i = FILTER_FATAL; i <= FILTER_TRACE; i++) {
+    if (level <= i + 1) {
+      filteredViews[i].append(index);
+      longestLines[i] = qMax(longestLines[i], length);
+    }
+  }
+
+  if (debug != NUM_FILTERS) {
+    filteredViews[debug].append(index);
+    longestLines[debug] = qMax(longestLines[debug], length);
+  }
+
+  return !filteredViews[activeFilter].isEmpty() &&
+         filteredViews[activeFilter].last() == index;
+}
+
+// copies the line into the current chunk, moving on to the next one once it's
+// full. Chunks are never reallocated, so views into them stay valid
+void Pack3rLogStore::store(const QByteArrayView line, LineRef &ref) {
+  while (currentChunk < chunks.size() &&
+         chunks[currentChunk].capacity() - chunks[currentChunk].size() <
+             line.size()) {
+    currentChunk++;
+  }
+
+  if (currentChunk == chunks.size()) {
+    // overlong lines get a chunk of their own
+    QByteArray chunk{};
+    chunk.reserve(qMax(CHUNK_SIZE, line.size()));
+    chunks.append(std::move(chunk));
+    allocations++;
+  }
+
+  QByteArray &chunk = chunks[currentChunk];
+  ref.chunk = static_cast<quint32>(currentChunk);
+  ref.offset = static_cast<quint32>(chunk.size());
+  ref.length = static_cast<quint32>(line.size());
+  chunk.append(line);
+}
+
+void Pack3rLogStore::clear() {
+  lines.clear();
+
+  // the chunks are reused, but only as many as a typical run needs
+  chunks.resize(qMin<qsizetype>(chunks.size(), 4));
+
+  for (auto &chunk : chunks) {
+    chunk.truncate(0);
+  }
+
+  currentChunk = 0;
+  allocations = 0;
+
+  for (auto &view : filteredViews) {
+    view.clear();
+  }
+
+  longestLines.fill(0);
+
+  // labels are kept, batch jobs may still be running
+  currentLevels.fill(Pack3rOutputParser::LOG_INFO);
+}
+
+Pack3rLogStore::Filter Pack3rLogStore::filter() const { return activeFilter; }
+
+void Pack3rLogStore::setFilter(const Filter newFilter) {
+  activeFilter = newFilter;
+}
+
+const QList<quint32> &Pack3rLogStore::filteredLines() const {
+  return filteredViews[activeFilter];
+}
+
+qsizetype Pack3rLogStore::longestFilteredLine() const {
+  return longestLines[activeFilter];
+}
+
+QByteArrayView Pack3rLogStore::line(const quint32 index) const {
+  const LineRef &ref = lines[index];
+  return {chunks[ref.chunk].constData() + ref.offset, ref.length};
+}
+
+Pack3rOutputParser::LogLevel Pack3rLogStore::level(const quint32 index) const {
+  return static_cast<Pack3rOutputParser::LogLevel>(lines[index].level);
+}
+
+const QString &Pack3rLogStore::label(const quint32 index) const {
+  return labels[lines[index].source];
+}
+
+qsizetype Pack3rLogStore::lineCount() const { return lines.size(); }
+
+quint64 Pack3rLogStore::allocationCount() const { return allocations; }
@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "pack3r_output_parser.h"
+
+#include <QList>
+#include <array>
+
+/* Stores every line of Pack3r output along with its log level, so the output
+ * can be filtered after the fact instead of re-running Pack3r with a different
+ * verbosity level.
+ *
+ * Each filter keeps its own list of matching lines which is updated as lines
+ * are appended, so switching between filters doesn't need to re-classify
+ * any of the stored lines.
+ *
+ * Line text is packed into large fixed-capacity chunks instead of a
+ * QByteArray per line, so appending a line is a copy into the current chunk
+ * and only allocates when a chunk fills up. Chunks are kept for reuse when
+ * the store is cleared.
+ *
+ * Lines of batch jobs belong to a source labeled with the job, which is
+ * kept next to the line instead of being part of it. Sources keep their own
+ * current level, so interleaved output of jobs doesn't mix up their levels.
+ */
+class Pack3rLogStore {
+public:
+  enum Filter {
+    FILTER_FATAL,
+    FILTER_ERROR,
+    FILTER_WARN,
+    FILTER_INFO,
+    FILTER_DEBUG,
+    FILTER_TRACE,
+    FILTER_SHADER_DEBUG,
+    FILTER_REFERENCE_DEBUG,
+
+    NUM_FILTERS // endcap
+  };
+
+  // returns true if the line passes the current filter
+  bool append(QByteArrayView line, quint16 source = 0);
+  // lines of QtPack3r itself, which have a level of their own instead of
+  // continuing the level of the Pack3r output before them
+  bool append(QByteArrayView line, Pack3rOutputParser::LogLevel level,
+              quint16 source = 0);
+  void clear();
+
+  // source of the lines labeled 'label', added if there isn't one yet.
+  // Source 0 is the unlabeled output of the interactive run
+  quint16 source(const QString &label);
+
+  Filter filter() const;
+  void setFilter(Filter newFilter);
+
+  // indices of the lines passing the current filter
+  const QList<quint32> &filteredLines() const;
+  // length in bytes of the longest line passing the current filter
+  qsizetype longestFilteredLine() const;
+  // the view stays valid until the store is cleared
+  QByteArrayView line(quint32 index) const;
+  Pack3rOutputParser::LogLevel level(quint32 index) const;
+  // empty for lines of the interactive run
+  const QString &label(quint32 index) const;
+  qsizetype lineCount() const;
+
+  quint64 allocationCount() const;
+
+private:
+  struct LineRef {
+    quint32 chunk{};
+    quint32 offset{};
+    quint32 length{};
+    quint16 source{};
+    quint8 level{};
+  };
+
+  bool add(QByteArrayView line, Pack3rOutputParser::LogLevel level,
+           quint16 source, Filter debug);
+  void store(QByteArrayView line, LineRef &ref);
+
+  QList<QByteArray> chunks;
+  qsizetype currentChunk{};
+  QList<LineRef> lines;
+  quint64 allocations{};
+  std::array<QList<quint32>, NUM_FILTERS> filteredViews{};
+  std::array<qsizetype, NUM_FILTERS> longestLines{};
+
+  QStringList labels{QString()};
+
+  // lines without a severity tag are continuations of the previous line of
+  // their source, anything printed before the first tag is considered info
+  QList<Pack3rOutputParser::LogLevel> currentLevels{
+      Pack3rOutputParser::LOG_INFO};
+  Filter activeFilter = FILTER_TRACE;
+};
@@ -0,0 +1,348 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pack3r_output_field.h"
+#include "run_trace.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QKeyEvent>
+#include <QMenu>
+#include <QPainter>
+#include <QScrollBar>
+#include <algorithm>
+
+namespace {
+constexpr int MARGIN = 4;
+}
+
+Pack3rOutputField::Pack3rOutputField(const Pack3rLogStore &logStore,
+                                     QWidget *parent)
+    : QAbstractScrollArea(parent), store(logStore), highlighter(palette()) {
+  setFocusPolicy(Qt::StrongFocus);
+  viewport()->setCursor(Qt::IBeamCursor);
+  verticalScrollBar()->setSingleStep(1);
+  updateScrollBars();
+}
+
+void Pack3rOutputField::linesAppended() {
+  const QScrollBar *scrollBar = verticalScrollBar();
+  const bool following = scrollBar->value() == scrollBar->maximum();
+
+  updateScrollBars();
+
+  if (following) {
+    verticalScrollBar()->setValue(scrollBar->maximum());
+  }
+
+  viewport()->update();
+}
+
+void Pack3rOutputField::reset() {
+  selectionAnchor = -1;
+  selectionEnd = -1;
+
+  updateScrollBars();
+  verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+  horizontalScrollBar()->setValue(0);
+  viewport()->update();
+}
+
+void Pack3rOutputField::setWrapping(const bool wrap) {
+  wrapping = wrap;
+  updateScrollBars();
+  viewport()->update();
+}
+
+void Pack3rOutputField::setHighlighting(const bool highlight) {
+  highlighting = highlight;
+  viewport()->update();
+}
+
+QString Pack3rOutputField::text() const {
+  const auto &rows = store.filteredLines();
+  qsizetype first = 0;
+  qsizetype last = rows.size() - 1;
+
+  if (selectionAnchor >= 0) {
+    first = std::min(selectionAnchor, selectionEnd);
+    last = std::max(selectionAnchor, selectionEnd);
+  }
+
+  QStringList lines{};
+  lines.reserve(last - first + 1);
+
+  for (qsizetype row = first; row <= last; row++) {
+    lines.append(rowText(rows[row]));
+  }
+
+  return lines.join('\n');
+}
+
+quint64 Pack3rOutputField::allocationCount() const { return allocations; }
+
+void Pack3rOutputField::resetAllocationCount() { allocations = 0; }
+
+void Pack3rOutputField::paintEvent(QPaintEvent *event) {
+  Q_UNUSED(event);
+  const RunTrace::Scope traceScope("paint");
+
+  QPainter painter(viewport());
+  visibleRows.clear();
+
+  const auto &rows = store.filteredLines();
+
+  if (rows.isEmpty()) {
+    return;
+  }
+
+  const int width = viewport()->width() - 2 * MARGIN;
+  const int available = viewport()->height() - 2 * MARGIN;
+  const QScrollBar *scrollBar = verticalScrollBar();
+  const bool following = scrollBar->value() == scrollBar->maximum();
+
+  // lay out just enough rows to fill the view, working backwards from the
+  // last row while following, so the end of the output is always visible
+  std::vector<std::pair<qsizetype, std::unique_ptr<QTextLayout>>> layouts{};
+  int height = 0;
+
+  if (following) {
+    for (qsizetype row = rows.size() - 1; row >= 0 && height < available;
+         row--) {
+      auto layout = layoutRow(row, width);
+      height += static_cast<int>(layout->boundingRect().height());
+      layouts.emplace_back(row, std::move(layout));
+    }
+
+    std::reverse(layouts.begin(), layouts.end());
+  } else {
+    for (qsizetype row = scrollBar->value();
+         row < rows.size() && height < available; row++) {
+      auto layout = layoutRow(row, width);
+      height += static_cast<int>(layout->boundingRect().height());
+      layouts.emplace_back(row, std::move(layout));
+    }
+  }
+
+  const qsizetype selectionFirst = std::min(selectionAnchor, selectionEnd);
+  const qsizetype selectionLast = std::max(selectionAnchor, selectionEnd);
+  const int x = MARGIN - horizontalScrollBar()->value();
+  int top = following && height > available ? MARGIN + available - height
+                                            : MARGIN;
+
+  for (const auto &[row, layout] : layouts) {
+    const int bottom = top + static_cast<int>(layout->boundingRect().height());
+    const bool selected = row >= selectionFirst && row <= selectionLast;
+
+    if (selected) {
+      painter.fillRect(0, top, viewport()->width(), bottom - top,
+                       palette().highlight());
+    }
+
+    painter.setPen(selected ? palette().highlightedText().color()
+                            : palette().text().color());
+    layout->draw(&painter, QPointF(x, top));
+
+    visibleRows.append({row, top, bottom});
+    top = bottom;
+  }
+}
+
+void Pack3rOutputField::resizeEvent(QResizeEvent *event) {
+  QAbstractScrollArea::resizeEvent(event);
+  updateScrollBars();
+}
+
+void Pack3rOutputField::changeEvent(QEvent *event) {
+  QAbstractScrollArea::changeEvent(event);
+
+  switch (event->type()) {
+  case QEvent::FontChange:
+    updateScrollBars();
+    viewport()->update();
+    break;
+  case QEvent::PaletteChange:
+    highlighter = Pack3rOutputHighlighter(palette());
+    viewport()->update();
+    break;
+  default:
+    break;
+  }
+}
+
+void Pack3rOutputField::keyPressEvent(QKeyEvent *event) {
+  if (event == QKeySequence::Copy) {
+    copy();
+  } else if (event == QKeySequence::SelectAll) {
+    selectAll();
+  } else {
+    QAbstractScrollArea::keyPressEvent(event);
+  }
+}
+
+void Pack3rOutputField::mousePressEvent(QMouseEvent *event) {
+  if (event->button() != Qt::LeftButton) {
+    QAbstractScrollArea::mousePressEvent(event);
+    return;
+  }
+
+  const qsizetype row = rowAt(event->position().toPoint().y());
+
+  if (row < 0) {
+    selectionAnchor = -1;
+    selectionEnd = -1;
+  } else {
+    if (selectionAnchor < 0 || !(event->modifiers() & Qt::ShiftModifier)) {
+      selectionAnchor = row;
+    }
+
+    selectionEnd = row;
+  }
+
+  viewport()->update();
+}
+
+void Pack3rOutputField::mouseMoveEvent(QMouseEvent *event) {
+  const qsizetype row = rowAt(event->position().toPoint().y());
+
+  if (!(event->buttons() & Qt::LeftButton) || selectionAnchor < 0 || row < 0) {
+    QAbstractScrollArea::mouseMoveEvent(event);
+    return;
+  }
+
+  selectionEnd = row;
+  viewport()->update();
+}
+
+void Pack3rOutputField::contextMenuEvent(QContextMenuEvent *event) {
+  QMenu menu(this);
+
+  QAction *copyAction = menu.addAction(tr("&Copy"));
+  copyAction->setShortcut(QKeySequence::Copy);
+  copyAction->setEnabled(selectionAnchor >= 0);
+  connect(copyAction, &QAction::triggered, this, &Pack3rOutputField::copy);
+
+  QAction *selectAllAction = menu.addAction(tr("Select All"));
+  selectAllAction->setShortcut(QKeySequence::SelectAll);
+  selectAllAction->setEnabled(!store.filteredLines().isEmpty());
+  connect(selectAllAction, &QAction::triggered, this,
+          &Pack3rOutputField::selectAll);
+
+  menu.exec(event->globalPos());
+}
+
+// the decoded text, the layout and the formats of a row are counted as
+// allocations, the allocations QTextLayout makes internally are not
+std::unique_ptr<QTextLayout>
+Pack3rOutputField::layoutRow(const qsizetype row, const int width) {
+  const quint32 index = store.filteredLines()[row];
+  const QString text = rowText(index);
+
+  auto layout = std::make_unique<QTextLayout>(text, font());
+  allocations += 2;
+
+  QTextOption option{};
+  option.setWrapMode(wrapping ? QTextOption::WrapAtWordBoundaryOrAnywhere
+                              : QTextOption::NoWrap);
+  layout->setTextOption(option);
+
+  if (highlighting) {
+    layout->setFormats(highlighter.formats(text, store.level(index)));
+    allocations++;
+  }
+
+  layout->beginLayout();
+  qreal y = 0;
+
+  for (QTextLine line = layout->createLine(); line.isValid();
+       line = layout->createLine()) {
+    line.setLineWidth(width);
+    line.setPosition(QPointF(0, y));
+    y += line.height();
+  }
+
+  layout->endLayout();
+  return layout;
+}
+
+// lines of batch jobs are shown with the label of their job
+QString Pack3rOutputField::rowText(const quint32 index) const {
+  const QString &label = store.label(index);
+  const QString line = QString::fromUtf8(store.line(index));
+
+  return label.isEmpty() ? line : QString("[%1] %2").arg(label, line);
+}
+
+// rows above or below the visible rows map to the nearest visible row
+qsizetype Pack3rOutputField::rowAt(const int y) const {
+  if (visibleRows.isEmpty()) {
+    return -1;
+  }
+
+  for (const auto &visibleRow : visibleRows) {
+    if (y < visibleRow.bottom) {
+      return visibleRow.row;
+    }
+  }
+
+  return visibleRows.last().row;
+}
+
+void Pack3rOutputField::updateScrollBars() {
+  const int lineHeight = fontMetrics().height();
+  const int pageRows =
+      std::max(1, (viewport()->height() - 2 * MARGIN) / lineHeight);
+  const auto rows = static_cast<int>(store.filteredLines().size());
+
+  verticalScrollBar()->setPageStep(pageRows);
+  verticalScrollBar()->setRange(0, std::max(0, rows - pageRows));
+
+  // lines are measured in bytes, which can only overestimate their width
+  const int charWidth = fontMetrics().horizontalAdvance(QLatin1Char('M'));
+  const int contentWidth =
+      wrapping ? 0
+               : static_cast<int>(store.longestFilteredLine()) * charWidth +
+                     2 * MARGIN;
+
+  horizontalScrollBar()->setSingleStep(charWidth);
+  horizontalScrollBar()->setPageStep(viewport()->width());
+  horizontalScrollBar()->setRange(
+      0, std::max(0, contentWidth - viewport()->width()));
+}
+
+void Pack3rOutputField::copy() const {
+  if (selectionAnchor >= 0) {
+    QApplication::clipboard()->setText(text());
+  }
+}
+
+void Pack3rOutputField::selectAll() {
+  const auto rows = store.filteredLines().size();
+
+  if (rows > 0) {
+    selectionAnchor = 0;
+    selectionEnd = rows - 1;
+    viewport()->update();
+  }
+}
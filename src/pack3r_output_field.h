@@ -0,0 +1,98 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "pack3r_log_store.h"
+#include "pack3r_output_highlighter.h"
+
+#include <QAbstractScrollArea>
+#include <memory>
+
+/* Displays the lines passing the current filter of a log store.
+ *
+ * Only the lines on screen are decoded and laid out, each time they're
+ * painted, so appending output or switching filters costs the same no matter
+ * how much output is stored. The vertical scroll bar scrolls by whole lines.
+ * While it's at the end, the view follows appended output and the last line
+ * is kept at the bottom of the view, even if lines are wrapped.
+ *
+ * Selection is by whole lines, which is what's copied out of the output.
+ */
+class Pack3rOutputField : public QAbstractScrollArea {
+  Q_OBJECT
+
+public:
+  explicit Pack3rOutputField(const Pack3rLogStore &logStore,
+                             QWidget *parent = nullptr);
+
+  // call after appending lines which pass the current filter
+  void linesAppended();
+  // call after the store is cleared or its filter changes
+  void reset();
+
+  void setWrapping(bool wrap);
+  void setHighlighting(bool highlight);
+
+  // the selected lines, or every line if nothing is selected
+  QString text() const;
+
+  // allocations made to display lines since the last reset of the count
+  quint64 allocationCount() const;
+  void resetAllocationCount();
+
+protected:
+  void paintEvent(QPaintEvent *event) override;
+  void resizeEvent(QResizeEvent *event) override;
+  void changeEvent(QEvent *event) override;
+  void keyPressEvent(QKeyEvent *event) override;
+  void mousePressEvent(QMouseEvent *event) override;
+  void mouseMoveEvent(QMouseEvent *event) override;
+  void contextMenuEvent(QContextMenuEvent *event) override;
+
+private:
+  struct VisibleRow {
+    qsizetype row{};
+    int top{};
+    int bottom{};
+  };
+
+  QString rowText(quint32 index) const;
+  std::unique_ptr<QTextLayout> layoutRow(qsizetype row, int width);
+  qsizetype rowAt(int y) const;
+  void updateScrollBars();
+  void copy() const;
+  void selectAll();
+
+  const Pack3rLogStore &store;
+  Pack3rOutputHighlighter highlighter;
+  bool wrapping{};
+  bool highlighting = true;
+  quint64 allocations{};
+
+  // rows are positions in the filtered lines of the store
+  qsizetype selectionAnchor = -1;
+  qsizetype selectionEnd = -1;
+  QList<VisibleRow> visibleRows;
+};
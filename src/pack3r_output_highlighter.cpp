@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "pack3r_output_highlighter.h"
+
+Pack3rOutputHighlighter::Pack3rOutputHighlighter(const QPalette &palette) {
+  const QColor errorColor(220, 50, 47);
+  const QColor warnColor(203, 130, 0);
+  const QColor assetColor(38, 139, 210);
+  const QColor dimColor = palette.color(QPalette::PlaceholderText);
+
+  QTextCharFormat error{};
+  error.setForeground(errorColor);
+
+  QTextCharFormat warn{};
+  warn.setForeground(warnColor);
+
+  QTextCharFormat dim{};
+  dim.setForeground(dimColor);
+
+  levelFormats = {
+      {Pack3rOutputParser::LOG_FATAL, error},
+      {Pack3rOutputParser::LOG_ERROR, error},
+      {Pack3rOutputParser::LOG_WARN, warn},
+      {Pack3rOutputParser::LOG_DEBUG, dim},
+      {Pack3rOutputParser::LOG_TRACE, dim},
+  };
+
+  QTextCharFormat missing = error;
+  missing.setUnderlineStyle(QTextCharFormat::SingleUnderline);
+
+  QTextCharFormat asset{};
+  asset.setForeground(assetColor);
+
+  rules = {
+      {QRegularExpression(
+           R"(\b(missing|not found|(could not|unable to|failed to) )"
+           R"((find|resolve|load))\b)",
+           QRegularExpression::CaseInsensitiveOption),
+       missing, true},
+      {QRegularExpression(
+           R"([\w\-.]+(/[\w\-.]+)*\.(tga|jpe?g|png|dds|md3|mdc|ase|obj|)"
+           R"(skin|shader|wav|ogg|roq|bsp|map|reg|arena|script|cfg|pk3)\b)",
+           QRegularExpression::CaseInsensitiveOption),
+       asset, false},
+  };
+
+  for (auto &rule : rules) {
+    rule.pattern.optimize();
+  }
+}
+
+// later formats take precedence over earlier ones
+QList<QTextLayout::FormatRange> Pack3rOutputHighlighter::formats(
+    const QString &text, const Pack3rOutputParser::LogLevel level) const {
+  const int length = static_cast<int>(text.length());
+  QList<QTextLayout::FormatRange> result{};
+
+  const auto levelFormat = levelFormats.constFind(level);
+
+  if (levelFormat != levelFormats.cend()) {
+    result.append({0, length, *levelFormat});
+  }
+
+  for (const auto &rule : rules) {
+    if (rule.wholeLine) {
+      if (rule.pattern.match(text).hasMatch()) {
+        result.append({0, length, rule.format});
+      }
+
+      continue;
+    }
+
+    auto it = rule.pattern.globalMatch(text);
+
+    while (it.hasNext()) {
+      const auto match = it.next();
+      result.append({static_cast<int>(match.capturedStart()),
+                     static_cast<int>(match.capturedLength()), rule.format});
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,57 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "pack3r_output_parser.h"
+
+#include <QPalette>
+#include <QRegularExpression>
+#include <QTextLayout>
+
+/* Highlights log levels, missing assets and asset paths in the output field.
+ *
+ * The output field only lays out the lines on screen, so only those are
+ * highlighted, each time they're painted. Rules are compiled once, and only
+ * use formats which don't affect the metrics of the text, so highlighting
+ * never changes the layout of the output.
+ */
+class Pack3rOutputHighlighter {
+public:
+  explicit Pack3rOutputHighlighter(const QPalette &palette);
+
+  QList<QTextLayout::FormatRange>
+  formats(const QString &text, Pack3rOutputParser::LogLevel level) const;
+
+private:
+  struct Rule {
+    QRegularExpression pattern;
+    QTextCharFormat format;
+    bool wholeLine{};
+  };
+
+  QHash<Pack3rOutputParser::LogLevel, QTextCharFormat> levelFormats;
+  QList<Rule> rules;
+};
@@ -23,6 +23,9 @@
  */
 
 #include "pack3r_output_parser.h"
+#include "run_trace.h"
+
+#include <algorithm>
 
 Pack3rOutputParser::Pack3rOutputParser(QObject *parent)
     : QObject(parent), cursorPos(0) {}
@@ -40,35 +43,86 @@ Pack3rOutputParser::Pack3rOutputParser(QObject *parent)
  * line into multiple outputs, so we can't simply append a newline
  * after each chunk of output we receive.
  *
+ * Complete lines without carriage returns are emitted as views into 'data'
+ * without copying them, only partial lines and lines which are overwritten
+ * go through the line buffer. The buffer keeps its capacity between lines,
+ * so it only allocates when a line is longer than any before it.
+ *
  * TODO: because we hold each line here until a newline character is sent,
  *  we do net get an actual "live" output with the progress indicators that
  *  Pack3r tries to output. This would require interacting directly with
  *  the text field, which is a bit complicated. Revisit this in the future.
  */
-void Pack3rOutputParser::processOutput(const QByteArray &data) {
-  for (const auto &c : data) {
-    if (c == '\r') {
-      cursorPos = 0;
-      continue;
-    }
+void Pack3rOutputParser::processOutput(QByteArrayView data) {
+  const RunTrace::Scope scope("parse");
+
+  bytes += data.size();
+
+  while (!data.isEmpty()) {
+    const auto end = std::find_if(data.begin(), data.end(), [](const char c) {
+      return c == '\r' || c == '\n';
+    });
+    const auto length = static_cast<qsizetype>(end - data.begin());
+    const QByteArrayView segment = data.first(length);
 
-    if (c == '\n') {
-      emit pack3rOutputProcessed(currentLine);
-      currentLine.clear();
-      cursorPos = 0;
-      continue;
+    if (end == data.end()) {
+      writeSegment(segment);
+      break;
     }
 
-    if (cursorPos >= currentLine.length()) {
-      currentLine += c;
+    if (*end == '\n') {
+      if (currentLine.isEmpty()) {
+        emit pack3rOutputProcessed(segment);
+      } else {
+        writeSegment(segment);
+        emit pack3rOutputProcessed(currentLine);
+        currentLine.truncate(0);
+      }
     } else {
-      currentLine[cursorPos] = c;
+      writeSegment(segment);
     }
 
-    cursorPos++;
+    cursorPos = 0;
+    data = data.sliced(length + 1);
+  }
+}
+
+// writes over the line buffer from the cursor position like a terminal would,
+// extending the line if the segment goes past its end
+void Pack3rOutputParser::writeSegment(const QByteArrayView segment) {
+  const qsizetype overlap =
+      qMin(segment.size(), currentLine.size() - cursorPos);
+  const qsizetype capacity = currentLine.capacity();
+
+  std::copy_n(segment.data(), overlap, currentLine.data() + cursorPos);
+  currentLine.append(segment.sliced(overlap));
+  cursorPos += segment.size();
+
+  if (currentLine.capacity() != capacity) {
+    allocations++;
   }
 }
 
+// emits the line currently being processed even if it has no newline yet,
+// used when the process exits without terminating its last line
+void Pack3rOutputParser::flush() {
+  if (!currentLine.isEmpty()) {
+    emit pack3rOutputProcessed(currentLine);
+    currentLine.truncate(0);
+  }
+
+  cursorPos = 0;
+}
+
+quint64 Pack3rOutputParser::allocationCount() const { return allocations; }
+
+quint64 Pack3rOutputParser::bytesProcessed() const { return bytes; }
+
+void Pack3rOutputParser::resetStats() {
+  allocations = 0;
+  bytes = 0;
+}
+
 void Pack3rOutputParser::processVersion(const QByteArray &data) {
   // there's seemingly an empty string sent at the end of --version command,
   // ignore that so we don't overwrite the version with an empty string
@@ -81,3 +135,52 @@ void Pack3rOutputParser::processVersion(const QByteArray &data) {
   // the entire string is included
   emit pack3rVersionParsed(data.mid(0, data.indexOf("+")));
 }
+
+/* Severity is read from the first word of the line, which may be wrapped in
+ * brackets and/or followed by a colon, e.g. '[WRN] ...', 'error: ...'.
+ * This is called for every line of output, so avoid regular expressions
+ * and allocations here.
+ */
+Pack3rOutputParser::LogLevel
+Pack3rOutputParser::logLevel(const QByteArrayView line) {
+  static const QList<QPair<QByteArrayView, LogLevel>> tags = {
+      {"fatal", LOG_FATAL}, {"ftl", LOG_FATAL},   {"crit", LOG_FATAL},
+      {"error", LOG_ERROR}, {"err", LOG_ERROR},   {"warning", LOG_WARN},
+      {"warn", LOG_WARN},   {"wrn", LOG_WARN},    {"info", LOG_INFO},
+      {"inf", LOG_INFO},    {"debug", LOG_DEBUG}, {"dbg", LOG_DEBUG},
+      {"trace", LOG_TRACE}, {"trc", LOG_TRACE},   {"verbose", LOG_TRACE},
+  };
+
+  qsizetype i = 0;
+
+  while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) {
+    i++;
+  }
+
+  if (i < line.size() && line[i] == '[') {
+    i++;
+  }
+
+  const qsizetype start = i;
+
+  while (i < line.size() && ((line[i] >= 'a' && line[i] <= 'z') ||
+                              (line[i] >= 'A' && line[i] <= 'Z'))) {
+    i++;
+  }
+
+  // the word must be followed by a separator, so 'errors' won't match 'error'
+  if (i == start || (i < line.size() && line[i] != ']' && line[i] != ':' &&
+                     line[i] != ' ')) {
+    return LOG_NONE;
+  }
+
+  const QByteArrayView word = line.sliced(start, i - start);
+
+  for (const auto &[tag, level] : tags) {
+    if (word.compare(tag, Qt::CaseInsensitive) == 0) {
+      return level;
+    }
+  }
+
+  return LOG_NONE;
+}
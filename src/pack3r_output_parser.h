@@ -24,22 +24,51 @@
 
 #pragma once
 
+#include <QByteArrayView>
 #include <QObject>
 
 class Pack3rOutputParser : public QObject {
   Q_OBJECT
 
 public:
+  // same order as Pack3rs verbosity levels, from least to most verbose
+  enum LogLevel {
+    LOG_NONE, // line has no severity tag
+    LOG_FATAL,
+    LOG_ERROR,
+    LOG_WARN,
+    LOG_INFO,
+    LOG_DEBUG,
+    LOG_TRACE,
+  };
+
   explicit Pack3rOutputParser(QObject *parent);
 
-  void processOutput(const QByteArray &data);
+  void processOutput(QByteArrayView data);
   void processVersion(const QByteArray &data);
+  void flush();
+
+  // number of times the line buffer had to grow, per bytes processed
+  quint64 allocationCount() const;
+  quint64 bytesProcessed() const;
+  void resetStats();
+
+  static LogLevel logLevel(QByteArrayView line);
 
 signals:
-  void pack3rOutputProcessed(const QByteArray &data);
+  // 'line' points either into the data passed to processOutput() or into
+  // the parsers own line buffer, and is only valid during the emission,
+  // so this must only be connected with direct connections.
+  // Receivers which need to keep the line must copy it.
+  void pack3rOutputProcessed(QByteArrayView line);
   void pack3rVersionParsed(const QString &version);
 
 private:
+  void writeSegment(QByteArrayView segment);
+
   QByteArray currentLine;
   qsizetype cursorPos;
+
+  quint64 allocations{};
+  quint64 bytes{};
 };
@@ -24,65 +24,239 @@
 
 #include "pack3r_process_handler.h"
 #include "dialog.h"
+#include "preferences.h"
+#include "run_trace.h"
 
-#include <QSaveFile>
+Pack3rProcessHandler::Pack3rProcessHandler(QObject *parent)
+    : QObject(parent), workerThread(new QThread(this)),
+      worker(new Pack3rProcessWorker()),
+      daemonClient(new Pack3rDaemonClient(this)) {
+  workerThread->setObjectName("Output worker");
+  worker->moveToThread(workerThread);
+  connect(workerThread, &QThread::finished, worker, &QObject::deleteLater);
+  workerThread->start();
 
-Pack3rProcessHandler::Pack3rProcessHandler(
-    QObject *parent, const QPointer<Pack3rOutputParser> &outputParser)
-    : QObject(parent), process(new QProcess(this)), parser(outputParser) {}
+  setupWorkerConnections();
+  setupDaemonConnections();
+}
 
-void Pack3rProcessHandler::spawnProcess(
-    const QPair<QString, QStringList> &command, const QString &outputFile) {
-  process->setProgram(command.first);
-  process->setArguments(command.second);
+Pack3rProcessHandler::~Pack3rProcessHandler() {
+  workerThread->quit();
+  workerThread->wait();
+}
+
+bool Pack3rProcessHandler::isRunning() const {
+  return daemonJobRunning || processRunning;
+}
+
+quint64 Pack3rProcessHandler::outputBytes() const { return bytesProcessed; }
 
+quint64 Pack3rProcessHandler::parserAllocations() const {
+  return allocationCount;
+}
+
+void Pack3rProcessHandler::spawnProcess(
+    const QPair<QString, QStringList> &command, const QString &outputFile,
+    const PrePackCommand::Command &prePack) {
   // TODO: should probably refactor this function to take some sort of
   //  'type' argument on what workload we're running, this is kinda ugly
-  isVersionCheck = process->arguments().join("") == "--version";
+  isVersionCheck = command.second.join("") == "--version";
   currentOutputFile = outputFile;
-  overWritePrompted = false;
+  bytesProcessed = 0;
+  allocationCount = 0;
+
+  QMetaObject::invokeMethod(
+      worker, [worker = worker, versionCheck = isVersionCheck] {
+        worker->reset(versionCheck);
+      });
+
+  if (!isVersionCheck) {
+    emit processStarted();
 
-  connect(process, &QProcess::readyReadStandardOutput, this,
-          &Pack3rProcessHandler::readStdOut);
-  connect(process, &QProcess::readyReadStandardError, this,
-          &Pack3rProcessHandler::readStdErr);
+    if (preferences.readSetting(Preferences::Settings::USE_DAEMON).toBool() &&
+        spawnDaemonJob(command, prePack)) {
+      RunTrace::instant("daemon job submitted");
+      return;
+    }
+  }
+
+  const auto priority = isVersionCheck ? ProcessPriority::Profile{}
+                                       : ProcessPriority::foreground();
+  const auto runtime = isVersionCheck ? RuntimeProfile::Profile{}
+                                      : RuntimeProfile::selected();
+  processRunning = true;
 
-  process->start();
+  if (!isVersionCheck) {
+    RunTrace::instant("spawn requested");
+  }
+
+  QMetaObject::invokeMethod(
+      worker, [worker = worker, command, priority, runtime, prePack] {
+        worker->start(command.first, command.second, priority, runtime,
+                      prePack);
+      });
 }
 
-void Pack3rProcessHandler::readStdOut() {
-  const auto out = process->readAllStandardOutput();
+void Pack3rProcessHandler::cancelProcess() {
+  if (daemonJobRunning) {
+    // the job id isn't known until the daemon has accepted the job,
+    // in which case the cancel is sent once we receive it
+    if (daemonJobId == 0) {
+      daemonCancelRequested = true;
+    } else if (daemonJobAttached) {
+      // someone else submitted this job, so only stop following it
+      postOutput(
+          tr("Detached from daemon job #%1\n").arg(daemonJobId).toUtf8());
+      daemonJobRunning = false;
+      QMetaObject::invokeMethod(worker,
+                                [worker = worker] { worker->finish(-1); });
+    } else {
+      daemonClient->cancel(daemonJobId);
+    }
 
-  if (isVersionCheck) {
-    parser->processVersion(out);
     return;
   }
 
-  parser->processOutput(out);
+  if (processRunning) {
+    QMetaObject::invokeMethod(worker, [worker = worker] { worker->cancel(); });
+  }
+}
 
-  Q_ASSERT(!currentOutputFile.isEmpty());
+bool Pack3rProcessHandler::spawnDaemonJob(
+    const QPair<QString, QStringList> &command,
+    const PrePackCommand::Command &prePack) {
+  if (!daemonClient->connectToDaemon()) {
+    postOutput(
+        tr("Pack daemon is not running, running Pack3r locally\n").toUtf8());
+    return false;
+  }
 
-  if (!overWritePrompted && out.contains("Overwrite? Y/N")) {
-    overWritePrompted = true;
+  daemonJobId = 0;
+  daemonJobAttached = false;
+  daemonCancelRequested = false;
+  daemonJobRunning = true;
+  daemonJobTag =
+      daemonClient->submit(command.first, command.second, currentOutputFile,
+                           ProcessPriority::foreground(),
+                           RuntimeProfile::selected(), !prePack.isEmpty());
+  return true;
+}
 
-    QMessageBox dialog{};
-    Dialog::setupMessageBox(dialog, Dialog::OVERWRITE);
-    dialog.setText(tr("File '%1' already exists!").arg(currentOutputFile));
+void Pack3rProcessHandler::setupWorkerConnections() {
+  // receivers are done with the batch once outputReady() returns
+  connect(worker, &Pack3rProcessWorker::outputReady, this,
+          [this](const QByteArray &lines) {
+            emit outputReady(lines);
+            QMetaObject::invokeMethod(worker, [worker = worker, lines] {
+              worker->recycleBatch(lines);
+            });
+          });
+  connect(worker, &Pack3rProcessWorker::referencesParsed, this,
+          &Pack3rProcessHandler::referencesParsed);
+  connect(worker, &Pack3rProcessWorker::versionParsed, this,
+          &Pack3rProcessHandler::pack3rVersionParsed);
+  connect(worker, &Pack3rProcessWorker::overwritePrompted, this,
+          &Pack3rProcessHandler::promptOverwrite);
 
-    const int ret = dialog.exec();
+  connect(worker, &Pack3rProcessWorker::statsUpdated, this,
+          [this](const quint64 bytes, const quint64 allocations) {
+            bytesProcessed = bytes;
+            allocationCount = allocations;
+          });
 
-    if (ret == QMessageBox::Yes) {
-      process->write("y\n");
-    } else {
-      process->write("n\n");
-      parser->processOutput("Operation canceled\n");
+  connect(worker, &Pack3rProcessWorker::finished, this,
+          [this](const int exitCode) {
+            processRunning = false;
+
+            if (!isVersionCheck) {
+              emit processFinished(exitCode);
+            }
+          });
+}
+
+void Pack3rProcessHandler::setupDaemonConnections() {
+  connect(daemonClient, &Pack3rDaemonClient::jobAccepted, this,
+          [this](const quint64 tag, const quint64 id, const bool attached) {
+            if (tag != daemonJobTag) {
+              return;
+            }
+
+            daemonJobId = id;
+            daemonJobAttached = attached;
+            postOutput((attached ? tr("Attached to running daemon job #%1\n")
+                                 : tr("Submitted daemon job #%1\n"))
+                           .arg(id)
+                           .toUtf8());
+
+            if (daemonCancelRequested) {
+              cancelProcess();
+            }
+          });
+
+  connect(daemonClient, &Pack3rDaemonClient::jobOutput, this,
+          [this](const quint64 id, const QByteArray &data) {
+            if (daemonJobRunning && id == daemonJobId) {
+              postOutput(data);
+            }
+          });
+
+  // finishing goes through the worker too,
+  // so all output is delivered before processFinished()
+  connect(daemonClient, &Pack3rDaemonClient::jobFinished, this,
+          [this](const quint64 id, const int exitCode, const bool canceled) {
+            if (!daemonJobRunning || id != daemonJobId) {
+              return;
+            }
+
+            if (canceled) {
+              postOutput("Operation canceled\n");
+            }
+
+            daemonJobRunning = false;
+            QMetaObject::invokeMethod(worker, [worker = worker, exitCode] {
+              worker->finish(exitCode);
+            });
+          });
+
+  connect(daemonClient, &Pack3rDaemonClient::disconnected, this, [this] {
+    if (daemonJobRunning) {
+      postOutput(tr("Lost connection to pack daemon\n").toUtf8());
+      daemonJobRunning = false;
+      QMetaObject::invokeMethod(worker,
+                                [worker = worker] { worker->finish(-1); });
     }
+  });
+}
+
+// status messages and daemon output are parsed on the worker as well,
+// so they stay in order with the output of the process
+void Pack3rProcessHandler::postOutput(const QByteArray &data) {
+  QMetaObject::invokeMethod(
+      worker, [worker = worker, data] { worker->processOutput(data); });
+}
+
+void Pack3rProcessHandler::promptOverwrite() {
+  Q_ASSERT(!currentOutputFile.isEmpty());
+
+  QMessageBox dialog{};
+  Dialog::setupMessageBox(dialog, Dialog::OVERWRITE);
+  dialog.setText(tr("File '%1' already exists!").arg(currentOutputFile));
+
+  const int ret = dialog.exec();
+
+  if (ret == QMessageBox::Yes) {
+    writeInput("y\n");
+  } else {
+    writeInput("n\n");
+    postOutput("Operation canceled\n");
   }
 }
 
-// Pack3r at the moment doesn't actually send anything to stderr,
-// but this is here for the future
-void Pack3rProcessHandler::readStdErr() const {
-  const auto err = process->readAllStandardError();
-  parser->processOutput(err);
+void Pack3rProcessHandler::writeInput(const QByteArray &data) {
+  if (daemonJobRunning) {
+    daemonClient->write(daemonJobId, data);
+  } else {
+    QMetaObject::invokeMethod(
+        worker, [worker = worker, data] { worker->write(data); });
+  }
 }
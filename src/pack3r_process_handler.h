@@ -24,34 +24,75 @@
 
 #pragma once
 
-#include "pack3r_output_parser.h"
+#include "pack3r_daemon.h"
+#include "pack3r_process_worker.h"
 
 #include <QHBoxLayout>
 #include <QMessageBox>
 #include <QPointer>
-#include <QProcess>
+#include <QThread>
 
+// Runs interactive Pack3r jobs, either locally or on the pack daemon.
+// Local processes run and all output is parsed on a worker thread, only
+// batches of parsed lines are delivered to the GUI thread.
 class Pack3rProcessHandler : public QObject {
   Q_OBJECT
 
 public:
-  Pack3rProcessHandler(QObject *parent,
-                       const QPointer<Pack3rOutputParser> &outputParser);
+  explicit Pack3rProcessHandler(QObject *parent);
+  ~Pack3rProcessHandler() override;
+
+  bool isRunning() const;
+
+  // output statistics of the current run, updated with every batch.
+  // Allocations are those of the output parser and the batch buffers in
+  // the worker thread
+  quint64 outputBytes() const;
+  quint64 parserAllocations() const;
 
 public slots:
+  // 'prePack' is run first, and Pack3r only if it succeeds
   void spawnProcess(const QPair<QString, QStringList> &command,
-                    const QString &outputFile);
+                    const QString &outputFile,
+                    const PrePackCommand::Command &prePack = {});
+  void cancelProcess();
+
+signals:
+  void processStarted();
+  void processFinished(int exitCode);
+
+  // '\n' terminated lines of parsed output. Receivers shouldn't keep the
+  // batch, so its buffer can be reused for later output
+  void outputReady(const QByteArray &lines);
+  void referencesParsed(const QList<ReferenceGraph::Reference> &references);
+  void pack3rVersionParsed(const QString &version);
 
 private:
-  void readStdOut();
-  void readStdErr() const;
+  bool spawnDaemonJob(const QPair<QString, QStringList> &command,
+                      const PrePackCommand::Command &prePack);
+  void setupWorkerConnections();
+  void setupDaemonConnections();
+
+  void postOutput(const QByteArray &data);
+  void promptOverwrite();
+  void writeInput(const QByteArray &data);
+
+  QThread *workerThread;
+  Pack3rProcessWorker *worker;
+  bool processRunning{};
 
-  QProcess *process;
-  QPointer<Pack3rOutputParser> parser;
+  // jobs are submitted to the daemon instead of spawning a process locally
+  // if it's enabled in preferences and a daemon is running
+  Pack3rDaemonClient *daemonClient;
+  quint64 daemonJobTag{};
+  quint64 daemonJobId{};
+  bool daemonJobRunning{};
+  bool daemonJobAttached{};
+  bool daemonCancelRequested{};
 
-  // optimization so we don't need to do .contains() for every line of output
-  bool overWritePrompted{};
   bool isVersionCheck{};
+  quint64 bytesProcessed{};
+  quint64 allocationCount{};
 
   QString currentOutputFile;
 };
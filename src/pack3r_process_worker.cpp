@@ -0,0 +1,415 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pack3r_process_worker.h"
+#include "run_trace.h"
+
+#ifdef Q_OS_LINUX
+#include <QFile>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr qsizetype READ_BUFFER_SIZE = 64 * 1024;
+
+// one batch per frame at 60 fps
+constexpr int BATCH_INTERVAL_MS = 16;
+
+// enough for the batches in flight between the worker and the GUI thread
+constexpr qsizetype MAX_FREE_BATCHES = 4;
+
+constexpr int CPU_SAMPLE_INTERVAL_MS = 50;
+
+// longer info lines are cut, phase names only need to be recognizable
+constexpr qsizetype MAX_PHASE_NAME_LENGTH = 60;
+
+// CPU time used by the process in clock ticks, or -1 if unavailable
+qint64 readCpuTicks(const qint64 pid) {
+#ifdef Q_OS_LINUX
+  QFile stat(QString("/proc/%1/stat").arg(pid));
+
+  if (!stat.open(QIODevice::ReadOnly)) {
+    return -1;
+  }
+
+  // the process name can contain spaces, so fields are counted from
+  // the end of it, utime and stime are the 14th and 15th fields
+  const QByteArray contents = stat.readAll();
+  const QList<QByteArray> fields =
+      contents.mid(contents.lastIndexOf(')') + 2).split(' ');
+
+  if (fields.size() < 13) {
+    return -1;
+  }
+
+  return fields[11].toLongLong() + fields[12].toLongLong();
+#else
+  Q_UNUSED(pid)
+  return -1;
+#endif
+}
+} // namespace
+
+Pack3rProcessWorker::Pack3rProcessWorker()
+    : process(new QProcess(this)), parser(new Pack3rOutputParser(this)),
+      prePackParser(new Pack3rOutputParser(this)), batchTimer(new QTimer(this)),
+      cpuSampleTimer(new QTimer(this)) {
+  batchTimer->setSingleShot(true);
+  batchTimer->setInterval(BATCH_INTERVAL_MS);
+  cpuSampleTimer->setInterval(CPU_SAMPLE_INTERVAL_MS);
+
+  connect(batchTimer, &QTimer::timeout, this, &Pack3rProcessWorker::flushBatch);
+  connect(cpuSampleTimer, &QTimer::timeout, this,
+          &Pack3rProcessWorker::sampleCpuUsage);
+
+  // direct connection, the line is a view into the parsers input
+  connect(parser, &Pack3rOutputParser::pack3rOutputProcessed, this,
+          &Pack3rProcessWorker::appendLine, Qt::DirectConnection);
+  connect(parser, &Pack3rOutputParser::pack3rVersionParsed, this,
+          &Pack3rProcessWorker::versionParsed);
+  connect(prePackParser, &Pack3rOutputParser::pack3rOutputProcessed, this,
+          &Pack3rProcessWorker::appendPrePackLine, Qt::DirectConnection);
+
+  connect(process, &QProcess::readyReadStandardOutput, this,
+          &Pack3rProcessWorker::readStdOut);
+  connect(process, &QProcess::readyReadStandardError, this,
+          &Pack3rProcessWorker::readStdErr);
+
+  connect(process, &QProcess::started, this, [this] {
+    if (isTraced && RunTrace::isActive()) {
+      RunTrace::instant("process started");
+      lastCpuTicks = -1;
+      sampleCpuUsage();
+      cpuSampleTimer->start();
+    }
+  });
+
+  connect(process, &QProcess::finished, this,
+          [this](const int exitCode, const QProcess::ExitStatus status) {
+            if (pendingProgram.isEmpty()) {
+              finish(exitCode);
+            } else {
+              finishPrePack(status == QProcess::NormalExit ? exitCode : -1);
+            }
+          });
+
+  connect(process, &QProcess::errorOccurred, this,
+          [this](const QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart) {
+              const QString message =
+                  pendingProgram.isEmpty()
+                      ? tr("Failed to start Pack3r: %1\n")
+                      : tr("Failed to start pre-pack command: %1\n");
+              pendingProgram.clear();
+
+              if (!isVersionCheck) {
+                processOutput(message.arg(process->errorString()).toUtf8());
+              }
+
+              finish(-1);
+            }
+          });
+}
+
+void Pack3rProcessWorker::reset(const bool versionCheck, const bool traced) {
+  isVersionCheck = versionCheck;
+  isTraced = traced && !versionCheck;
+  overwritePromptSeen = false;
+  firstOutputTraced = false;
+  tracedPhaseStart = -1;
+  pendingProgram.clear();
+  parser->resetStats();
+  batchAllocations = 0;
+}
+
+void Pack3rProcessWorker::start(const QString &program,
+                                const QStringList &arguments,
+                                const ProcessPriority::Profile &priority,
+                                const RuntimeProfile::Profile &runtime,
+                                const PrePackCommand::Command &prePack) {
+  process->setProgram(program);
+  process->setArguments(arguments);
+  ProcessPriority::apply(process, priority);
+  RuntimeProfile::apply(process, runtime);
+
+  const QString recordingPath = qEnvironmentVariable("QTPACK3R_RECORD_OUTPUT");
+
+  if (!isVersionCheck && !recordingPath.isEmpty()) {
+    if (recording.open(recordingPath)) {
+      processOutput(tr("Recording output to %1\n").arg(recordingPath).toUtf8());
+    } else {
+      processOutput(tr("Unable to record output to %1: %2\n")
+                        .arg(recordingPath, recording.errorString())
+                        .toUtf8());
+    }
+  }
+
+  if (!prePack.isEmpty()) {
+    pendingProgram = program;
+    pendingArguments = arguments;
+    process->setProgram(prePack.program);
+    process->setArguments(prePack.arguments);
+    processOutput(tr("Running pre-pack command: %1\n")
+                      .arg(PrePackCommand::toString(prePack))
+                      .toUtf8());
+  }
+
+  process->start();
+}
+
+void Pack3rProcessWorker::cancel() {
+  // Pack3r isn't started after a canceled pre-pack command
+  pendingProgram.clear();
+
+  if (process->state() != QProcess::NotRunning) {
+    process->kill();
+    processOutput("Operation canceled\n");
+  }
+}
+
+void Pack3rProcessWorker::write(const QByteArray &data) {
+  process->write(data);
+}
+
+void Pack3rProcessWorker::processOutput(const QByteArrayView data) {
+  parser->processOutput(data);
+
+  if (!overwritePromptSeen &&
+      QLatin1String(data.data(), data.size())
+          .contains(QLatin1String(PACK3R_OVERWRITE_PROMPT))) {
+    overwritePromptSeen = true;
+
+    // everything before the prompt should be visible when it's answered
+    flushBatch();
+    emit overwritePrompted();
+  }
+}
+
+void Pack3rProcessWorker::recycleBatch(const QByteArray &lines) {
+  if (freeBatches.size() < MAX_FREE_BATCHES) {
+    freeBatches.append(lines);
+  }
+}
+
+void Pack3rProcessWorker::finish(const int exitCode) {
+  cpuSampleTimer->stop();
+  recording.close();
+  prePackParser->flush();
+  flushBatch();
+
+  if (tracedPhaseStart >= 0) {
+    RunTrace::complete(tracedPhase, tracedPhaseStart, RunTrace::now(),
+                       RunTrace::TRACK_PACK3R_PHASES);
+    tracedPhaseStart = -1;
+  }
+
+  if (isTraced) {
+    RunTrace::instant(QString("finished (exit code %1)").arg(exitCode));
+  }
+
+  emit finished(exitCode);
+}
+
+void Pack3rProcessWorker::readStdOut() {
+  if (isVersionCheck) {
+    parser->processVersion(process->readAllStandardOutput());
+    return;
+  }
+
+  if (readBuffer.isEmpty()) {
+    readBuffer.resize(READ_BUFFER_SIZE);
+  }
+
+  while (process->bytesAvailable() > 0) {
+    const qint64 read = process->read(readBuffer.data(), readBuffer.size());
+
+    if (read <= 0) {
+      break;
+    }
+
+    const QByteArrayView out(readBuffer.constData(), read);
+
+    if (!pendingProgram.isEmpty()) {
+      prePackParser->processOutput(out);
+      continue;
+    }
+
+    if (isTraced && !firstOutputTraced) {
+      firstOutputTraced = true;
+      RunTrace::instant("first output");
+    }
+
+    if (recording.isOpen()) {
+      recording.append(out);
+    }
+
+    processOutput(out);
+  }
+}
+
+// priority and runtime settings of the process are kept for Pack3r
+void Pack3rProcessWorker::finishPrePack(const int exitCode) {
+  prePackParser->flush();
+
+  if (exitCode != 0) {
+    pendingProgram.clear();
+    processOutput(tr("Pre-pack command failed with exit code %1\n")
+                      .arg(exitCode)
+                      .toUtf8());
+    finish(exitCode);
+    return;
+  }
+
+  // Pack3r output must start on a line of its own
+  parser->flush();
+
+  process->setProgram(pendingProgram);
+  process->setArguments(pendingArguments);
+  pendingProgram.clear();
+  process->start();
+}
+
+// Pack3r at the moment doesn't actually send anything to stderr,
+// but this is here for the future
+void Pack3rProcessWorker::readStdErr() {
+  if (!pendingProgram.isEmpty()) {
+    prePackParser->processOutput(process->readAllStandardError());
+    return;
+  }
+
+  processOutput(process->readAllStandardError());
+}
+
+void Pack3rProcessWorker::appendLine(const QByteArrayView line) {
+  batch.append(line);
+  batch.append('\n');
+
+  ReferenceGraph::Reference reference{};
+
+  if (ReferenceGraph::parseLine(line, reference)) {
+    references.append(reference);
+  }
+
+  if (isTraced && RunTrace::isActive()) {
+    tracePhase(line);
+  }
+
+  if (!batchTimer->isActive()) {
+    batchTimer->start();
+  }
+}
+
+void Pack3rProcessWorker::appendPrePackLine(const QByteArrayView line) {
+  batch.append(line);
+  batch.append('\n');
+
+  if (!batchTimer->isActive()) {
+    batchTimer->start();
+  }
+}
+
+void Pack3rProcessWorker::flushBatch() {
+  batchTimer->stop();
+
+  if (batch.isEmpty()) {
+    return;
+  }
+
+  const RunTrace::Scope scope("flush batch");
+
+  emit outputReady(batch);
+
+  if (!references.isEmpty()) {
+    emit referencesParsed(references);
+    references.clear();
+  }
+
+  emit statsUpdated(parser->bytesProcessed(),
+                    parser->allocationCount() + batchAllocations);
+
+  // the batch is shared with the queued signal, so continue in another
+  // buffer instead of detaching this one later
+  batch = takeBatchBuffer(batch.capacity());
+}
+
+// buffers are only reused once the GUI thread has let go of them,
+// truncating a shared buffer would allocate a new one anyway
+QByteArray Pack3rProcessWorker::takeBatchBuffer(const qsizetype capacity) {
+  if (!freeBatches.isEmpty() && freeBatches.first().isDetached()) {
+    QByteArray buffer = freeBatches.takeFirst();
+    buffer.truncate(0);
+    return buffer;
+  }
+
+  QByteArray buffer{};
+  buffer.reserve(capacity);
+  batchAllocations++;
+  return buffer;
+}
+
+void Pack3rProcessWorker::tracePhase(const QByteArrayView line) {
+  if (Pack3rOutputParser::logLevel(line) != Pack3rOutputParser::LOG_INFO) {
+    return;
+  }
+
+  const qint64 now = RunTrace::now();
+
+  if (tracedPhaseStart >= 0) {
+    RunTrace::complete(tracedPhase, tracedPhaseStart, now,
+                       RunTrace::TRACK_PACK3R_PHASES);
+  }
+
+  tracedPhase = QString::fromUtf8(line.left(MAX_PHASE_NAME_LENGTH));
+  tracedPhaseStart = now;
+}
+
+void Pack3rProcessWorker::sampleCpuUsage() {
+#ifdef Q_OS_LINUX
+  if (!RunTrace::isActive()) {
+    cpuSampleTimer->stop();
+    return;
+  }
+
+  const qint64 ticks = readCpuTicks(process->processId());
+  const qint64 now = RunTrace::now();
+
+  if (ticks < 0) {
+    return;
+  }
+
+  if (lastCpuTicks >= 0 && now > lastCpuSample) {
+    // microseconds of CPU time per microsecond, can exceed 100% when
+    // Pack3r uses more than one core
+    const double cpuUs = static_cast<double>(ticks - lastCpuTicks) *
+                         1000000.0 / static_cast<double>(sysconf(_SC_CLK_TCK));
+    RunTrace::counter("Pack3r CPU %",
+                      100.0 * cpuUs / static_cast<double>(now - lastCpuSample));
+  }
+
+  lastCpuTicks = ticks;
+  lastCpuSample = now;
+#else
+  cpuSampleTimer->stop();
+#endif
+}
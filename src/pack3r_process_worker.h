@@ -0,0 +1,134 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "output_recording.h"
+#include "pack3r_output_parser.h"
+#include "pre_pack_command.h"
+#include "process_priority.h"
+#include "reference_graph.h"
+#include "runtime_profile.h"
+
+#include <QProcess>
+#include <QTimer>
+
+#define PACK3R_OVERWRITE_PROMPT "Overwrite? Y/N"
+
+/* Runs a Pack3r process and parses its output on a worker thread, so heavy
+ * output doesn't compete with painting and input on the GUI thread.
+ *
+ * Parsed lines are collected into batches of '\n' terminated lines, which
+ * are sent to the GUI thread at most once per frame. Output of daemon jobs
+ * and status messages are passed through here as well, so they're ordered
+ * correctly with process output.
+ *
+ * Batches are handed back with recycleBatch() once they've been appended,
+ * so their buffers are reused instead of allocating one for every batch.
+ *
+ * All functions must be called on the thread the worker lives on, e.g. with
+ * QMetaObject::invokeMethod().
+ */
+class Pack3rProcessWorker : public QObject {
+  Q_OBJECT
+
+public:
+  Pack3rProcessWorker();
+
+  // resets per-run state, called before every run, local or not. Runs
+  // which aren't 'traced' are left out of the run trace, e.g. batch jobs
+  void reset(bool versionCheck, bool traced = true);
+  // Pack3r is started once 'prePack' succeeds, if there is one
+  void start(const QString &program, const QStringList &arguments,
+             const ProcessPriority::Profile &priority,
+             const RuntimeProfile::Profile &runtime,
+             const PrePackCommand::Command &prePack);
+  void cancel();
+  void write(const QByteArray &data);
+
+  void processOutput(QByteArrayView data);
+  void recycleBatch(const QByteArray &lines);
+  // emits any pending output followed by finished(), for jobs which
+  // don't run as a local process
+  void finish(int exitCode);
+
+signals:
+  void outputReady(const QByteArray &lines);
+  // references parsed from the lines of the same batch
+  void referencesParsed(const QList<ReferenceGraph::Reference> &references);
+  void statsUpdated(quint64 bytes, quint64 allocations);
+  void overwritePrompted();
+  void versionParsed(const QString &version);
+  void finished(int exitCode);
+
+private:
+  void readStdOut();
+  void readStdErr();
+  void finishPrePack(int exitCode);
+  void appendLine(QByteArrayView line);
+  void appendPrePackLine(QByteArrayView line);
+  void flushBatch();
+  QByteArray takeBatchBuffer(qsizetype capacity);
+
+  // trace events, only recorded while a RunTrace is active
+  void tracePhase(QByteArrayView line);
+  void sampleCpuUsage();
+
+  QProcess *process;
+  Pack3rOutputParser *parser;
+  // output of the pre-pack command is only split into lines, it's not
+  // Pack3r output, so it isn't parsed for references, phases or prompts
+  Pack3rOutputParser *prePackParser;
+  QTimer *batchTimer;
+  QTimer *cpuSampleTimer;
+
+  QByteArray batch;
+  // batches returned by the GUI thread, which may still be shared with it
+  QList<QByteArray> freeBatches;
+  quint64 batchAllocations{};
+  QList<ReferenceGraph::Reference> references;
+
+  // output is read into the same buffer every time, and the parser
+  // passes lines on as views into it
+  QByteArray readBuffer;
+
+  OutputRecording recording;
+
+  // Pack3r command waiting for the pre-pack command to finish
+  QString pendingProgram;
+  QStringList pendingArguments;
+
+  // Pack3r phases are inferred from info level lines,
+  // each lasting until the next one
+  QString tracedPhase;
+  qint64 tracedPhaseStart{-1};
+  qint64 lastCpuTicks{-1};
+  qint64 lastCpuSample{};
+  bool firstOutputTraced{};
+
+  // optimization so we don't need to do .contains() for every line of output
+  bool overwritePromptSeen{};
+  bool isVersionCheck{};
+  bool isTraced = true;
+};
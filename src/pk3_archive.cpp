@@ -0,0 +1,439 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pk3_archive.h"
+
+#include <QtEndian>
+#include <array>
+
+#ifdef QTPACK3R_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+constexpr quint32 LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr quint32 CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr quint32 EOCD_SIGNATURE = 0x06054b50;
+constexpr quint32 ZIP64_EOCD_SIGNATURE = 0x06064b50;
+constexpr quint32 ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+
+constexpr qint64 LOCAL_HEADER_SIZE = 30;
+constexpr qint64 CENTRAL_HEADER_SIZE = 46;
+constexpr qint64 EOCD_SIZE = 22;
+constexpr qint64 ZIP64_EOCD_SIZE = 56;
+constexpr qint64 ZIP64_LOCATOR_SIZE = 20;
+constexpr qint64 MAX_COMMENT_SIZE = 0xffff;
+
+constexpr quint16 ZIP64_EXTRA_ID = 0x0001;
+constexpr quint16 FLAG_ENCRYPTED = 0x0001;
+constexpr quint16 FLAG_UTF8 = 0x0800;
+
+// decompression happens in chunks of this size when the output isn't needed
+constexpr qsizetype CHUNK_SIZE = 256 * 1024;
+
+template <typename T> T read(const uchar *ptr) {
+  return qFromLittleEndian<T>(ptr);
+}
+
+#ifdef QTPACK3R_HAVE_ZLIB
+// inflates raw deflate data, passing each decompressed chunk to 'sink'
+template <typename Sink>
+bool inflateRaw(const QByteArrayView input, char *buffer,
+                const qsizetype bufferSize, QString *error, Sink sink) {
+  z_stream stream{};
+
+  if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+    if (error) {
+      *error = QObject::tr("Unable to initialize zlib");
+    }
+
+    return false;
+  }
+
+  // z_stream sizes are 32-bit, but pk3 entries are never that large
+  stream.next_in =
+      reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+  stream.avail_in = static_cast<uInt>(input.size());
+
+  // truncated data ends up as Z_BUF_ERROR, once inflate() can't progress
+  int ret = Z_OK;
+
+  while (ret == Z_OK) {
+    stream.next_out = reinterpret_cast<Bytef *>(buffer);
+    stream.avail_out = static_cast<uInt>(bufferSize);
+
+    ret = inflate(&stream, Z_NO_FLUSH);
+
+    if (ret == Z_OK || ret == Z_STREAM_END) {
+      sink(QByteArrayView(buffer, bufferSize - stream.avail_out));
+    }
+  }
+
+  inflateEnd(&stream);
+
+  if (ret != Z_STREAM_END) {
+    if (error) {
+      *error = QObject::tr("Invalid deflate data (zlib error %1)").arg(ret);
+    }
+
+    return false;
+  }
+
+  return true;
+}
+#endif
+} // namespace
+
+Pk3Archive::Pk3Archive(const QString &path) : file(path) {}
+
+bool Pk3Archive::open() {
+  if (!file.open(QIODevice::ReadOnly)) {
+    error = file.errorString();
+    return false;
+  }
+
+  fileSize = file.size();
+
+  if (fileSize < EOCD_SIZE) {
+    error = QObject::tr("File is too small to be a pk3");
+    return false;
+  }
+
+  data = file.map(0, fileSize);
+
+  if (!data) {
+    error = file.errorString();
+    return false;
+  }
+
+  // the end of central directory record is at the very end,
+  // unless there is an archive comment after it
+  qint64 eocd = -1;
+  const qint64 searchEnd = qMax<qint64>(0, fileSize - EOCD_SIZE -
+                                               MAX_COMMENT_SIZE);
+
+  for (qint64 i = fileSize - EOCD_SIZE; i >= searchEnd; i--) {
+    if (read<quint32>(data + i) == EOCD_SIGNATURE) {
+      eocd = i;
+      break;
+    }
+  }
+
+  if (eocd == -1) {
+    error = QObject::tr("End of central directory not found, "
+                        "the file is truncated or not a pk3");
+    return false;
+  }
+
+  quint64 count = read<quint16>(data + eocd + 10);
+  quint64 cdSize = read<quint32>(data + eocd + 12);
+  quint64 cdOffset = read<quint32>(data + eocd + 16);
+
+  // very large archives store the real values in a zip64 record
+  const qint64 locator = eocd - ZIP64_LOCATOR_SIZE;
+
+  if (locator >= 0 &&
+      read<quint32>(data + locator) == ZIP64_LOCATOR_SIGNATURE) {
+    const auto zip64Eocd = read<quint64>(data + locator + 8);
+
+    if (zip64Eocd + ZIP64_EOCD_SIZE > static_cast<quint64>(fileSize) ||
+        read<quint32>(data + zip64Eocd) != ZIP64_EOCD_SIGNATURE) {
+      error = QObject::tr("Invalid zip64 end of central directory");
+      return false;
+    }
+
+    count = read<quint64>(data + zip64Eocd + 32);
+    cdSize = read<quint64>(data + zip64Eocd + 40);
+    cdOffset = read<quint64>(data + zip64Eocd + 48);
+  }
+
+  if (cdOffset + cdSize > static_cast<quint64>(fileSize)) {
+    error = QObject::tr("Central directory is out of bounds, "
+                        "the file is likely truncated");
+    return false;
+  }
+
+  return readCentralDirectory(cdOffset, cdSize, count);
+}
+
+bool Pk3Archive::readCentralDirectory(const quint64 offset, const quint64 size,
+                                      const quint64 count) {
+  const uchar *ptr = data + offset;
+  const uchar *end = ptr + size;
+
+  entryList.clear();
+  entryList.reserve(static_cast<qsizetype>(
+      qMin<quint64>(count, size / CENTRAL_HEADER_SIZE)));
+
+  for (quint64 i = 0; i < count; i++) {
+    if (end - ptr < CENTRAL_HEADER_SIZE ||
+        read<quint32>(ptr) != CENTRAL_HEADER_SIGNATURE) {
+      error = QObject::tr("Invalid central directory entry %1").arg(i);
+      return false;
+    }
+
+    const auto nameLength = read<quint16>(ptr + 28);
+    const auto extraLength = read<quint16>(ptr + 30);
+    const auto commentLength = read<quint16>(ptr + 32);
+    const qint64 headerSize =
+        CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength;
+
+    if (end - ptr < headerSize) {
+      error = QObject::tr("Invalid central directory entry %1").arg(i);
+      return false;
+    }
+
+    Entry entry{};
+    entry.flags = read<quint16>(ptr + 8);
+    entry.method = read<quint16>(ptr + 10);
+    entry.modified = read<quint32>(ptr + 12);
+    entry.crc32 = read<quint32>(ptr + 16);
+    entry.compressedSize = read<quint32>(ptr + 20);
+    entry.uncompressedSize = read<quint32>(ptr + 24);
+    entry.localHeaderOffset = read<quint32>(ptr + 42);
+
+    const auto *name = reinterpret_cast<const char *>(ptr + 46);
+    entry.name = entry.flags & FLAG_UTF8
+                     ? QString::fromUtf8(name, nameLength)
+                     : QString::fromLatin1(name, nameLength);
+
+    // zip64 extra field only contains the values which overflowed
+    const uchar *extra = ptr + CENTRAL_HEADER_SIZE + nameLength;
+    const uchar *extraEnd = extra + extraLength;
+
+    while (extraEnd - extra >= 4) {
+      const auto id = read<quint16>(extra);
+      const auto length = read<quint16>(extra + 2);
+      const uchar *field = extra + 4;
+      const uchar *fieldEnd = field + length;
+
+      if (fieldEnd > extraEnd) {
+        break;
+      }
+
+      if (id == ZIP64_EXTRA_ID) {
+        for (quint64 *value : {&entry.uncompressedSize, &entry.compressedSize,
+                               &entry.localHeaderOffset}) {
+          if (*value == 0xffffffff && fieldEnd - field >= 8) {
+            *value = read<quint64>(field);
+            field += 8;
+          }
+        }
+      }
+
+      extra = fieldEnd;
+    }
+
+    entryList.append(entry);
+    ptr += headerSize;
+  }
+
+  return true;
+}
+
+QString Pk3Archive::errorString() const { return error; }
+
+QString Pk3Archive::path() const { return file.fileName(); }
+
+qint64 Pk3Archive::size() const { return fileSize; }
+
+const QList<Pk3Archive::Entry> &Pk3Archive::entries() const {
+  return entryList;
+}
+
+QByteArrayView Pk3Archive::rawData(const Entry &entry, QString *error) const {
+  const quint64 offset = entry.localHeaderOffset;
+
+  if (offset + LOCAL_HEADER_SIZE > static_cast<quint64>(fileSize) ||
+      read<quint32>(data + offset) != LOCAL_HEADER_SIGNATURE) {
+    if (error) {
+      *error = QObject::tr("Invalid local header");
+    }
+
+    return {};
+  }
+
+  // the local header can have a different extra field than the central one
+  const quint64 start = offset + LOCAL_HEADER_SIZE +
+                        read<quint16>(data + offset + 26) +
+                        read<quint16>(data + offset + 28);
+
+  if (start + entry.compressedSize > static_cast<quint64>(fileSize)) {
+    if (error) {
+      *error = QObject::tr("Data is out of bounds, the file is truncated");
+    }
+
+    return {};
+  }
+
+  return {reinterpret_cast<const char *>(data + start),
+          static_cast<qsizetype>(entry.compressedSize)};
+}
+
+bool Pk3Archive::extract(const Entry &entry, QByteArray &out,
+                         QString *error) const {
+  if (entry.flags & FLAG_ENCRYPTED) {
+    if (error) {
+      *error = QObject::tr("Encrypted entries are not supported");
+    }
+
+    return false;
+  }
+
+  QString rawError{};
+  const QByteArrayView raw = rawData(entry, &rawError);
+
+  if (!rawError.isEmpty()) {
+    if (error) {
+      *error = rawError;
+    }
+
+    return false;
+  }
+
+  if (entry.method == STORED) {
+    out = raw.toByteArray();
+    return true;
+  }
+
+#ifdef QTPACK3R_HAVE_ZLIB
+  if (entry.method == DEFLATED) {
+    out.clear();
+    out.reserve(static_cast<qsizetype>(entry.uncompressedSize));
+
+    QByteArray buffer(CHUNK_SIZE, Qt::Uninitialized);
+    return inflateRaw(raw, buffer.data(), buffer.size(), error,
+                      [&out](const QByteArrayView chunk) {
+                        out.append(chunk.data(), chunk.size());
+                      });
+  }
+#endif
+
+  if (error) {
+    *error = QObject::tr("Unsupported compression method %1").arg(entry.method);
+  }
+
+  return false;
+}
+
+bool Pk3Archive::checksum(const Entry &entry, quint32 &crc,
+                          QString *error) const {
+  if (entry.flags & FLAG_ENCRYPTED) {
+    if (error) {
+      *error = QObject::tr("Encrypted entries are not supported");
+    }
+
+    return false;
+  }
+
+  QString rawError{};
+  const QByteArrayView raw = rawData(entry, &rawError);
+
+  if (!rawError.isEmpty()) {
+    if (error) {
+      *error = rawError;
+    }
+
+    return false;
+  }
+
+  if (entry.method == STORED) {
+    crc = crc32(raw);
+    return true;
+  }
+
+#ifdef QTPACK3R_HAVE_ZLIB
+  if (entry.method == DEFLATED) {
+    // one buffer per thread, as entries are checked in parallel
+    thread_local QByteArray buffer(CHUNK_SIZE, Qt::Uninitialized);
+    quint32 result = 0;
+
+    if (!inflateRaw(raw, buffer.data(), buffer.size(), error,
+                    [&result](const QByteArrayView chunk) {
+                      result = crc32(chunk, result);
+                    })) {
+      return false;
+    }
+
+    crc = result;
+    return true;
+  }
+#endif
+
+  if (error) {
+    *error = QObject::tr("Unsupported compression method %1").arg(entry.method);
+  }
+
+  return false;
+}
+
+bool Pk3Archive::canDecompress(const quint16 method) {
+#ifdef QTPACK3R_HAVE_ZLIB
+  return method == STORED || method == DEFLATED;
+#else
+  return method == STORED;
+#endif
+}
+
+quint32 Pk3Archive::crc32(const QByteArrayView data, quint32 crc) {
+#ifdef QTPACK3R_HAVE_ZLIB
+  const auto *ptr = reinterpret_cast<const Bytef *>(data.data());
+  qsizetype remaining = data.size();
+
+  // zlib lengths are 32-bit
+  while (remaining > 0) {
+    const auto length =
+        static_cast<uInt>(qMin<qsizetype>(remaining, 0x40000000));
+    crc = static_cast<quint32>(::crc32(crc, ptr, length));
+    ptr += length;
+    remaining -= length;
+  }
+
+  return crc;
+#else
+  static const auto table = [] {
+    std::array<quint32, 256> t{};
+
+    for (quint32 i = 0; i < 256; i++) {
+      quint32 c = i;
+
+      for (int k = 0; k < 8; k++) {
+        c = c & 1 ? 0xedb88320 ^ (c >> 1) : c >> 1;
+      }
+
+      t[i] = c;
+    }
+
+    return t;
+  }();
+
+  crc = ~crc;
+
+  for (const char c : data) {
+    crc = table[(crc ^ static_cast<uchar>(c)) & 0xff] ^ (crc >> 8);
+  }
+
+  return ~crc;
+#endif
+}
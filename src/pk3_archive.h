@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QByteArrayView>
+#include <QFile>
+#include <QList>
+
+/* Read-only access to a pk3 (zip) archive.
+ *
+ * Only the central directory is parsed when the archive is opened, entry data
+ * is read straight from the memory mapped file when it's requested. Reading
+ * entries is thread-safe, so entries can be processed in parallel.
+ *
+ * Deflated entries can only be decompressed if built with zlib,
+ * see canDecompress().
+ */
+class Pk3Archive {
+public:
+  enum CompressionMethod {
+    STORED = 0,
+    DEFLATED = 8,
+  };
+
+  struct Entry {
+    QString name;
+    quint16 flags{};
+    quint16 method{};
+    quint32 crc32{};
+    quint32 modified{}; // MS-DOS time in the low, date in the high word
+    quint64 compressedSize{};
+    quint64 uncompressedSize{};
+    quint64 localHeaderOffset{};
+
+    bool isDirectory() const { return name.endsWith('/'); }
+  };
+
+  explicit Pk3Archive(const QString &path);
+
+  bool open();
+  QString errorString() const;
+
+  QString path() const;
+  qint64 size() const;
+  const QList<Entry> &entries() const;
+
+  // compressed data of an entry, empty and sets error if the local header
+  // is invalid or the data is out of bounds
+  QByteArrayView rawData(const Entry &entry, QString *error = nullptr) const;
+
+  // decompressed contents of an entry
+  bool extract(const Entry &entry, QByteArray &out,
+               QString *error = nullptr) const;
+
+  // CRC32 of the decompressed contents, without holding all of it in memory
+  bool checksum(const Entry &entry, quint32 &crc,
+                QString *error = nullptr) const;
+
+  static bool canDecompress(quint16 method);
+  static quint32 crc32(QByteArrayView data, quint32 crc = 0);
+
+private:
+  bool readCentralDirectory(quint64 offset, quint64 size, quint64 count);
+
+  QFile file;
+  const uchar *data{};
+  qint64 fileSize{};
+
+  QList<Entry> entryList;
+  QString error;
+};
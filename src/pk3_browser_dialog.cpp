@@ -0,0 +1,95 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pk3_browser_dialog.h"
+
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QLocale>
+
+Pk3BrowserDialog::Pk3BrowserDialog(QWidget *parent) : QDialog(parent) {
+  setAttribute(Qt::WA_DeleteOnClose);
+  resize(800, 600);
+
+  model = new Pk3EntryModel(this);
+  layout = new QVBoxLayout(this);
+
+  filterField = new QLineEdit(this);
+  filterField->setPlaceholderText(tr("Filter by path, or extension (*.tga)"));
+  filterField->setClearButtonEnabled(true);
+
+  entryView = new QTreeView(this);
+  entryView->setModel(model);
+  entryView->setUniformRowHeights(true);
+  entryView->setAlternatingRowColors(true);
+  entryView->header()->setStretchLastSection(false);
+  entryView->header()->setSectionResizeMode(Pk3EntryModel::COLUMN_NAME,
+                                            QHeaderView::Stretch);
+
+  statusLabel = new QLabel(this);
+
+  layout->addWidget(filterField);
+  layout->addWidget(entryView);
+  layout->addWidget(statusLabel);
+
+  connect(filterField, &QLineEdit::textChanged, this,
+          [&](const QString &text) {
+            model->setFilter(text.trimmed());
+            updateStatus();
+          });
+}
+
+bool Pk3BrowserDialog::load(const QString &path, QString &error) {
+  if (!model->open(path, error)) {
+    return false;
+  }
+
+  setWindowTitle(QFileInfo(path).fileName());
+  filterField->clear();
+  updateStatus();
+  return true;
+}
+
+void Pk3BrowserDialog::updateStatus() const {
+  const QLocale locale{};
+  const quint64 size = model->totalSize();
+  const quint64 compressed = model->totalCompressedSize();
+  QString status =
+      tr("%1 entries, %2 uncompressed, %3 compressed")
+          .arg(model->entryCount())
+          .arg(locale.formattedDataSize(static_cast<qint64>(size)),
+               locale.formattedDataSize(static_cast<qint64>(compressed)));
+
+  if (size > 0) {
+    status += tr(" (%1%)").arg(100.0 * static_cast<double>(compressed) /
+                                   static_cast<double>(size),
+                               0, 'f', 1);
+  }
+
+  if (!filterField->text().trimmed().isEmpty()) {
+    status += tr(", %1 matching").arg(model->matchCount());
+  }
+
+  statusLabel->setText(status);
+}
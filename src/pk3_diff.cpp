@@ -0,0 +1,228 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pk3_diff.h"
+#include "filesystem.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QHash>
+#include <QObject>
+#include <QSaveFile>
+#include <algorithm>
+
+namespace {
+constexpr quint32 CACHE_MAGIC = 0x51505044; // "QPPD"
+constexpr quint32 CACHE_VERSION = 1;
+
+// one file per pk3, named after a hash of its path
+QString previousListingPath(const QString &path) {
+  const QByteArray hash = QCryptographicHash::hash(
+      QFileInfo(path).absoluteFilePath().toUtf8(), QCryptographicHash::Md5);
+  return FileSystem::getCacheFilePath(
+      QString("pk3_previous_%1.dat").arg(QString::fromLatin1(hash.toHex())));
+}
+
+// only what a comparison needs is stored
+void writeEntries(QDataStream &stream,
+                  const QList<Pk3Archive::Entry> &entries) {
+  stream << static_cast<qint64>(entries.size());
+
+  for (const auto &entry : entries) {
+    stream << entry.name << entry.method << entry.crc32
+           << entry.compressedSize << entry.uncompressedSize;
+  }
+}
+
+void readEntries(QDataStream &stream, QList<Pk3Archive::Entry> &entries) {
+  qint64 count{};
+  stream >> count;
+
+  for (qint64 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+    Pk3Archive::Entry entry{};
+    stream >> entry.name >> entry.method >> entry.crc32 >>
+        entry.compressedSize >> entry.uncompressedSize;
+    entries.append(entry);
+  }
+}
+} // namespace
+
+bool Pk3Diff::read(const QString &path, Listing &listing, QString &error) {
+  Pk3Archive archive(path);
+
+  if (!archive.open()) {
+    error = archive.errorString();
+    return false;
+  }
+
+  listing.path = path;
+  listing.archiveSize = archive.size();
+  listing.modified = QFileInfo(path).lastModified().toMSecsSinceEpoch();
+  listing.entries = archive.entries();
+  return true;
+}
+
+Pk3Diff::Result Pk3Diff::compare(const Listing &before, const Listing &after) {
+  Result result{};
+  QHash<QString, const Pk3Archive::Entry *> previous{};
+  previous.reserve(before.entries.size());
+
+  for (const auto &entry : before.entries) {
+    if (!entry.isDirectory()) {
+      previous.insert(entry.name, &entry);
+    }
+  }
+
+  for (const auto &entry : after.entries) {
+    if (entry.isDirectory()) {
+      continue;
+    }
+
+    Difference difference{};
+    difference.name = entry.name;
+    difference.sizeAfter = static_cast<qint64>(entry.uncompressedSize);
+    difference.compressedAfter = static_cast<qint64>(entry.compressedSize);
+
+    const auto *old = previous.take(entry.name);
+
+    if (!old) {
+      difference.change = ADDED;
+    } else {
+      difference.sizeBefore = static_cast<qint64>(old->uncompressedSize);
+      difference.compressedBefore = static_cast<qint64>(old->compressedSize);
+
+      if (old->crc32 != entry.crc32 ||
+          old->uncompressedSize != entry.uncompressedSize) {
+        difference.change = CHANGED;
+      } else if (old->compressedSize != entry.compressedSize) {
+        difference.change = RECOMPRESSED;
+      } else {
+        result.unchanged++;
+        continue;
+      }
+    }
+
+    result.counts[difference.change]++;
+    result.differences.append(difference);
+  }
+
+  for (const auto *old : std::as_const(previous)) {
+    Difference difference{};
+    difference.change = REMOVED;
+    difference.name = old->name;
+    difference.sizeBefore = static_cast<qint64>(old->uncompressedSize);
+    difference.compressedBefore = static_cast<qint64>(old->compressedSize);
+
+    result.counts[REMOVED]++;
+    result.differences.append(difference);
+  }
+
+  std::sort(result.differences.begin(), result.differences.end(),
+            [](const Difference &a, const Difference &b) {
+              return a.name.compare(b.name, Qt::CaseInsensitive) < 0;
+            });
+  return result;
+}
+
+void Pk3Diff::savePrevious(const QString &path) {
+  if (!QFileInfo(path).isFile()) {
+    return;
+  }
+
+  Listing listing{};
+  QString error{};
+
+  if (!read(path, listing, error)) {
+    return;
+  }
+
+  // a run which didn't write a new pk3 shouldn't replace the previous build
+  // with the current one
+  Listing saved{};
+
+  if (loadPrevious(path, saved) && saved.archiveSize == listing.archiveSize &&
+      saved.modified == listing.modified) {
+    return;
+  }
+
+  QSaveFile file(previousListingPath(path));
+
+  if (!file.open(QIODevice::WriteOnly)) {
+    return;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+  stream << CACHE_MAGIC << CACHE_VERSION << listing.path
+         << listing.archiveSize << listing.modified;
+  writeEntries(stream, listing.entries);
+  file.commit();
+}
+
+bool Pk3Diff::loadPrevious(const QString &path, Listing &listing) {
+  QFile file(previousListingPath(path));
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+
+  quint32 magic{};
+  quint32 version{};
+  stream >> magic >> version;
+
+  if (magic != CACHE_MAGIC || version != CACHE_VERSION) {
+    return false;
+  }
+
+  Listing loaded{};
+  stream >> loaded.path >> loaded.archiveSize >> loaded.modified;
+  readEntries(stream, loaded.entries);
+
+  if (stream.status() != QDataStream::Ok) {
+    return false;
+  }
+
+  listing = loaded;
+  return true;
+}
+
+QString Pk3Diff::changeName(const Change change) {
+  switch (change) {
+  case ADDED:
+    return QObject::tr("Added");
+  case REMOVED:
+    return QObject::tr("Removed");
+  case CHANGED:
+    return QObject::tr("Changed");
+  case RECOMPRESSED:
+    return QObject::tr("Recompressed");
+  default:
+    return {};
+  }
+}
@@ -0,0 +1,78 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "pk3_archive.h"
+
+#include <QStringList>
+
+// Compares two pk3s by their central directories only, so nothing is
+// decompressed and even large archives are compared in milliseconds.
+// Entries are matched by name and compared by CRC32 and size.
+//
+// The central directory of a pk3 can be saved before it's rebuilt,
+// so that a new build can be compared against the previous one.
+class Pk3Diff {
+public:
+  enum Change {
+    ADDED,
+    REMOVED,
+    CHANGED,
+    RECOMPRESSED, // same contents, different compressed size
+
+    NUM_CHANGES // endcap
+  };
+
+  struct Listing {
+    QString path;
+    qint64 archiveSize{-1};
+    qint64 modified{}; // msecs since epoch
+    QList<Pk3Archive::Entry> entries;
+  };
+
+  struct Difference {
+    Change change{};
+    QString name;
+    qint64 sizeBefore{-1}; // -1 if the entry doesn't exist
+    qint64 sizeAfter{-1};
+    qint64 compressedBefore{-1};
+    qint64 compressedAfter{-1};
+  };
+
+  struct Result {
+    QList<Difference> differences; // sorted by name
+    qsizetype counts[NUM_CHANGES]{};
+    qsizetype unchanged{};
+  };
+
+  static bool read(const QString &path, Listing &listing, QString &error);
+  static Result compare(const Listing &before, const Listing &after);
+
+  // keeps the listing of 'path' as the previous build, if it exists
+  static void savePrevious(const QString &path);
+  static bool loadPrevious(const QString &path, Listing &listing);
+
+  static QString changeName(Change change);
+};
@@ -0,0 +1,209 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pk3_diff_dialog.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QLocale>
+
+namespace {
+// sorts by the number in Qt::UserRole instead of the formatted text
+class SizeItem : public QTableWidgetItem {
+public:
+  SizeItem(const QString &text, const qint64 size) : QTableWidgetItem(text) {
+    setData(Qt::UserRole, size);
+    setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+  }
+
+  bool operator<(const QTableWidgetItem &other) const override {
+    return data(Qt::UserRole).toLongLong() <
+           other.data(Qt::UserRole).toLongLong();
+  }
+};
+
+QString formatSize(const qint64 size) {
+  return size < 0 ? QString("-") : QLocale().formattedDataSize(size);
+}
+
+QString formatDelta(const qint64 delta) {
+  if (delta == 0) {
+    return "0";
+  }
+
+  return (delta > 0 ? "+" : "-") + QLocale().formattedDataSize(qAbs(delta));
+}
+
+QString describe(const Pk3Diff::Listing &listing) {
+  if (listing.archiveSize < 0) {
+    return QObject::tr("Nothing to compare, choose a pk3");
+  }
+
+  return QString("%1 (%2, %3)")
+      .arg(QDir::toNativeSeparators(listing.path),
+           QLocale().formattedDataSize(listing.archiveSize),
+           QDateTime::fromMSecsSinceEpoch(listing.modified)
+               .toString("yyyy-MM-dd HH:mm:ss"));
+}
+} // namespace
+
+Pk3DiffDialog::Pk3DiffDialog(QWidget *parent) : QDialog(parent) {
+  setWindowTitle(tr("Compare pk3s"));
+  setAttribute(Qt::WA_DeleteOnClose);
+  resize(900, 600);
+
+  layout = new QVBoxLayout(this);
+  pathLayout = new QGridLayout();
+
+  beforeLabel = new QLabel(this);
+  afterLabel = new QLabel(this);
+  beforeLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+  afterLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+  beforeButton = new QPushButton(tr("Choose..."), this);
+  afterButton = new QPushButton(tr("Choose..."), this);
+
+  pathLayout->addWidget(new QLabel(tr("Before:"), this), 0, 0);
+  pathLayout->addWidget(beforeLabel, 0, 1);
+  pathLayout->addWidget(beforeButton, 0, 2);
+  pathLayout->addWidget(new QLabel(tr("After:"), this), 1, 0);
+  pathLayout->addWidget(afterLabel, 1, 1);
+  pathLayout->addWidget(afterButton, 1, 2);
+  pathLayout->setColumnStretch(1, 1);
+
+  differenceTable = new QTableWidget(0, NUM_COLUMNS, this);
+  differenceTable->setHorizontalHeaderLabels(
+      {tr("Entry"), tr("Change"), tr("Size before"), tr("Size after"),
+       tr("Size change"), tr("Compressed change")});
+  differenceTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  differenceTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+  differenceTable->verticalHeader()->hide();
+  differenceTable->horizontalHeader()->setSectionResizeMode(
+      COLUMN_NAME, QHeaderView::Stretch);
+
+  statusLabel = new QLabel(this);
+  statusLabel->setWordWrap(true);
+
+  layout->addLayout(pathLayout);
+  layout->addWidget(differenceTable);
+  layout->addWidget(statusLabel);
+
+  connect(beforeButton, &QPushButton::released, this,
+          [&] { choose(beforeListing); });
+  connect(afterButton, &QPushButton::released, this,
+          [&] { choose(afterListing); });
+}
+
+void Pk3DiffDialog::compare(const Pk3Diff::Listing &before,
+                            const Pk3Diff::Listing &after) {
+  beforeListing = before;
+  afterListing = after;
+  updateDifferences();
+}
+
+void Pk3DiffDialog::choose(Pk3Diff::Listing &listing) {
+  const QString path = QFileDialog::getOpenFileName(
+      this, tr("Choose pk3"), QFileInfo(listing.path).absolutePath(),
+      tr("Pk3 files (*.pk3 *.zip)"));
+
+  if (path.isEmpty()) {
+    return;
+  }
+
+  Pk3Diff::Listing chosen{};
+  QString error{};
+
+  if (!Pk3Diff::read(path, chosen, error)) {
+    statusLabel->setText(tr("Unable to open %1: %2").arg(path, error));
+    return;
+  }
+
+  listing = chosen;
+  updateDifferences();
+}
+
+void Pk3DiffDialog::updateDifferences() {
+  beforeLabel->setText(describe(beforeListing));
+  afterLabel->setText(describe(afterListing));
+
+  differenceTable->setSortingEnabled(false);
+  differenceTable->setRowCount(0);
+
+  if (beforeListing.archiveSize < 0 || afterListing.archiveSize < 0) {
+    statusLabel->clear();
+    return;
+  }
+
+  QElapsedTimer timer{};
+  timer.start();
+  const Pk3Diff::Result result = Pk3Diff::compare(beforeListing, afterListing);
+  const qint64 elapsed = timer.elapsed();
+
+  differenceTable->setRowCount(static_cast<int>(result.differences.size()));
+
+  for (int row = 0; row < result.differences.size(); row++) {
+    const auto &difference = result.differences[row];
+    const qint64 sizeDelta = qMax(0LL, difference.sizeAfter) -
+                             qMax(0LL, difference.sizeBefore);
+    const qint64 compressedDelta = qMax(0LL, difference.compressedAfter) -
+                                   qMax(0LL, difference.compressedBefore);
+
+    differenceTable->setItem(row, COLUMN_NAME,
+                             new QTableWidgetItem(difference.name));
+    differenceTable->setItem(
+        row, COLUMN_CHANGE,
+        new QTableWidgetItem(Pk3Diff::changeName(difference.change)));
+    differenceTable->setItem(row, COLUMN_SIZE_BEFORE,
+                             new SizeItem(formatSize(difference.sizeBefore),
+                                          difference.sizeBefore));
+    differenceTable->setItem(row, COLUMN_SIZE_AFTER,
+                             new SizeItem(formatSize(difference.sizeAfter),
+                                          difference.sizeAfter));
+    differenceTable->setItem(row, COLUMN_SIZE_DELTA,
+                             new SizeItem(formatDelta(sizeDelta), sizeDelta));
+    differenceTable->setItem(
+        row, COLUMN_COMPRESSED_DELTA,
+        new SizeItem(formatDelta(compressedDelta), compressedDelta));
+  }
+
+  differenceTable->setSortingEnabled(true);
+  differenceTable->resizeColumnsToContents();
+  differenceTable->horizontalHeader()->setSectionResizeMode(
+      COLUMN_NAME, QHeaderView::Stretch);
+
+  statusLabel->setText(
+      tr("%1 added, %2 removed, %3 changed, %4 recompressed, %5 unchanged. "
+         "Size of the pk3 changed by %6. Compared in %7 ms.")
+          .arg(result.counts[Pk3Diff::ADDED])
+          .arg(result.counts[Pk3Diff::REMOVED])
+          .arg(result.counts[Pk3Diff::CHANGED])
+          .arg(result.counts[Pk3Diff::RECOMPRESSED])
+          .arg(result.unchanged)
+          .arg(formatDelta(afterListing.archiveSize -
+                           beforeListing.archiveSize))
+          .arg(elapsed));
+}
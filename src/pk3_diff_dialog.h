@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "pk3_diff.h"
+
+#include <QDialog>
+#include <QGridLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+// Lists the entries which were added, removed or changed between two pk3s,
+// with the change in size of each entry and of the whole pk3
+class Pk3DiffDialog : public QDialog {
+  Q_OBJECT
+
+public:
+  explicit Pk3DiffDialog(QWidget *parent);
+
+  void compare(const Pk3Diff::Listing &before, const Pk3Diff::Listing &after);
+
+private:
+  enum Columns {
+    COLUMN_NAME,
+    COLUMN_CHANGE,
+    COLUMN_SIZE_BEFORE,
+    COLUMN_SIZE_AFTER,
+    COLUMN_SIZE_DELTA,
+    COLUMN_COMPRESSED_DELTA,
+
+    NUM_COLUMNS // endcap
+  };
+
+  void choose(Pk3Diff::Listing &listing);
+  void updateDifferences();
+
+  Pk3Diff::Listing beforeListing;
+  Pk3Diff::Listing afterListing;
+
+  QVBoxLayout *layout{};
+  QGridLayout *pathLayout{};
+  QLabel *beforeLabel{};
+  QLabel *afterLabel{};
+  QPushButton *beforeButton{};
+  QPushButton *afterButton{};
+  QTableWidget *differenceTable{};
+  QLabel *statusLabel{};
+};
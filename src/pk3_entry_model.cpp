@@ -0,0 +1,390 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pk3_entry_model.h"
+
+#include <QApplication>
+#include <QLocale>
+#include <QStyle>
+#include <algorithm>
+#include <numeric>
+
+namespace {
+constexpr qsizetype ROOT = 0;
+
+QString methodName(const quint16 method) {
+  switch (method) {
+  case Pk3Archive::STORED:
+    return QObject::tr("Stored");
+  case Pk3Archive::DEFLATED:
+    return QObject::tr("Deflated");
+  default:
+    return QObject::tr("Method %1").arg(method);
+  }
+}
+} // namespace
+
+Pk3EntryModel::Pk3EntryModel(QObject *parent)
+    : QAbstractItemModel(parent),
+      directoryIcon(QApplication::style()->standardIcon(QStyle::SP_DirIcon)),
+      fileIcon(QApplication::style()->standardIcon(QStyle::SP_FileIcon)) {}
+
+bool Pk3EntryModel::open(const QString &path, QString &error) {
+  auto newArchive = std::make_unique<Pk3Archive>(path);
+
+  if (!newArchive->open()) {
+    error = newArchive->errorString();
+    return false;
+  }
+
+  beginResetModel();
+  archive = std::move(newArchive);
+
+  const auto &entries = archive->entries();
+  sorted.resize(entries.size());
+  std::iota(sorted.begin(), sorted.end(), 0);
+
+  // paths sharing a directory end up next to each other,
+  // case-insensitively like the game looks them up
+  std::sort(sorted.begin(), sorted.end(),
+            [&entries](const qsizetype a, const qsizetype b) {
+              return QString::compare(entries[a].name, entries[b].name,
+                                      Qt::CaseInsensitive) < 0;
+            });
+
+  sizeTotal = 0;
+  compressedTotal = 0;
+
+  for (const auto &entry : entries) {
+    sizeTotal += entry.uncompressedSize;
+    compressedTotal += entry.compressedSize;
+  }
+
+  currentFilter.clear();
+  resetNodes();
+  endResetModel();
+  return true;
+}
+
+void Pk3EntryModel::setFilter(const QString &filter) {
+  if (filter == currentFilter) {
+    return;
+  }
+
+  beginResetModel();
+  currentFilter = filter;
+  resetNodes();
+  endResetModel();
+}
+
+qsizetype Pk3EntryModel::entryCount() const { return sorted.size(); }
+
+qsizetype Pk3EntryModel::matchCount() const {
+  return currentFilter.isEmpty() ? sorted.size()
+                                 : nodes[ROOT].children.size();
+}
+
+quint64 Pk3EntryModel::totalSize() const { return sizeTotal; }
+
+quint64 Pk3EntryModel::totalCompressedSize() const { return compressedTotal; }
+
+QModelIndex Pk3EntryModel::index(const int row, const int column,
+                                 const QModelIndex &parent) const {
+  const qsizetype parentNode = nodeIndex(parent);
+
+  if (parentNode < 0 || row < 0 || column < 0 || column >= NUM_COLUMNS ||
+      row >= nodes[parentNode].children.size()) {
+    return {};
+  }
+
+  return createIndex(row, column,
+                     static_cast<quintptr>(nodes[parentNode].children[row]));
+}
+
+QModelIndex Pk3EntryModel::parent(const QModelIndex &child) const {
+  const qsizetype node = nodeIndex(child);
+
+  if (node <= ROOT || nodes[node].parent <= ROOT) {
+    return {};
+  }
+
+  const qsizetype parentNode = nodes[node].parent;
+  return createIndex(nodes[parentNode].row, 0,
+                     static_cast<quintptr>(parentNode));
+}
+
+int Pk3EntryModel::rowCount(const QModelIndex &parent) const {
+  if (parent.column() > 0) {
+    return 0;
+  }
+
+  const qsizetype node = nodeIndex(parent);
+  return node < 0 ? 0 : static_cast<int>(nodes[node].children.size());
+}
+
+int Pk3EntryModel::columnCount(const QModelIndex &) const {
+  return NUM_COLUMNS;
+}
+
+QVariant Pk3EntryModel::data(const QModelIndex &index, const int role) const {
+  const qsizetype nodeIdx = nodeIndex(index);
+
+  if (nodeIdx <= ROOT) {
+    return {};
+  }
+
+  const Node &node = nodes[nodeIdx];
+  const bool isFile = node.entry != -1;
+
+  if (role == Qt::DecorationRole && index.column() == COLUMN_NAME) {
+    return isFile ? fileIcon : directoryIcon;
+  }
+
+  if (role == Qt::ToolTipRole && isFile) {
+    return archive->entries()[node.entry].name;
+  }
+
+  if (role == Qt::TextAlignmentRole && index.column() != COLUMN_NAME &&
+      index.column() != COLUMN_METHOD) {
+    return static_cast<int>(Qt::AlignRight | Qt::AlignVCenter);
+  }
+
+  if (role != Qt::DisplayRole) {
+    return {};
+  }
+
+  switch (index.column()) {
+  case COLUMN_NAME:
+    return node.name;
+  case COLUMN_SIZE:
+    return QLocale().formattedDataSize(static_cast<qint64>(node.size));
+  case COLUMN_COMPRESSED:
+    return QLocale().formattedDataSize(
+        static_cast<qint64>(node.compressedSize));
+  case COLUMN_RATIO:
+    if (node.size == 0) {
+      return QString("-");
+    }
+
+    return QString("%1%").arg(100.0 * static_cast<double>(node.compressedSize) /
+                                  static_cast<double>(node.size),
+                              0, 'f', 1);
+  case COLUMN_METHOD:
+    return isFile ? methodName(archive->entries()[node.entry].method)
+                  : QString();
+  default:
+    return {};
+  }
+}
+
+QVariant Pk3EntryModel::headerData(const int section,
+                                   const Qt::Orientation orientation,
+                                   const int role) const {
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+    return {};
+  }
+
+  switch (section) {
+  case COLUMN_NAME:
+    return tr("Name");
+  case COLUMN_SIZE:
+    return tr("Size");
+  case COLUMN_COMPRESSED:
+    return tr("Compressed");
+  case COLUMN_RATIO:
+    return tr("Ratio");
+  case COLUMN_METHOD:
+    return tr("Method");
+  default:
+    return {};
+  }
+}
+
+bool Pk3EntryModel::hasChildren(const QModelIndex &parent) const {
+  const qsizetype node = nodeIndex(parent);
+  return node >= 0 && nodes[node].entry == -1 &&
+         (!nodes[node].fetched || !nodes[node].children.isEmpty());
+}
+
+bool Pk3EntryModel::canFetchMore(const QModelIndex &parent) const {
+  const qsizetype node = nodeIndex(parent);
+  return node >= 0 && nodes[node].entry == -1 && !nodes[node].fetched;
+}
+
+void Pk3EntryModel::fetchMore(const QModelIndex &parent) {
+  const qsizetype node = nodeIndex(parent);
+
+  if (node < 0 || nodes[node].fetched) {
+    return;
+  }
+
+  QList<Node> children = splitDirectory(nodes[node]);
+  nodes[node].fetched = true;
+
+  if (children.isEmpty()) {
+    return;
+  }
+
+  beginInsertRows(parent, 0, static_cast<int>(children.size() - 1));
+
+  for (auto &child : children) {
+    child.parent = node;
+    nodes[node].children.append(nodes.size());
+    nodes.append(std::move(child));
+  }
+
+  endInsertRows();
+}
+
+void Pk3EntryModel::resetNodes() {
+  nodes.clear();
+
+  Node root{};
+  root.first = 0;
+  root.last = sorted.size();
+  root.size = sizeTotal;
+  root.compressedSize = compressedTotal;
+  nodes.append(root);
+
+  if (!archive) {
+    return;
+  }
+
+  const auto &entries = archive->entries();
+
+  if (currentFilter.isEmpty()) {
+    QList<Node> children = splitDirectory(nodes[ROOT]);
+
+    for (auto &child : children) {
+      child.parent = ROOT;
+      nodes[ROOT].children.append(nodes.size());
+      nodes.append(std::move(child));
+    }
+
+    nodes[ROOT].fetched = true;
+    return;
+  }
+
+  const QString filter = currentFilter.startsWith("*.")
+                             ? currentFilter.mid(1)
+                             : currentFilter;
+  const bool isExtension = filter.startsWith('.');
+
+  for (const auto i : sorted) {
+    const Pk3Archive::Entry &entry = entries[i];
+
+    if (entry.isDirectory()) {
+      continue;
+    }
+
+    if (isExtension ? !entry.name.endsWith(filter, Qt::CaseInsensitive)
+                    : !entry.name.contains(filter, Qt::CaseInsensitive)) {
+      continue;
+    }
+
+    Node node{};
+    node.name = entry.name;
+    node.parent = ROOT;
+    node.row = static_cast<int>(nodes[ROOT].children.size());
+    node.entry = i;
+    node.size = entry.uncompressedSize;
+    node.compressedSize = entry.compressedSize;
+    nodes[ROOT].children.append(nodes.size());
+    nodes.append(std::move(node));
+  }
+
+  nodes[ROOT].fetched = true;
+}
+
+// directories are listed before files, both in path order
+QList<Pk3EntryModel::Node>
+Pk3EntryModel::splitDirectory(const Node &directory) const {
+  const auto &entries = archive->entries();
+  QList<Node> directories{};
+  QList<Node> files{};
+  qsizetype i = directory.first;
+
+  while (i < directory.last) {
+    const Pk3Archive::Entry &entry = entries[sorted[i]];
+    const QStringView rest =
+        QStringView(entry.name).mid(directory.prefixLength);
+    const qsizetype slash = rest.indexOf('/');
+
+    // explicit entry of the directory itself
+    if (rest.isEmpty()) {
+      i++;
+      continue;
+    }
+
+    if (slash == -1) {
+      Node file{};
+      file.name = rest.toString();
+      file.entry = sorted[i];
+      file.size = entry.uncompressedSize;
+      file.compressedSize = entry.compressedSize;
+      files.append(std::move(file));
+      i++;
+      continue;
+    }
+
+    Node subdirectory{};
+    subdirectory.name = rest.left(slash).toString();
+    subdirectory.first = i;
+    subdirectory.prefixLength = directory.prefixLength + slash + 1;
+
+    const QStringView prefix = QStringView(entry.name).left(
+        subdirectory.prefixLength);
+
+    while (i < directory.last &&
+           QStringView(entries[sorted[i]].name)
+               .startsWith(prefix, Qt::CaseInsensitive)) {
+      subdirectory.size += entries[sorted[i]].uncompressedSize;
+      subdirectory.compressedSize += entries[sorted[i]].compressedSize;
+      i++;
+    }
+
+    subdirectory.last = i;
+    directories.append(std::move(subdirectory));
+  }
+
+  directories.append(files);
+
+  for (qsizetype row = 0; row < directories.size(); row++) {
+    directories[row].row = static_cast<int>(row);
+  }
+
+  return directories;
+}
+
+qsizetype Pk3EntryModel::nodeIndex(const QModelIndex &index) const {
+  if (nodes.isEmpty()) {
+    return -1;
+  }
+
+  if (!index.isValid()) {
+    return ROOT;
+  }
+
+  return static_cast<qsizetype>(index.internalId());
+}
@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "pk3_archive.h"
+
+#include <QAbstractItemModel>
+#include <QIcon>
+#include <memory>
+
+// Tree of the entries of a pk3, built from its central directory only.
+//
+// Entries are sorted by path once when the pk3 is opened, so every
+// directory covers a contiguous range of entries. The children of
+// a directory are only split out of its range when it's expanded,
+// so opening a pk3 doesn't depend on how many directories it has.
+//
+// With a filter set, matching entries are shown as a flat list instead.
+class Pk3EntryModel : public QAbstractItemModel {
+  Q_OBJECT
+
+public:
+  enum Columns {
+    COLUMN_NAME,
+    COLUMN_SIZE,
+    COLUMN_COMPRESSED,
+    COLUMN_RATIO,
+    COLUMN_METHOD,
+
+    NUM_COLUMNS // endcap
+  };
+
+  explicit Pk3EntryModel(QObject *parent);
+
+  bool open(const QString &path, QString &error);
+
+  // matches paths containing 'filter', or ending with it if it's
+  // an extension such as '*.tga' or '.tga'
+  void setFilter(const QString &filter);
+
+  qsizetype entryCount() const;
+  qsizetype matchCount() const;
+  quint64 totalSize() const;
+  quint64 totalCompressedSize() const;
+
+  QModelIndex index(int row, int column,
+                    const QModelIndex &parent = {}) const override;
+  QModelIndex parent(const QModelIndex &child) const override;
+  int rowCount(const QModelIndex &parent = {}) const override;
+  int columnCount(const QModelIndex &parent = {}) const override;
+  QVariant data(const QModelIndex &index, int role) const override;
+  QVariant headerData(int section, Qt::Orientation orientation,
+                      int role) const override;
+
+  bool hasChildren(const QModelIndex &parent = {}) const override;
+  bool canFetchMore(const QModelIndex &parent) const override;
+  void fetchMore(const QModelIndex &parent) override;
+
+private:
+  struct Node {
+    QString name;
+    qsizetype parent{-1};
+    int row{};
+    qsizetype entry{-1}; // -1 for directories
+
+    // range of 'sorted' under a directory, and the length of its path
+    qsizetype first{};
+    qsizetype last{};
+    qsizetype prefixLength{};
+
+    quint64 size{};
+    quint64 compressedSize{};
+    QList<qsizetype> children;
+    bool fetched{};
+  };
+
+  void resetNodes();
+  QList<Node> splitDirectory(const Node &directory) const;
+  qsizetype nodeIndex(const QModelIndex &index) const;
+
+  std::unique_ptr<Pk3Archive> archive;
+  QList<qsizetype> sorted;
+  QList<Node> nodes;
+  QString currentFilter;
+  quint64 sizeTotal{};
+  quint64 compressedTotal{};
+
+  QIcon directoryIcon;
+  QIcon fileIcon;
+};
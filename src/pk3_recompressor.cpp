@@ -0,0 +1,223 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pk3_recompressor.h"
+#include "pk3_archive.h"
+#include "pk3_writer.h"
+
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <numeric>
+
+#ifdef QTPACK3R_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+// already compressed formats, deflating these again only wastes time
+const QStringList incompressibleSuffixes = {
+    "jpg", "jpeg", "png", "ogg", "mp3", "roq", "pk3", "zip", "gz", "7z",
+};
+
+#ifdef QTPACK3R_HAVE_ZLIB
+// compressing everything at once would keep the whole pk3 in memory,
+// so entries are compressed in batches of roughly this many bytes
+constexpr quint64 BATCH_SIZE = 128 * 1024 * 1024;
+
+struct CompressedEntry {
+  Pk3Archive::Entry entry;
+  QByteArray data;
+  QString error;
+};
+
+bool deflateRaw(const QByteArrayView input, const int level, QByteArray &out) {
+  z_stream stream{};
+
+  if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+
+  // output buffer is large enough for a single deflate() call
+  out.resize(static_cast<qsizetype>(
+      deflateBound(&stream, static_cast<uLong>(input.size()))));
+
+  stream.next_in =
+      reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+  stream.avail_in = static_cast<uInt>(input.size());
+  stream.next_out = reinterpret_cast<Bytef *>(out.data());
+  stream.avail_out = static_cast<uInt>(out.size());
+
+  const int ret = deflate(&stream, Z_FINISH);
+  out.resize(out.size() - stream.avail_out);
+  deflateEnd(&stream);
+
+  return ret == Z_STREAM_END;
+}
+
+CompressedEntry compressEntry(const Pk3Archive &archive,
+                              const Pk3Archive::Entry &entry, const int level,
+                              const bool incompressible) {
+  CompressedEntry result{};
+  result.entry = entry;
+
+  QByteArray contents{};
+
+  if (!archive.extract(entry, contents, &result.error)) {
+    result.error = entry.name + ": " + result.error;
+    return result;
+  }
+
+  // don't turn a corrupt entry into a valid looking one
+  if (Pk3Archive::crc32(contents) != entry.crc32) {
+    result.error = QObject::tr("%1: CRC mismatch").arg(entry.name);
+    return result;
+  }
+
+  if (!incompressible && !contents.isEmpty() &&
+      deflateRaw(contents, level, result.data) &&
+      result.data.size() < contents.size()) {
+    result.entry.method = Pk3Archive::DEFLATED;
+    result.entry.compressedSize = result.data.size();
+    return result;
+  }
+
+  result.entry.method = Pk3Archive::STORED;
+  result.entry.compressedSize = contents.size();
+  result.data = contents;
+  return result;
+}
+#endif
+} // namespace
+
+bool Pk3Recompressor::isAvailable() {
+#ifdef QTPACK3R_HAVE_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool Pk3Recompressor::isIncompressible(const QString &name) {
+  return incompressibleSuffixes.contains(QFileInfo(name).suffix(),
+                                         Qt::CaseInsensitive);
+}
+
+bool Pk3Recompressor::recompress(const QString &path, const int level,
+                                 Report &report, QString &error) {
+#ifdef QTPACK3R_HAVE_ZLIB
+  QSaveFile output(path);
+
+  if (!output.open(QIODevice::WriteOnly)) {
+    error = output.errorString();
+    return false;
+  }
+
+  report = {};
+
+  // the original has to be closed before it can be replaced on Windows
+  {
+    Pk3Archive archive(path);
+
+    if (!archive.open()) {
+      error = archive.errorString();
+      output.cancelWriting();
+      return false;
+    }
+
+    report.sizeBefore = archive.size();
+
+    const auto &entries = archive.entries();
+    Pk3Writer writer(&output);
+    qsizetype batchStart = 0;
+
+    while (batchStart < entries.size()) {
+      qsizetype batchEnd = batchStart;
+      quint64 batchBytes = 0;
+
+      while (batchEnd < entries.size() &&
+             (batchEnd == batchStart || batchBytes < BATCH_SIZE)) {
+        batchBytes += entries[batchEnd].uncompressedSize;
+        batchEnd++;
+      }
+
+      QList<qsizetype> batch(batchEnd - batchStart);
+      std::iota(batch.begin(), batch.end(), batchStart);
+
+      // entries are written in the original order, only compression
+      // happens in parallel
+      const auto results =
+          QtConcurrent::blockingMapped<QList<CompressedEntry>>(
+              batch, [&archive, &entries, level](const qsizetype index) {
+                return compressEntry(archive, entries[index], level,
+                                     isIncompressible(entries[index].name));
+              });
+
+      for (const auto &result : results) {
+        if (!result.error.isEmpty()) {
+          error = result.error;
+          output.cancelWriting();
+          return false;
+        }
+
+        if (!writer.addEntry(result.entry, result.data)) {
+          error = writer.errorString();
+          output.cancelWriting();
+          return false;
+        }
+
+        if (result.entry.method == Pk3Archive::DEFLATED) {
+          report.deflatedCount++;
+        } else {
+          report.storedCount++;
+        }
+      }
+
+      batchStart = batchEnd;
+    }
+
+    if (!writer.finish()) {
+      error = writer.errorString();
+      output.cancelWriting();
+      return false;
+    }
+
+    report.sizeAfter = writer.bytesWritten();
+  }
+
+  if (!output.commit()) {
+    error = output.errorString();
+    return false;
+  }
+
+  return true;
+#else
+  Q_UNUSED(path)
+  Q_UNUSED(level)
+  Q_UNUSED(report)
+  error = QObject::tr("%1 was built without zlib").arg(PROJECT_NAME);
+  return false;
+#endif
+}
@@ -0,0 +1,49 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QStringList>
+
+// Rewrites a pk3 with every entry compressed at the given level, compressing
+// entries in parallel. Formats which are already compressed are stored,
+// as are entries which deflate wouldn't make any smaller.
+class Pk3Recompressor {
+public:
+  struct Report {
+    quint64 sizeBefore{};
+    quint64 sizeAfter{};
+    qsizetype deflatedCount{};
+    qsizetype storedCount{};
+  };
+
+  // the pk3 is only replaced once the new one has been fully written
+  static bool recompress(const QString &path, int level, Report &report,
+                         QString &error);
+
+  static bool isAvailable();
+
+private:
+  static bool isIncompressible(const QString &name);
+};
@@ -0,0 +1,150 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pk3_verifier.h"
+#include "pk3_archive.h"
+
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <algorithm>
+#include <numeric>
+
+namespace {
+enum EntryStatus {
+  ENTRY_OK,
+  ENTRY_FAILED,
+  ENTRY_SKIPPED,
+};
+
+struct EntryResult {
+  EntryStatus status{};
+  QString message;
+};
+} // namespace
+
+bool Pk3Verifier::verify(const QString &path, Report &report, QString &error) {
+  Pk3Archive archive(path);
+
+  if (!archive.open()) {
+    error = archive.errorString();
+    return false;
+  }
+
+  const auto &entries = archive.entries();
+  QList<qsizetype> order(entries.size());
+  std::iota(order.begin(), order.end(), 0);
+
+  // start with the largest entries, so a big entry picked up last
+  // doesn't leave a single thread running long after the others finish
+  std::sort(order.begin(), order.end(), [&entries](auto a, auto b) {
+    return entries[a].compressedSize > entries[b].compressedSize;
+  });
+
+  const auto results = QtConcurrent::blockingMapped<QList<EntryResult>>(
+      order, [&archive, &entries](const qsizetype index) -> EntryResult {
+        const auto &entry = entries[index];
+
+        if (entry.isDirectory()) {
+          return {};
+        }
+
+        if (!Pk3Archive::canDecompress(entry.method)) {
+          return {ENTRY_SKIPPED, {}};
+        }
+
+        quint32 crc = 0;
+        QString entryError{};
+
+        if (!archive.checksum(entry, crc, &entryError)) {
+          return {ENTRY_FAILED, entry.name + ": " + entryError};
+        }
+
+        if (crc != entry.crc32) {
+          return {ENTRY_FAILED,
+                  QObject::tr("%1: CRC mismatch (expected %2, got %3)")
+                      .arg(entry.name)
+                      .arg(entry.crc32, 8, 16, QChar('0'))
+                      .arg(crc, 8, 16, QChar('0'))};
+        }
+
+        return {};
+      });
+
+  report = {};
+  report.entryCount = entries.size();
+
+  for (const auto &entry : entries) {
+    report.compressedTotal += entry.compressedSize;
+    report.uncompressedTotal += entry.uncompressedSize;
+  }
+
+  for (const auto &result : results) {
+    if (result.status == ENTRY_FAILED) {
+      report.failures.append(result.message);
+    } else if (result.status == ENTRY_SKIPPED) {
+      report.skippedCount++;
+    }
+  }
+
+  report.failures.sort();
+  return true;
+}
+
+QByteArray Pk3Verifier::sha256(const QString &path) {
+  QFile file(path);
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    return {};
+  }
+
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+
+  if (!hash.addData(&file)) {
+    return {};
+  }
+
+  return hash.result().toHex();
+}
+
+bool Pk3Verifier::writeManifest(const QString &path, const QByteArray &hash,
+                                QString &error) {
+  QSaveFile manifest(path + ".sha256");
+
+  if (!manifest.open(QIODevice::WriteOnly)) {
+    error = manifest.errorString();
+    return false;
+  }
+
+  // same format as 'sha256sum', so it can be checked with 'sha256sum -c'
+  manifest.write(hash + "  " + QFileInfo(path).fileName().toUtf8() + "\n");
+
+  if (!manifest.commit()) {
+    error = manifest.errorString();
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,54 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QStringList>
+
+// Checks the integrity of a packed pk3 by comparing the CRC32 of every entry
+// against the central directory, and creates checksum manifests for it.
+class Pk3Verifier {
+public:
+  struct Report {
+    qsizetype entryCount{};
+    quint64 compressedTotal{};
+    quint64 uncompressedTotal{};
+
+    // "name: reason" for each entry which failed the check
+    QStringList failures;
+
+    // entries using a compression method we can't decompress
+    qsizetype skippedCount{};
+  };
+
+  // checks entries in parallel, returns false if the archive can't be read
+  static bool verify(const QString &path, Report &report, QString &error);
+
+  // lowercase hex SHA-256 of the file, empty if it can't be read
+  static QByteArray sha256(const QString &path);
+
+  // writes '<path>.sha256' in the same format as 'sha256sum'
+  static bool writeManifest(const QString &path, const QByteArray &hash,
+                            QString &error);
+};
@@ -0,0 +1,160 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pk3_writer.h"
+
+#include <QtEndian>
+
+namespace {
+constexpr quint32 LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr quint32 CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr quint32 EOCD_SIGNATURE = 0x06054b50;
+
+// 2.0, the first version with deflate and directories
+constexpr quint16 ZIP_VERSION = 20;
+constexpr quint32 MAX_ZIP32 = 0xffffffff;
+constexpr quint32 MSDOS_DIRECTORY_ATTRIBUTE = 0x10;
+
+constexpr quint16 FLAG_DATA_DESCRIPTOR = 0x0008;
+constexpr quint16 FLAG_UTF8 = 0x0800;
+
+template <typename T> void append(QByteArray &buffer, const T value) {
+  const T le = qToLittleEndian(value);
+  buffer.append(reinterpret_cast<const char *>(&le), sizeof(T));
+}
+} // namespace
+
+Pk3Writer::Pk3Writer(QIODevice *device) : out(device) {}
+
+bool Pk3Writer::addEntry(const Pk3Archive::Entry &entry,
+                         const QByteArrayView data) {
+  if (entry.compressedSize > MAX_ZIP32 || entry.uncompressedSize > MAX_ZIP32 ||
+      offset > MAX_ZIP32) {
+    error = QObject::tr("%1 doesn't fit in a pk3 without zip64")
+                .arg(entry.name);
+    return false;
+  }
+
+  Pk3Archive::Entry written = entry;
+  written.localHeaderOffset = offset;
+
+  // sizes are always in the local header, and names are always UTF-8
+  const QByteArray name = entry.name.toUtf8();
+  written.flags = static_cast<quint16>(written.flags &
+                                       ~(FLAG_DATA_DESCRIPTOR | FLAG_UTF8));
+
+  if (name.size() != entry.name.size()) {
+    written.flags |= FLAG_UTF8;
+  }
+
+  QByteArray header{};
+  header.reserve(30 + name.size());
+
+  append<quint32>(header, LOCAL_HEADER_SIGNATURE);
+  append<quint16>(header, ZIP_VERSION);
+  append<quint16>(header, written.flags);
+  append<quint16>(header, written.method);
+  append<quint32>(header, written.modified);
+  append<quint32>(header, written.crc32);
+  append<quint32>(header, static_cast<quint32>(written.compressedSize));
+  append<quint32>(header, static_cast<quint32>(written.uncompressedSize));
+  append<quint16>(header, static_cast<quint16>(name.size()));
+  append<quint16>(header, 0); // extra field length
+  header.append(name);
+
+  if (!write(header) || !write(data)) {
+    return false;
+  }
+
+  writtenEntries.append(written);
+  return true;
+}
+
+bool Pk3Writer::finish() {
+  const quint64 centralDirectoryOffset = offset;
+
+  for (const auto &entry : writtenEntries) {
+    const QByteArray name = entry.name.toUtf8();
+    QByteArray header{};
+    header.reserve(46 + name.size());
+
+    append<quint32>(header, CENTRAL_HEADER_SIGNATURE);
+    append<quint16>(header, ZIP_VERSION); // version made by, MS-DOS
+    append<quint16>(header, ZIP_VERSION);
+    append<quint16>(header, entry.flags);
+    append<quint16>(header, entry.method);
+    append<quint32>(header, entry.modified);
+    append<quint32>(header, entry.crc32);
+    append<quint32>(header, static_cast<quint32>(entry.compressedSize));
+    append<quint32>(header, static_cast<quint32>(entry.uncompressedSize));
+    append<quint16>(header, static_cast<quint16>(name.size()));
+    append<quint16>(header, 0); // extra field length
+    append<quint16>(header, 0); // comment length
+    append<quint16>(header, 0); // disk number
+    append<quint16>(header, 0); // internal attributes
+    append<quint32>(header,
+                    entry.isDirectory() ? MSDOS_DIRECTORY_ATTRIBUTE : 0);
+    append<quint32>(header, static_cast<quint32>(entry.localHeaderOffset));
+    header.append(name);
+
+    if (!write(header)) {
+      return false;
+    }
+  }
+
+  const quint64 centralDirectorySize = offset - centralDirectoryOffset;
+
+  if (writtenEntries.size() > 0xffff || centralDirectoryOffset > MAX_ZIP32) {
+    error = QObject::tr("Too many entries for a pk3 without zip64");
+    return false;
+  }
+
+  const auto count = static_cast<quint16>(writtenEntries.size());
+  QByteArray eocd{};
+
+  append<quint32>(eocd, EOCD_SIGNATURE);
+  append<quint16>(eocd, 0); // disk number
+  append<quint16>(eocd, 0); // disk with central directory
+  append<quint16>(eocd, count);
+  append<quint16>(eocd, count);
+  append<quint32>(eocd, static_cast<quint32>(centralDirectorySize));
+  append<quint32>(eocd, static_cast<quint32>(centralDirectoryOffset));
+  append<quint16>(eocd, 0); // comment length
+
+  return write(eocd);
+}
+
+QString Pk3Writer::errorString() const { return error; }
+
+quint64 Pk3Writer::bytesWritten() const { return offset; }
+
+bool Pk3Writer::write(const QByteArrayView data) {
+  if (out->write(data.data(), data.size()) != data.size()) {
+    error = out->errorString();
+    return false;
+  }
+
+  offset += data.size();
+  return true;
+}
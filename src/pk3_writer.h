@@ -0,0 +1,54 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "pk3_archive.h"
+
+#include <QIODevice>
+
+// Writes a pk3 (zip) archive sequentially to a device. Entry data must
+// already be compressed with the method set in the entry.
+//
+// Zip64 is not written, as the game can't read it anyway, so archives
+// and entries are limited to 4 GiB.
+class Pk3Writer {
+public:
+  explicit Pk3Writer(QIODevice *device);
+
+  // sizes, CRC32 and method are taken from the entry as is
+  bool addEntry(const Pk3Archive::Entry &entry, QByteArrayView data);
+  bool finish();
+
+  QString errorString() const;
+  quint64 bytesWritten() const;
+
+private:
+  bool write(QByteArrayView data);
+
+  QIODevice *out;
+  QList<Pk3Archive::Entry> writtenEntries;
+  quint64 offset{};
+  QString error;
+};
@@ -0,0 +1,220 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "post_pack_runner.h"
+#include "pk3_recompressor.h"
+#include "pk3_verifier.h"
+#include "preferences.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QLocale>
+#include <QtConcurrent>
+
+namespace {
+// listing thousands of failures isn't useful, the first few tell enough
+constexpr int MAX_LISTED_FAILURES = 50;
+
+QByteArray line(const QString &str) { return "[post-pack] " + str.toUtf8(); }
+} // namespace
+
+PostPackRunner::PostPackRunner(QObject *parent)
+    : QObject(parent), watcher(new QFutureWatcher<QByteArray>(this)) {
+  connect(watcher, &QFutureWatcher<QByteArray>::resultReadyAt, this,
+          [this](const int index) {
+            emit outputLine(watcher->resultAt(index));
+          });
+  connect(watcher, &QFutureWatcher<QByteArray>::finished, this,
+          [this] { emit finished(); });
+}
+
+bool PostPackRunner::run(const QString &pk3Path) {
+  Stages stages{};
+  stages.recompress =
+      preferences.readSetting(Preferences::Settings::POSTPACK_RECOMPRESS)
+          .toBool() &&
+      Pk3Recompressor::isAvailable();
+  stages.compressionLevel =
+      preferences.readSetting(Preferences::Settings::POSTPACK_COMPRESSION_LEVEL)
+          .toInt();
+  stages.verify =
+      preferences.readSetting(Preferences::Settings::POSTPACK_VERIFY).toBool();
+  stages.writeManifest =
+      preferences.readSetting(Preferences::Settings::POSTPACK_MANIFEST)
+          .toBool();
+
+  if (!stages.recompress && !stages.verify && !stages.writeManifest) {
+    return false;
+  }
+
+  if (isRunning() || !QFileInfo(pk3Path).isFile()) {
+    return false;
+  }
+
+  watcher->setFuture(QtConcurrent::run(&PostPackRunner::runStages, pk3Path,
+                                       stages));
+  return true;
+}
+
+void PostPackRunner::cancel() {
+  if (isRunning()) {
+    // results reported after canceling are discarded,
+    // so the stage can't report this itself
+    watcher->cancel();
+    emit outputLine(line(tr("Canceled")));
+  }
+}
+
+bool PostPackRunner::isRunning() const { return watcher->isRunning(); }
+
+void PostPackRunner::runStages(QPromise<QByteArray> &promise,
+                               const QString &pk3Path, const Stages &stages) {
+  QElapsedTimer timer{};
+  timer.start();
+
+  // verify what was written by the recompression, rather than the original
+  if (stages.recompress && !recompress(promise, pk3Path, stages)) {
+    return;
+  }
+
+  if (promise.isCanceled()) {
+    return;
+  }
+
+  if (stages.verify || stages.writeManifest) {
+    verify(promise, pk3Path, stages);
+  }
+
+  promise.addResult(line(QObject::tr("Finished in %1 s")
+                             .arg(timer.elapsed() / 1000.0, 0, 'f', 2)));
+}
+
+bool PostPackRunner::recompress(QPromise<QByteArray> &promise,
+                                const QString &pk3Path, const Stages &stages) {
+  const QLocale locale{};
+  QElapsedTimer timer{};
+  timer.start();
+
+  promise.addResult(line(QObject::tr("Recompressing %1 at level %2")
+                             .arg(QFileInfo(pk3Path).fileName())
+                             .arg(stages.compressionLevel)));
+
+  Pk3Recompressor::Report report{};
+  QString error{};
+
+  if (!Pk3Recompressor::recompress(pk3Path, stages.compressionLevel, report,
+                                   error)) {
+    promise.addResult(line(QObject::tr("Error: %1").arg(error)));
+    return false;
+  }
+
+  const auto before = static_cast<qint64>(report.sizeBefore);
+  const auto after = static_cast<qint64>(report.sizeAfter);
+  const double change =
+      before == 0 ? 0.0
+                  : 100.0 * static_cast<double>(after - before) /
+                        static_cast<double>(before);
+
+  promise.addResult(
+      line(QObject::tr("Size %1 -> %2 (%3%), %4 deflated, %5 stored, "
+                       "took %6 s")
+               .arg(locale.formattedDataSize(before),
+                    locale.formattedDataSize(after))
+               .arg(change, 0, 'f', 1)
+               .arg(report.deflatedCount)
+               .arg(report.storedCount)
+               .arg(timer.elapsed() / 1000.0, 0, 'f', 2)));
+  return true;
+}
+
+void PostPackRunner::verify(QPromise<QByteArray> &promise,
+                            const QString &pk3Path, const Stages &stages) {
+  const QLocale locale{};
+
+  // hashing the whole file is independent of the entries,
+  // so do it at the same time as the CRC checks
+  QFuture<QByteArray> hash{};
+
+  if (stages.writeManifest) {
+    hash = QtConcurrent::run(&Pk3Verifier::sha256, pk3Path);
+  }
+
+  if (stages.verify) {
+    promise.addResult(
+        line(QObject::tr("Verifying %1").arg(QFileInfo(pk3Path).fileName())));
+
+    Pk3Verifier::Report report{};
+    QString error{};
+
+    if (!Pk3Verifier::verify(pk3Path, report, error)) {
+      promise.addResult(line(QObject::tr("Error: %1").arg(error)));
+    } else {
+      for (qsizetype i = 0; i < report.failures.size(); i++) {
+        if (i == MAX_LISTED_FAILURES) {
+          promise.addResult(line(QObject::tr("... and %1 more")
+                                     .arg(report.failures.size() - i)));
+          break;
+        }
+
+        promise.addResult(line(QObject::tr("Error: %1")
+                                   .arg(report.failures[i])));
+      }
+
+      const double ratio =
+          report.uncompressedTotal == 0
+              ? 100.0
+              : 100.0 * static_cast<double>(report.compressedTotal) /
+                    static_cast<double>(report.uncompressedTotal);
+
+      promise.addResult(line(
+          QObject::tr("%1 entries, %2 corrupt, %3 skipped (unsupported "
+                      "compression)")
+              .arg(report.entryCount)
+              .arg(report.failures.size())
+              .arg(report.skippedCount)));
+      promise.addResult(line(
+          QObject::tr("Compressed %1, uncompressed %2, ratio %3%")
+              .arg(locale.formattedDataSize(
+                       static_cast<qint64>(report.compressedTotal)),
+                   locale.formattedDataSize(
+                       static_cast<qint64>(report.uncompressedTotal)))
+              .arg(ratio, 0, 'f', 1)));
+    }
+  }
+
+  if (stages.writeManifest) {
+    const QByteArray sha256 = hash.result();
+    QString error{};
+
+    if (sha256.isEmpty()) {
+      promise.addResult(
+          line(QObject::tr("Error: unable to read %1").arg(pk3Path)));
+    } else if (!Pk3Verifier::writeManifest(pk3Path, sha256, error)) {
+      promise.addResult(line(QObject::tr("Error: %1").arg(error)));
+    } else {
+      promise.addResult(line(QObject::tr("SHA-256 %1, written to %2.sha256")
+                                 .arg(QString::fromLatin1(sha256), pk3Path)));
+    }
+  }
+}
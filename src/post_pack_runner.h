@@ -0,0 +1,65 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QPromise>
+
+// Runs the optional stages enabled in preferences on the output pk3 after
+// a successful pack. Stages run on a worker thread, and report their
+// progress as lines of output as they go.
+class PostPackRunner : public QObject {
+  Q_OBJECT
+
+public:
+  explicit PostPackRunner(QObject *parent);
+
+  // returns false if there's nothing to run
+  bool run(const QString &pk3Path);
+  void cancel();
+  bool isRunning() const;
+
+signals:
+  void outputLine(const QByteArray &line);
+  void finished();
+
+private:
+  struct Stages {
+    bool recompress{};
+    int compressionLevel{};
+    bool verify{};
+    bool writeManifest{};
+  };
+
+  static void runStages(QPromise<QByteArray> &promise, const QString &pk3Path,
+                        const Stages &stages);
+  static bool recompress(QPromise<QByteArray> &promise,
+                         const QString &pk3Path, const Stages &stages);
+  static void verify(QPromise<QByteArray> &promise, const QString &pk3Path,
+                     const Stages &stages);
+
+  QFutureWatcher<QByteArray> *watcher;
+};
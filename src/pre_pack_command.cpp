@@ -0,0 +1,78 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pre_pack_command.h"
+#include "preferences.h"
+
+#include <QFileInfo>
+#include <QProcess>
+
+PrePackCommand::Command PrePackCommand::forMap(const QString &mapPath) {
+  if (!preferences.readSetting(Preferences::Settings::PREPACK_ENABLED)
+           .toBool()) {
+    return {};
+  }
+
+  return parse(
+      preferences.readSetting(Preferences::Settings::PREPACK_COMMAND)
+          .toString(),
+      mapPath);
+}
+
+// placeholders are replaced after splitting, so paths with spaces
+// stay a single argument without having to be quoted
+PrePackCommand::Command PrePackCommand::parse(const QString &commandLine,
+                                              const QString &mapPath) {
+  QStringList parts = QProcess::splitCommand(commandLine);
+
+  if (parts.isEmpty()) {
+    return {};
+  }
+
+  const QFileInfo map(mapPath);
+
+  for (auto &part : parts) {
+    part.replace("{map}", mapPath);
+    part.replace("{name}", map.completeBaseName());
+    part.replace("{maps}", map.absolutePath());
+  }
+
+  Command command{};
+  command.program = parts.takeFirst();
+  command.arguments = parts;
+  return command;
+}
+
+QString PrePackCommand::toString(const Command &command) {
+  QStringList parts = {command.program};
+  parts.append(command.arguments);
+
+  for (auto &part : parts) {
+    if (part.contains(' ')) {
+      part = '"' + part + '"';
+    }
+  }
+
+  return parts.join(' ');
+}
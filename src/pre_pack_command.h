@@ -0,0 +1,52 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QStringList>
+
+// External command run on a map before it's packed, usually a map compiler
+// producing the bsp Pack3r reads. Configured in preferences as a command
+// line with placeholders for the map, Pack3r is only run if it succeeds.
+class PrePackCommand {
+public:
+  struct Command {
+    QString program;
+    QStringList arguments;
+
+    bool isEmpty() const { return program.isEmpty(); }
+    bool operator==(const Command &other) const {
+      return program == other.program && arguments == other.arguments;
+    }
+  };
+
+  // the command from preferences for the map, empty if disabled
+  static Command forMap(const QString &mapPath);
+
+  // {map} is replaced with 'mapPath', {name} with the name of the map
+  // without the extension and {maps} with the directory of the map
+  static Command parse(const QString &commandLine, const QString &mapPath);
+
+  static QString toString(const Command &command);
+};
@@ -25,7 +25,10 @@
 #include "preferences.h"
 
 #include "filesystem.h"
+#include "pk3_recompressor.h"
+#include "process_priority.h"
 #include "qtpack3r_widget.h"
+#include "runtime_profile.h"
 
 #include <QApplication>
 #include <QDir>
@@ -99,17 +102,29 @@ void PreferencesDialog::buildPreferencesDialog() {
   pageList = new QListWidget(this);
   interfaceItem = new QListWidgetItem(tr("Interface"), pageList);
   pathsItem = new QListWidgetItem(tr("Paths"), pageList);
+  jobsItem = new QListWidgetItem(tr("Jobs"), pageList);
+  runtimeItem = new QListWidgetItem(tr("Runtime"), pageList);
+  postPackItem = new QListWidgetItem(tr("Post-pack"), pageList);
 
   pageList->addItem(interfaceItem);
   pageList->addItem(pathsItem);
+  pageList->addItem(jobsItem);
+  pageList->addItem(runtimeItem);
+  pageList->addItem(postPackItem);
 
   pages = new QStackedWidget(this);
 
   buildInterfacePage();
   buildPathsPage();
+  buildJobsPage();
+  buildRuntimePage();
+  buildPostPackPage();
 
   pages->insertWidget(0, interfacePage.widget);
   pages->insertWidget(1, pathsPage.widget);
+  pages->insertWidget(2, jobsPage.widget);
+  pages->insertWidget(3, runtimePage.widget);
+  pages->insertWidget(4, postPackPage.widget);
 
   resetDefaultsButton = new QPushButton(tr("Reset to defaults"), this);
   closeButton = new QPushButton(
@@ -150,8 +165,29 @@ void PreferencesDialog::buildInterfacePage() {
   interfacePage.windowSizeCheckbox->setToolTip(
       tr("Restore window size from previous session on startup"));
 
+  interfacePage.diagnosticsReportCheckbox = new QCheckBox(
+      tr("Report interface latency after each run"), interfacePage.groupBox);
+  interfacePage.diagnosticsReportCheckbox->setToolTip(
+      tr("Print event loop latency and time spent handling output to the "
+         "output after Pack3r finishes"));
+
+  interfacePage.diagnosticsStallsCheckbox = new QCheckBox(
+      tr("Include longest stalls in the report"), interfacePage.groupBox);
+  interfacePage.diagnosticsStallsCheckbox->setToolTip(
+      tr("List the longest periods the interface was unresponsive, and the "
+         "output handling that was running during them"));
+
+  interfacePage.diagnosticsTraceCheckbox = new QCheckBox(
+      tr("Write a timeline trace of each run"), interfacePage.groupBox);
+  interfacePage.diagnosticsTraceCheckbox->setToolTip(
+      tr("Save a trace of Pack3r phases, CPU usage and output handling, "
+         "which can be opened in Perfetto or chrome://tracing"));
+
   interfacePage.itemLayout = new QGridLayout(interfacePage.groupBox);
   interfacePage.itemLayout->addWidget(interfacePage.windowSizeCheckbox);
+  interfacePage.itemLayout->addWidget(interfacePage.diagnosticsReportCheckbox);
+  interfacePage.itemLayout->addWidget(interfacePage.diagnosticsStallsCheckbox);
+  interfacePage.itemLayout->addWidget(interfacePage.diagnosticsTraceCheckbox);
   interfacePage.itemLayout->setAlignment(Qt::AlignTop | Qt::AlignHCenter);
 
   interfacePage.widgetLayout = new QVBoxLayout(interfacePage.widget);
@@ -203,6 +239,381 @@ void PreferencesDialog::buildPathsPage() {
   pathsPage.widgetLayout->addWidget(pathsPage.groupBox);
 }
 
+void PreferencesDialog::buildJobsPage() {
+  jobsPage.widget = new QWidget(dialog);
+  jobsPage.groupBox = new QGroupBox(tr("Jobs"), jobsPage.widget);
+
+  jobsPage.useDaemonCheckbox =
+      new QCheckBox(tr("Submit jobs to local pack daemon"), jobsPage.groupBox);
+  jobsPage.useDaemonCheckbox->setToolTip(
+      tr("Run Pack3r through a daemon started with '%1 --daemon', which "
+         "limits the number of concurrent jobs machine-wide.\nIf no daemon is "
+         "running, Pack3r is run locally.")
+          .arg(PROJECT_NAME));
+
+  const QString maxConcurrentJobsTooltip =
+      tr("Maximum number of Pack3r processes to run at the same time");
+  jobsPage.maxConcurrentJobsLabel = new QLabel(tr("Concurrent jobs"));
+  jobsPage.maxConcurrentJobsLabel->setToolTip(maxConcurrentJobsTooltip);
+
+  jobsPage.maxConcurrentJobsSpinbox = new QSpinBox(jobsPage.groupBox);
+  jobsPage.maxConcurrentJobsSpinbox->setToolTip(maxConcurrentJobsTooltip);
+  jobsPage.maxConcurrentJobsSpinbox->setRange(1, 256);
+
+  jobsPage.speculativeDryRunCheckbox = new QCheckBox(
+      tr("Dry run selected maps in the background"), jobsPage.groupBox);
+  jobsPage.speculativeDryRunCheckbox->setToolTip(
+      tr("Start a dry run with the background priority as soon as a map is "
+         "selected, so the asset list and the output of a dry run are ready "
+         "when they're needed.\nThe dry run is canceled when the map or the "
+         "options change."));
+
+  jobsPage.itemLayout = new QGridLayout(jobsPage.groupBox);
+
+  jobsPage.itemLayout->addWidget(jobsPage.useDaemonCheckbox, 0, 0, 1, 2);
+  jobsPage.itemLayout->addWidget(jobsPage.maxConcurrentJobsLabel, 1, 0);
+  jobsPage.itemLayout->addWidget(jobsPage.maxConcurrentJobsSpinbox, 1, 1);
+  jobsPage.itemLayout->addWidget(jobsPage.speculativeDryRunCheckbox, 2, 0, 1,
+                                 2);
+  jobsPage.itemLayout->setColumnStretch(0, 1);
+  jobsPage.itemLayout->setColumnStretch(1, 4);
+  jobsPage.itemLayout->setAlignment(Qt::AlignTop);
+
+  jobsPage.priorityGroupBox = new QGroupBox(tr("Priority"), jobsPage.widget);
+
+  jobsPage.foregroundLabel = new QLabel(tr("Interactive"));
+  jobsPage.foregroundLabel->setToolTip(tr("Jobs started with 'Run'"));
+  jobsPage.backgroundLabel = new QLabel(tr("Batch"));
+  jobsPage.backgroundLabel->setToolTip(
+      tr("Jobs started by dropping multiple maps or folders"));
+
+  const QString niceLevelTooltip =
+      tr("CPU scheduling priority, from -20 (highest) to 19 (lowest).\n"
+         "Values below 0 need elevated privileges.");
+  jobsPage.niceLevelLabel = new QLabel(tr("Nice level"));
+  jobsPage.niceLevelLabel->setToolTip(niceLevelTooltip);
+
+  const QString ioClassTooltip =
+      tr("Disk access priority, 'Idle' only reads and writes when no other "
+         "process is using the disk");
+  jobsPage.ioClassLabel = new QLabel(tr("I/O priority"));
+  jobsPage.ioClassLabel->setToolTip(ioClassTooltip);
+
+  const QString cpuBudgetTooltip =
+      tr("Number of CPU cores Pack3r may run on, 'All' to not restrict it");
+  jobsPage.cpuBudgetLabel = new QLabel(tr("CPU cores"));
+  jobsPage.cpuBudgetLabel->setToolTip(cpuBudgetTooltip);
+
+  const auto createNiceSpinbox = [&] {
+    auto *spinbox = new QSpinBox(jobsPage.priorityGroupBox);
+    spinbox->setToolTip(niceLevelTooltip);
+    spinbox->setRange(-20, 19);
+    return spinbox;
+  };
+
+  const auto createIoClassCombo = [&] {
+    auto *combo = new QComboBox(jobsPage.priorityGroupBox);
+    combo->setToolTip(ioClassTooltip);
+    combo->insertItem(ProcessPriority::IO_NORMAL, tr("Normal"));
+    combo->insertItem(ProcessPriority::IO_LOW, tr("Low"));
+    combo->insertItem(ProcessPriority::IO_IDLE, tr("Idle"));
+    return combo;
+  };
+
+  const auto createCpuBudgetSpinbox = [&] {
+    auto *spinbox = new QSpinBox(jobsPage.priorityGroupBox);
+    spinbox->setToolTip(cpuBudgetTooltip);
+    spinbox->setRange(0, QThread::idealThreadCount());
+    spinbox->setSpecialValueText(tr("All"));
+    return spinbox;
+  };
+
+  jobsPage.foregroundNiceSpinbox = createNiceSpinbox();
+  jobsPage.backgroundNiceSpinbox = createNiceSpinbox();
+  jobsPage.foregroundIoClassCombo = createIoClassCombo();
+  jobsPage.backgroundIoClassCombo = createIoClassCombo();
+  jobsPage.foregroundCpuBudgetSpinbox = createCpuBudgetSpinbox();
+  jobsPage.backgroundCpuBudgetSpinbox = createCpuBudgetSpinbox();
+
+  if (!ProcessPriority::isSupported()) {
+    jobsPage.priorityGroupBox->setEnabled(false);
+    jobsPage.priorityGroupBox->setToolTip(
+        tr("Priority settings are only supported on Linux"));
+  }
+
+  jobsPage.priorityLayout = new QGridLayout(jobsPage.priorityGroupBox);
+
+  jobsPage.priorityLayout->addWidget(jobsPage.foregroundLabel, 0, 1);
+  jobsPage.priorityLayout->addWidget(jobsPage.backgroundLabel, 0, 2);
+  jobsPage.priorityLayout->addWidget(jobsPage.niceLevelLabel, 1, 0);
+  jobsPage.priorityLayout->addWidget(jobsPage.foregroundNiceSpinbox, 1, 1);
+  jobsPage.priorityLayout->addWidget(jobsPage.backgroundNiceSpinbox, 1, 2);
+  jobsPage.priorityLayout->addWidget(jobsPage.ioClassLabel, 2, 0);
+  jobsPage.priorityLayout->addWidget(jobsPage.foregroundIoClassCombo, 2, 1);
+  jobsPage.priorityLayout->addWidget(jobsPage.backgroundIoClassCombo, 2, 2);
+  jobsPage.priorityLayout->addWidget(jobsPage.cpuBudgetLabel, 3, 0);
+  jobsPage.priorityLayout->addWidget(jobsPage.foregroundCpuBudgetSpinbox, 3,
+                                     1);
+  jobsPage.priorityLayout->addWidget(jobsPage.backgroundCpuBudgetSpinbox, 3,
+                                     2);
+  jobsPage.priorityLayout->setColumnStretch(0, 2);
+  jobsPage.priorityLayout->setColumnStretch(1, 3);
+  jobsPage.priorityLayout->setColumnStretch(2, 3);
+  jobsPage.priorityLayout->setAlignment(Qt::AlignTop);
+
+  jobsPage.preflightGroupBox =
+      new QGroupBox(tr("Preflight check"), jobsPage.widget);
+
+  jobsPage.preflightCheckbox = new QCheckBox(
+      tr("Check maps for missing assets before running Pack3r"),
+      jobsPage.preflightGroupBox);
+  jobsPage.preflightCheckbox->setToolTip(
+      tr("Resolve textures, shaders, models and sounds of the map against "
+         "the mapping install, and report missing assets, case mismatches "
+         "and assets provided by more than one pk3"));
+
+  jobsPage.preflightBlockCheckbox = new QCheckBox(
+      tr("Don't run Pack3r for maps with missing assets"),
+      jobsPage.preflightGroupBox);
+  jobsPage.preflightBlockCheckbox->setToolTip(
+      tr("Assets outside of the mapping install, such as in other mods, are "
+         "reported as missing, so turn this off if the map uses them"));
+
+  jobsPage.preflightLayout = new QGridLayout(jobsPage.preflightGroupBox);
+  jobsPage.preflightLayout->addWidget(jobsPage.preflightCheckbox);
+  jobsPage.preflightLayout->addWidget(jobsPage.preflightBlockCheckbox);
+  jobsPage.preflightLayout->setAlignment(Qt::AlignTop);
+
+  jobsPage.prePackGroupBox =
+      new QGroupBox(tr("Before packing"), jobsPage.widget);
+
+  jobsPage.prePackCheckbox =
+      new QCheckBox(tr("Run a command on each map before Pack3r"),
+                    jobsPage.prePackGroupBox);
+  jobsPage.prePackCheckbox->setToolTip(
+      tr("Usually a map compiler. Pack3r is only run if the command "
+         "succeeds.\nIn batches, maps are compiled while earlier maps are "
+         "packed."));
+
+  const QString prePackCommandTooltip =
+      tr("{map} is replaced with the path of the map, {name} with its name "
+         "without the extension\nand {maps} with the path of its maps "
+         "directory. Quote arguments containing spaces.");
+  jobsPage.prePackCommandLabel = new QLabel(tr("Command"));
+  jobsPage.prePackCommandLabel->setToolTip(prePackCommandTooltip);
+
+  jobsPage.prePackCommandField = new QLineEdit(jobsPage.prePackGroupBox);
+  jobsPage.prePackCommandField->setToolTip(prePackCommandTooltip);
+  jobsPage.prePackCommandField->setPlaceholderText(
+      "q3map2 -meta \"{map}\"");
+
+  jobsPage.prePackLayout = new QGridLayout(jobsPage.prePackGroupBox);
+  jobsPage.prePackLayout->addWidget(jobsPage.prePackCheckbox, 0, 0, 1, 2);
+  jobsPage.prePackLayout->addWidget(jobsPage.prePackCommandLabel, 1, 0);
+  jobsPage.prePackLayout->addWidget(jobsPage.prePackCommandField, 1, 1);
+  jobsPage.prePackLayout->setColumnStretch(0, 1);
+  jobsPage.prePackLayout->setColumnStretch(1, 4);
+  jobsPage.prePackLayout->setAlignment(Qt::AlignTop);
+
+  jobsPage.widgetLayout = new QVBoxLayout(jobsPage.widget);
+  jobsPage.widgetLayout->addWidget(jobsPage.groupBox);
+  jobsPage.widgetLayout->addWidget(jobsPage.priorityGroupBox);
+  jobsPage.widgetLayout->addWidget(jobsPage.preflightGroupBox);
+  jobsPage.widgetLayout->addWidget(jobsPage.prePackGroupBox);
+}
+
+void PreferencesDialog::buildRuntimePage() {
+  runtimePage.widget = new QWidget(dialog);
+  runtimePage.groupBox = new QGroupBox(tr(".NET runtime"), runtimePage.widget);
+
+  const QString profileTooltip =
+      tr("Runtime settings for Pack3r processes, passed to the .NET runtime "
+         "as DOTNET_ environment variables.\nUse 'Benchmark runtime "
+         "profiles' in the Tools menu to find the fastest one.");
+  runtimePage.profileLabel = new QLabel(tr("Profile"));
+  runtimePage.profileLabel->setToolTip(profileTooltip);
+
+  runtimePage.profileCombo = new QComboBox(runtimePage.groupBox);
+  runtimePage.profileCombo->setToolTip(profileTooltip);
+
+  for (int i = 0; i < RuntimeProfile::NUM_PRESETS; i++) {
+    runtimePage.profileCombo->insertItem(
+        i, RuntimeProfile::presetName(static_cast<RuntimeProfile::Preset>(i)));
+  }
+
+  const QString benchmarkRoundsTooltip =
+      tr("Number of times each profile is run when benchmarking");
+  runtimePage.benchmarkRoundsLabel = new QLabel(tr("Benchmark rounds"));
+  runtimePage.benchmarkRoundsLabel->setToolTip(benchmarkRoundsTooltip);
+
+  runtimePage.benchmarkRoundsSpinbox = new QSpinBox(runtimePage.groupBox);
+  runtimePage.benchmarkRoundsSpinbox->setToolTip(benchmarkRoundsTooltip);
+  runtimePage.benchmarkRoundsSpinbox->setRange(1, 20);
+
+  runtimePage.itemLayout = new QGridLayout(runtimePage.groupBox);
+  runtimePage.itemLayout->addWidget(runtimePage.profileLabel, 0, 0);
+  runtimePage.itemLayout->addWidget(runtimePage.profileCombo, 0, 1);
+  runtimePage.itemLayout->addWidget(runtimePage.benchmarkRoundsLabel, 1, 0);
+  runtimePage.itemLayout->addWidget(runtimePage.benchmarkRoundsSpinbox, 1, 1);
+  runtimePage.itemLayout->setColumnStretch(0, 1);
+  runtimePage.itemLayout->setColumnStretch(1, 4);
+  runtimePage.itemLayout->setAlignment(Qt::AlignTop);
+
+  runtimePage.customGroupBox =
+      new QGroupBox(tr("Custom profile"), runtimePage.widget);
+
+  const auto createToggleCombo = [&](const QString &tooltip) {
+    auto *combo = new QComboBox(runtimePage.customGroupBox);
+    combo->setToolTip(tooltip);
+    combo->insertItem(RuntimeProfile::TOGGLE_DEFAULT, tr("Default"));
+    combo->insertItem(RuntimeProfile::TOGGLE_ON, tr("On"));
+    combo->insertItem(RuntimeProfile::TOGGLE_OFF, tr("Off"));
+    return combo;
+  };
+
+  const QString tieredCompilationTooltip =
+      tr("Compile methods quickly first and optimize the ones which are "
+         "called often.\nOff compiles everything fully optimized up front.");
+  runtimePage.tieredCompilationLabel = new QLabel(tr("Tiered compilation"));
+  runtimePage.tieredCompilationLabel->setToolTip(tieredCompilationTooltip);
+  runtimePage.tieredCompilationCombo =
+      createToggleCombo(tieredCompilationTooltip);
+
+  const QString quickJitForLoopsTooltip =
+      tr("Also compile methods with loops quickly first");
+  runtimePage.quickJitForLoopsLabel = new QLabel(tr("Quick JIT for loops"));
+  runtimePage.quickJitForLoopsLabel->setToolTip(quickJitForLoopsTooltip);
+  runtimePage.quickJitForLoopsCombo =
+      createToggleCombo(quickJitForLoopsTooltip);
+
+  const QString tieredPgoTooltip =
+      tr("Optimize hot methods with profile data collected while running");
+  runtimePage.tieredPgoLabel = new QLabel(tr("Tiered PGO"));
+  runtimePage.tieredPgoLabel->setToolTip(tieredPgoTooltip);
+  runtimePage.tieredPgoCombo = createToggleCombo(tieredPgoTooltip);
+
+  const QString readyToRunTooltip =
+      tr("Use precompiled code where available instead of compiling it");
+  runtimePage.readyToRunLabel = new QLabel(tr("ReadyToRun code"));
+  runtimePage.readyToRunLabel->setToolTip(readyToRunTooltip);
+  runtimePage.readyToRunCombo = createToggleCombo(readyToRunTooltip);
+
+  const QString gcModeTooltip =
+      tr("Server GC collects on every core with a heap per core, which is "
+         "faster but uses more memory");
+  runtimePage.gcModeLabel = new QLabel(tr("Garbage collector"));
+  runtimePage.gcModeLabel->setToolTip(gcModeTooltip);
+  runtimePage.gcModeCombo = new QComboBox(runtimePage.customGroupBox);
+  runtimePage.gcModeCombo->setToolTip(gcModeTooltip);
+  runtimePage.gcModeCombo->insertItem(RuntimeProfile::GC_DEFAULT,
+                                      tr("Default"));
+  runtimePage.gcModeCombo->insertItem(RuntimeProfile::GC_WORKSTATION,
+                                      tr("Workstation"));
+  runtimePage.gcModeCombo->insertItem(RuntimeProfile::GC_SERVER,
+                                      tr("Server"));
+
+  const QString concurrentGcTooltip =
+      tr("Collect in the background while Pack3r keeps running");
+  runtimePage.concurrentGcLabel = new QLabel(tr("Concurrent GC"));
+  runtimePage.concurrentGcLabel->setToolTip(concurrentGcTooltip);
+  runtimePage.concurrentGcCombo = createToggleCombo(concurrentGcTooltip);
+
+  const QString heapHardLimitTooltip =
+      tr("Maximum size of the GC heap, Pack3r fails with an out of memory "
+         "error above it");
+  runtimePage.heapHardLimitLabel = new QLabel(tr("Heap limit"));
+  runtimePage.heapHardLimitLabel->setToolTip(heapHardLimitTooltip);
+  runtimePage.heapHardLimitSpinbox = new QSpinBox(runtimePage.customGroupBox);
+  runtimePage.heapHardLimitSpinbox->setToolTip(heapHardLimitTooltip);
+  runtimePage.heapHardLimitSpinbox->setRange(0, 1024 * 1024);
+  runtimePage.heapHardLimitSpinbox->setSingleStep(256);
+  runtimePage.heapHardLimitSpinbox->setSuffix(tr(" MB"));
+  runtimePage.heapHardLimitSpinbox->setSpecialValueText(tr("None"));
+
+  runtimePage.customLayout = new QGridLayout(runtimePage.customGroupBox);
+  runtimePage.customLayout->addWidget(runtimePage.tieredCompilationLabel, 0,
+                                      0);
+  runtimePage.customLayout->addWidget(runtimePage.tieredCompilationCombo, 0,
+                                      1);
+  runtimePage.customLayout->addWidget(runtimePage.quickJitForLoopsLabel, 1, 0);
+  runtimePage.customLayout->addWidget(runtimePage.quickJitForLoopsCombo, 1, 1);
+  runtimePage.customLayout->addWidget(runtimePage.tieredPgoLabel, 2, 0);
+  runtimePage.customLayout->addWidget(runtimePage.tieredPgoCombo, 2, 1);
+  runtimePage.customLayout->addWidget(runtimePage.readyToRunLabel, 3, 0);
+  runtimePage.customLayout->addWidget(runtimePage.readyToRunCombo, 3, 1);
+  runtimePage.customLayout->addWidget(runtimePage.gcModeLabel, 4, 0);
+  runtimePage.customLayout->addWidget(runtimePage.gcModeCombo, 4, 1);
+  runtimePage.customLayout->addWidget(runtimePage.concurrentGcLabel, 5, 0);
+  runtimePage.customLayout->addWidget(runtimePage.concurrentGcCombo, 5, 1);
+  runtimePage.customLayout->addWidget(runtimePage.heapHardLimitLabel, 6, 0);
+  runtimePage.customLayout->addWidget(runtimePage.heapHardLimitSpinbox, 6, 1);
+  runtimePage.customLayout->setColumnStretch(0, 1);
+  runtimePage.customLayout->setColumnStretch(1, 4);
+  runtimePage.customLayout->setAlignment(Qt::AlignTop);
+
+  runtimePage.widgetLayout = new QVBoxLayout(runtimePage.widget);
+  runtimePage.widgetLayout->addWidget(runtimePage.groupBox);
+  runtimePage.widgetLayout->addWidget(runtimePage.customGroupBox);
+}
+
+void PreferencesDialog::buildPostPackPage() {
+  postPackPage.widget = new QWidget(dialog);
+  postPackPage.groupBox =
+      new QGroupBox(tr("After packing"), postPackPage.widget);
+
+  postPackPage.recompressCheckbox =
+      new QCheckBox(tr("Recompress output pk3"), postPackPage.groupBox);
+  postPackPage.recompressCheckbox->setToolTip(
+      tr("Rewrite the output pk3 with every file compressed at the selected "
+         "level, using all CPU cores.\nAlready compressed formats such as "
+         "jpg and ogg are stored as is."));
+
+  const QString compressionLevelTooltip =
+      tr("1 is the fastest, 9 produces the smallest pk3");
+  postPackPage.compressionLevelLabel = new QLabel(tr("Compression level"));
+  postPackPage.compressionLevelLabel->setToolTip(compressionLevelTooltip);
+
+  postPackPage.compressionLevelSpinbox = new QSpinBox(postPackPage.groupBox);
+  postPackPage.compressionLevelSpinbox->setToolTip(compressionLevelTooltip);
+  postPackPage.compressionLevelSpinbox->setRange(1, 9);
+
+  if (!Pk3Recompressor::isAvailable()) {
+    postPackPage.recompressCheckbox->setEnabled(false);
+    postPackPage.compressionLevelSpinbox->setEnabled(false);
+    postPackPage.recompressCheckbox->setToolTip(
+        tr("Not available, %1 was built without zlib").arg(PROJECT_NAME));
+  }
+
+  postPackPage.verifyCheckbox =
+      new QCheckBox(tr("Verify output pk3"), postPackPage.groupBox);
+  postPackPage.verifyCheckbox->setToolTip(
+      tr("Check the CRC32 of every file in the output pk3 after a successful "
+         "run,\nto catch corrupt or truncated pk3s before they're "
+         "distributed"));
+
+  postPackPage.manifestCheckbox =
+      new QCheckBox(tr("Write SHA-256 manifest"), postPackPage.groupBox);
+  postPackPage.manifestCheckbox->setToolTip(
+      tr("Write the SHA-256 checksum of the output pk3 next to it, "
+         "as '<output>.sha256'"));
+
+  postPackPage.itemLayout = new QGridLayout(postPackPage.groupBox);
+  postPackPage.itemLayout->addWidget(postPackPage.recompressCheckbox, 0, 0, 1,
+                                     2);
+  postPackPage.itemLayout->addWidget(postPackPage.compressionLevelLabel, 1, 0);
+  postPackPage.itemLayout->addWidget(postPackPage.compressionLevelSpinbox, 1,
+                                     1);
+  postPackPage.itemLayout->addWidget(postPackPage.verifyCheckbox, 2, 0, 1, 2);
+  postPackPage.itemLayout->addWidget(postPackPage.manifestCheckbox, 3, 0, 1,
+                                     2);
+  postPackPage.itemLayout->setColumnStretch(0, 1);
+  postPackPage.itemLayout->setColumnStretch(1, 4);
+  postPackPage.itemLayout->setAlignment(Qt::AlignTop);
+
+  postPackPage.widgetLayout = new QVBoxLayout(postPackPage.widget);
+  postPackPage.widgetLayout->addWidget(postPackPage.groupBox);
+}
+
 void PreferencesDialog::setupConnections() {
   connect(pageList, &QListWidget::currentRowChanged, this,
           [&] { pages->setCurrentIndex(pageList->currentRow()); });
@@ -220,6 +631,9 @@ void PreferencesDialog::setupConnections() {
 
   setupInterfacePageConnections();
   setupPathsPageConnections();
+  setupJobsPageConnections();
+  setupRuntimePageConnections();
+  setupPostPackPageConnections();
 }
 
 void PreferencesDialog::setupInterfacePageConnections() {
@@ -227,6 +641,27 @@ void PreferencesDialog::setupInterfacePageConnections() {
     preferences.writeSetting(Preferences::Settings::WINDOW_REMEMBER_SIZE,
                              interfacePage.windowSizeCheckbox->isChecked());
   });
+
+  connect(interfacePage.diagnosticsReportCheckbox, &QCheckBox::toggled, this,
+          [&] {
+            preferences.writeSetting(
+                Preferences::Settings::DIAGNOSTICS_REPORT,
+                interfacePage.diagnosticsReportCheckbox->isChecked());
+          });
+
+  connect(interfacePage.diagnosticsStallsCheckbox, &QCheckBox::toggled, this,
+          [&] {
+            preferences.writeSetting(
+                Preferences::Settings::DIAGNOSTICS_STALLS,
+                interfacePage.diagnosticsStallsCheckbox->isChecked());
+          });
+
+  connect(interfacePage.diagnosticsTraceCheckbox, &QCheckBox::toggled, this,
+          [&] {
+            preferences.writeSetting(
+                Preferences::Settings::DIAGNOSTICS_TRACE,
+                interfacePage.diagnosticsTraceCheckbox->isChecked());
+          });
 }
 
 void PreferencesDialog::setupPathsPageConnections() {
@@ -251,15 +686,230 @@ void PreferencesDialog::setupPathsPageConnections() {
   });
 }
 
+void PreferencesDialog::setupJobsPageConnections() {
+  connect(jobsPage.useDaemonCheckbox, &QCheckBox::toggled, this, [&] {
+    preferences.writeSetting(Preferences::Settings::USE_DAEMON,
+                             jobsPage.useDaemonCheckbox->isChecked());
+  });
+
+  connect(jobsPage.maxConcurrentJobsSpinbox, &QSpinBox::valueChanged, this,
+          [&] {
+            preferences.writeSetting(
+                Preferences::Settings::MAX_CONCURRENT_JOBS,
+                jobsPage.maxConcurrentJobsSpinbox->value());
+          });
+
+  const auto connectSpinbox = [&](QSpinBox *spinbox,
+                                  const Preferences::Settings setting) {
+    connect(spinbox, &QSpinBox::valueChanged, this,
+            [setting](const int value) {
+              preferences.writeSetting(setting, value);
+            });
+  };
+
+  const auto connectCombo = [&](QComboBox *combo,
+                                const Preferences::Settings setting) {
+    connect(combo, &QComboBox::currentIndexChanged, this,
+            [setting](const int index) {
+              preferences.writeSetting(setting, index);
+            });
+  };
+
+  connectSpinbox(jobsPage.foregroundNiceSpinbox,
+                 Preferences::Settings::PRIORITY_FOREGROUND_NICE);
+  connectSpinbox(jobsPage.backgroundNiceSpinbox,
+                 Preferences::Settings::PRIORITY_BACKGROUND_NICE);
+  connectCombo(jobsPage.foregroundIoClassCombo,
+               Preferences::Settings::PRIORITY_FOREGROUND_IO);
+  connectCombo(jobsPage.backgroundIoClassCombo,
+               Preferences::Settings::PRIORITY_BACKGROUND_IO);
+  connectSpinbox(jobsPage.foregroundCpuBudgetSpinbox,
+                 Preferences::Settings::PRIORITY_FOREGROUND_CPUS);
+  connectSpinbox(jobsPage.backgroundCpuBudgetSpinbox,
+                 Preferences::Settings::PRIORITY_BACKGROUND_CPUS);
+
+  connect(jobsPage.speculativeDryRunCheckbox, &QCheckBox::toggled, this, [&] {
+    preferences.writeSetting(Preferences::Settings::SPECULATIVE_DRY_RUN,
+                             jobsPage.speculativeDryRunCheckbox->isChecked());
+  });
+
+  connect(jobsPage.preflightCheckbox, &QCheckBox::toggled, this, [&] {
+    preferences.writeSetting(Preferences::Settings::PREFLIGHT_ENABLED,
+                             jobsPage.preflightCheckbox->isChecked());
+  });
+
+  connect(jobsPage.preflightBlockCheckbox, &QCheckBox::toggled, this, [&] {
+    preferences.writeSetting(Preferences::Settings::PREFLIGHT_BLOCK_ON_ERRORS,
+                             jobsPage.preflightBlockCheckbox->isChecked());
+  });
+
+  connect(jobsPage.prePackCheckbox, &QCheckBox::toggled, this, [&] {
+    preferences.writeSetting(Preferences::Settings::PREPACK_ENABLED,
+                             jobsPage.prePackCheckbox->isChecked());
+  });
+
+  connect(jobsPage.prePackCommandField, &QLineEdit::textChanged, this, [&] {
+    preferences.writeSetting(Preferences::Settings::PREPACK_COMMAND,
+                             jobsPage.prePackCommandField->text());
+  });
+}
+
+void PreferencesDialog::setupRuntimePageConnections() {
+  const auto connectCombo = [&](QComboBox *combo,
+                                const Preferences::Settings setting) {
+    connect(combo, &QComboBox::currentIndexChanged, this,
+            [setting](const int index) {
+              preferences.writeSetting(setting, index);
+            });
+  };
+
+  connectCombo(runtimePage.profileCombo,
+               Preferences::Settings::RUNTIME_PROFILE);
+  connectCombo(runtimePage.tieredCompilationCombo,
+               Preferences::Settings::RUNTIME_TIERED_COMPILATION);
+  connectCombo(runtimePage.quickJitForLoopsCombo,
+               Preferences::Settings::RUNTIME_QUICK_JIT_FOR_LOOPS);
+  connectCombo(runtimePage.tieredPgoCombo,
+               Preferences::Settings::RUNTIME_TIERED_PGO);
+  connectCombo(runtimePage.readyToRunCombo,
+               Preferences::Settings::RUNTIME_READY_TO_RUN);
+  connectCombo(runtimePage.gcModeCombo,
+               Preferences::Settings::RUNTIME_GC_MODE);
+  connectCombo(runtimePage.concurrentGcCombo,
+               Preferences::Settings::RUNTIME_CONCURRENT_GC);
+
+  // the custom settings are only used by the custom profile
+  connect(runtimePage.profileCombo, &QComboBox::currentIndexChanged, this,
+          [&](const int index) {
+            runtimePage.customGroupBox->setEnabled(
+                index == RuntimeProfile::PRESET_CUSTOM);
+          });
+
+  connect(runtimePage.heapHardLimitSpinbox, &QSpinBox::valueChanged, this,
+          [&] {
+            preferences.writeSetting(
+                Preferences::Settings::RUNTIME_HEAP_HARD_LIMIT,
+                runtimePage.heapHardLimitSpinbox->value());
+          });
+
+  connect(runtimePage.benchmarkRoundsSpinbox, &QSpinBox::valueChanged, this,
+          [&] {
+            preferences.writeSetting(
+                Preferences::Settings::RUNTIME_BENCHMARK_ROUNDS,
+                runtimePage.benchmarkRoundsSpinbox->value());
+          });
+}
+
+void PreferencesDialog::setupPostPackPageConnections() {
+  connect(postPackPage.recompressCheckbox, &QCheckBox::toggled, this, [&] {
+    preferences.writeSetting(Preferences::Settings::POSTPACK_RECOMPRESS,
+                             postPackPage.recompressCheckbox->isChecked());
+  });
+
+  connect(postPackPage.compressionLevelSpinbox, &QSpinBox::valueChanged, this,
+          [&] {
+            preferences.writeSetting(
+                Preferences::Settings::POSTPACK_COMPRESSION_LEVEL,
+                postPackPage.compressionLevelSpinbox->value());
+          });
+
+  connect(postPackPage.verifyCheckbox, &QCheckBox::toggled, this, [&] {
+    preferences.writeSetting(Preferences::Settings::POSTPACK_VERIFY,
+                             postPackPage.verifyCheckbox->isChecked());
+  });
+
+  connect(postPackPage.manifestCheckbox, &QCheckBox::toggled, this, [&] {
+    preferences.writeSetting(Preferences::Settings::POSTPACK_MANIFEST,
+                             postPackPage.manifestCheckbox->isChecked());
+  });
+}
+
 void PreferencesDialog::parseSettingsFile() {
   interfacePage.windowSizeCheckbox->setChecked(
       preferences.readSetting(Preferences::Settings::WINDOW_REMEMBER_SIZE)
           .toBool());
+  interfacePage.diagnosticsReportCheckbox->setChecked(
+      preferences.readSetting(Preferences::Settings::DIAGNOSTICS_REPORT)
+          .toBool());
+  interfacePage.diagnosticsStallsCheckbox->setChecked(
+      preferences.readSetting(Preferences::Settings::DIAGNOSTICS_STALLS)
+          .toBool());
+  interfacePage.diagnosticsTraceCheckbox->setChecked(
+      preferences.readSetting(Preferences::Settings::DIAGNOSTICS_TRACE)
+          .toBool());
 
   pathsPage.pack3rPathField->setText(
       preferences.readSetting(Preferences::Settings::PACK3R_PATH).toString());
   pathsPage.mapsPathField->setText(
       preferences.readSetting(Preferences::Settings::MAPS_PATH).toString());
+
+  jobsPage.useDaemonCheckbox->setChecked(
+      preferences.readSetting(Preferences::Settings::USE_DAEMON).toBool());
+  jobsPage.maxConcurrentJobsSpinbox->setValue(
+      preferences.readSetting(Preferences::Settings::MAX_CONCURRENT_JOBS)
+          .toInt());
+  jobsPage.speculativeDryRunCheckbox->setChecked(
+      preferences.readSetting(Preferences::Settings::SPECULATIVE_DRY_RUN)
+          .toBool());
+
+  const auto foreground = ProcessPriority::foreground();
+  const auto background = ProcessPriority::background();
+  jobsPage.foregroundNiceSpinbox->setValue(foreground.niceLevel);
+  jobsPage.backgroundNiceSpinbox->setValue(background.niceLevel);
+  jobsPage.foregroundIoClassCombo->setCurrentIndex(foreground.ioClass);
+  jobsPage.backgroundIoClassCombo->setCurrentIndex(background.ioClass);
+  jobsPage.foregroundCpuBudgetSpinbox->setValue(foreground.cpuBudget);
+  jobsPage.backgroundCpuBudgetSpinbox->setValue(background.cpuBudget);
+  jobsPage.preflightCheckbox->setChecked(
+      preferences.readSetting(Preferences::Settings::PREFLIGHT_ENABLED)
+          .toBool());
+  jobsPage.preflightBlockCheckbox->setChecked(
+      preferences.readSetting(Preferences::Settings::PREFLIGHT_BLOCK_ON_ERRORS)
+          .toBool());
+  jobsPage.prePackCheckbox->setChecked(
+      preferences.readSetting(Preferences::Settings::PREPACK_ENABLED)
+          .toBool());
+  jobsPage.prePackCommandField->setText(
+      preferences.readSetting(Preferences::Settings::PREPACK_COMMAND)
+          .toString());
+
+  const auto readIndex = [](const Preferences::Settings setting) {
+    return preferences.readSetting(setting).toInt();
+  };
+
+  runtimePage.profileCombo->setCurrentIndex(
+      readIndex(Preferences::Settings::RUNTIME_PROFILE));
+  runtimePage.customGroupBox->setEnabled(
+      runtimePage.profileCombo->currentIndex() ==
+      RuntimeProfile::PRESET_CUSTOM);
+  runtimePage.benchmarkRoundsSpinbox->setValue(
+      readIndex(Preferences::Settings::RUNTIME_BENCHMARK_ROUNDS));
+  runtimePage.tieredCompilationCombo->setCurrentIndex(
+      readIndex(Preferences::Settings::RUNTIME_TIERED_COMPILATION));
+  runtimePage.quickJitForLoopsCombo->setCurrentIndex(
+      readIndex(Preferences::Settings::RUNTIME_QUICK_JIT_FOR_LOOPS));
+  runtimePage.tieredPgoCombo->setCurrentIndex(
+      readIndex(Preferences::Settings::RUNTIME_TIERED_PGO));
+  runtimePage.readyToRunCombo->setCurrentIndex(
+      readIndex(Preferences::Settings::RUNTIME_READY_TO_RUN));
+  runtimePage.gcModeCombo->setCurrentIndex(
+      readIndex(Preferences::Settings::RUNTIME_GC_MODE));
+  runtimePage.concurrentGcCombo->setCurrentIndex(
+      readIndex(Preferences::Settings::RUNTIME_CONCURRENT_GC));
+  runtimePage.heapHardLimitSpinbox->setValue(
+      readIndex(Preferences::Settings::RUNTIME_HEAP_HARD_LIMIT));
+
+  postPackPage.recompressCheckbox->setChecked(
+      preferences.readSetting(Preferences::Settings::POSTPACK_RECOMPRESS)
+          .toBool());
+  postPackPage.compressionLevelSpinbox->setValue(
+      preferences.readSetting(Preferences::Settings::POSTPACK_COMPRESSION_LEVEL)
+          .toInt());
+  postPackPage.verifyCheckbox->setChecked(
+      preferences.readSetting(Preferences::Settings::POSTPACK_VERIFY).toBool());
+  postPackPage.manifestCheckbox->setChecked(
+      preferences.readSetting(Preferences::Settings::POSTPACK_MANIFEST)
+          .toBool());
 }
 
 // TODO: once this dialog is part of the Preferences class,
@@ -268,8 +918,40 @@ void PreferencesDialog::parseSettingsFile() {
 //  this is fine for now with the amount of settings we have
 void PreferencesDialog::resetPreferencesDialogWidget() const {
   interfacePage.windowSizeCheckbox->setChecked(true);
+  interfacePage.diagnosticsReportCheckbox->setChecked(false);
+  interfacePage.diagnosticsStallsCheckbox->setChecked(false);
+  interfacePage.diagnosticsTraceCheckbox->setChecked(false);
   pathsPage.pack3rPathField->clear();
   pathsPage.mapsPathField->clear();
+  jobsPage.useDaemonCheckbox->setChecked(false);
+  jobsPage.maxConcurrentJobsSpinbox->setValue(QThread::idealThreadCount());
+  jobsPage.speculativeDryRunCheckbox->setChecked(false);
+  jobsPage.foregroundNiceSpinbox->setValue(0);
+  jobsPage.backgroundNiceSpinbox->setValue(10);
+  jobsPage.foregroundIoClassCombo->setCurrentIndex(ProcessPriority::IO_NORMAL);
+  jobsPage.backgroundIoClassCombo->setCurrentIndex(ProcessPriority::IO_LOW);
+  jobsPage.foregroundCpuBudgetSpinbox->setValue(0);
+  jobsPage.backgroundCpuBudgetSpinbox->setValue(0);
+  jobsPage.preflightCheckbox->setChecked(true);
+  jobsPage.preflightBlockCheckbox->setChecked(true);
+  jobsPage.prePackCheckbox->setChecked(false);
+  jobsPage.prePackCommandField->clear();
+  runtimePage.profileCombo->setCurrentIndex(RuntimeProfile::PRESET_DEFAULT);
+  runtimePage.benchmarkRoundsSpinbox->setValue(3);
+  runtimePage.tieredCompilationCombo->setCurrentIndex(
+      RuntimeProfile::TOGGLE_DEFAULT);
+  runtimePage.quickJitForLoopsCombo->setCurrentIndex(
+      RuntimeProfile::TOGGLE_DEFAULT);
+  runtimePage.tieredPgoCombo->setCurrentIndex(RuntimeProfile::TOGGLE_DEFAULT);
+  runtimePage.readyToRunCombo->setCurrentIndex(RuntimeProfile::TOGGLE_DEFAULT);
+  runtimePage.gcModeCombo->setCurrentIndex(RuntimeProfile::GC_DEFAULT);
+  runtimePage.concurrentGcCombo->setCurrentIndex(
+      RuntimeProfile::TOGGLE_DEFAULT);
+  runtimePage.heapHardLimitSpinbox->setValue(0);
+  postPackPage.recompressCheckbox->setChecked(false);
+  postPackPage.compressionLevelSpinbox->setValue(9);
+  postPackPage.verifyCheckbox->setChecked(false);
+  postPackPage.manifestCheckbox->setChecked(false);
 }
 
 void PreferencesDialog::restoreDefaults() const {
@@ -34,7 +34,9 @@
 #include <QLabel>
 #include <QListWidget>
 #include <QSettings>
+#include <QSpinBox>
 #include <QStackedWidget>
+#include <QThread>
 
 #ifdef Q_OS_WINDOWS
 #define PREFERENCES_PATH                                                       \
@@ -61,6 +63,37 @@ class Preferences : public QObject {
     PACK3R_PATH,
     MAPS_PATH,
     WRAP_OUTPUT_LINES,
+    HIGHLIGHT_OUTPUT,
+    CAPTURE_ALL_OUTPUT,
+    USE_DAEMON,
+    MAX_CONCURRENT_JOBS,
+    POSTPACK_RECOMPRESS,
+    POSTPACK_COMPRESSION_LEVEL,
+    POSTPACK_VERIFY,
+    POSTPACK_MANIFEST,
+    PRIORITY_FOREGROUND_NICE,
+    PRIORITY_FOREGROUND_IO,
+    PRIORITY_FOREGROUND_CPUS,
+    PRIORITY_BACKGROUND_NICE,
+    PRIORITY_BACKGROUND_IO,
+    PRIORITY_BACKGROUND_CPUS,
+    DIAGNOSTICS_REPORT,
+    DIAGNOSTICS_STALLS,
+    DIAGNOSTICS_TRACE,
+    PREFLIGHT_ENABLED,
+    PREFLIGHT_BLOCK_ON_ERRORS,
+    SPECULATIVE_DRY_RUN,
+    RUNTIME_PROFILE,
+    RUNTIME_TIERED_COMPILATION,
+    RUNTIME_QUICK_JIT_FOR_LOOPS,
+    RUNTIME_TIERED_PGO,
+    RUNTIME_READY_TO_RUN,
+    RUNTIME_GC_MODE,
+    RUNTIME_CONCURRENT_GC,
+    RUNTIME_HEAP_HARD_LIMIT,
+    RUNTIME_BENCHMARK_ROUNDS,
+    PREPACK_ENABLED,
+    PREPACK_COMMAND,
 
     NUM_SETTINGS // endcap
   };
@@ -79,7 +112,39 @@ class Preferences : public QObject {
       {WINDOW_HEIGHT, {"Window/Height", -1}},
       {PACK3R_PATH, {"Paths/Pack3rPath", ""}},
       {MAPS_PATH, {"Paths/MapsPath", ""}},
-      {WRAP_OUTPUT_LINES, {"Interface/WrapOutputLines", false}}};
+      {WRAP_OUTPUT_LINES, {"Interface/WrapOutputLines", false}},
+      {HIGHLIGHT_OUTPUT, {"Interface/HighlightOutput", true}},
+      {CAPTURE_ALL_OUTPUT, {"Interface/CaptureAllOutput", false}},
+      {USE_DAEMON, {"Jobs/UseDaemon", false}},
+      {MAX_CONCURRENT_JOBS,
+       {"Jobs/MaxConcurrentJobs", QThread::idealThreadCount()}},
+      {POSTPACK_RECOMPRESS, {"PostPack/Recompress", false}},
+      {POSTPACK_COMPRESSION_LEVEL, {"PostPack/CompressionLevel", 9}},
+      {POSTPACK_VERIFY, {"PostPack/Verify", false}},
+      {POSTPACK_MANIFEST, {"PostPack/WriteManifest", false}},
+      {PRIORITY_FOREGROUND_NICE, {"Priority/ForegroundNice", 0}},
+      {PRIORITY_FOREGROUND_IO, {"Priority/ForegroundIoClass", 0}},
+      {PRIORITY_FOREGROUND_CPUS, {"Priority/ForegroundCpuBudget", 0}},
+      {PRIORITY_BACKGROUND_NICE, {"Priority/BackgroundNice", 10}},
+      {PRIORITY_BACKGROUND_IO, {"Priority/BackgroundIoClass", 1}},
+      {PRIORITY_BACKGROUND_CPUS, {"Priority/BackgroundCpuBudget", 0}},
+      {DIAGNOSTICS_REPORT, {"Diagnostics/ReportAfterRun", false}},
+      {DIAGNOSTICS_STALLS, {"Diagnostics/LogLongestStalls", false}},
+      {DIAGNOSTICS_TRACE, {"Diagnostics/WriteTrace", false}},
+      {PREFLIGHT_ENABLED, {"Preflight/Enabled", true}},
+      {PREFLIGHT_BLOCK_ON_ERRORS, {"Preflight/BlockOnErrors", true}},
+      {SPECULATIVE_DRY_RUN, {"Jobs/SpeculativeDryRun", false}},
+      {RUNTIME_PROFILE, {"Runtime/Profile", 0}},
+      {RUNTIME_TIERED_COMPILATION, {"Runtime/TieredCompilation", 0}},
+      {RUNTIME_QUICK_JIT_FOR_LOOPS, {"Runtime/QuickJitForLoops", 0}},
+      {RUNTIME_TIERED_PGO, {"Runtime/TieredPGO", 0}},
+      {RUNTIME_READY_TO_RUN, {"Runtime/ReadyToRun", 0}},
+      {RUNTIME_GC_MODE, {"Runtime/GcMode", 0}},
+      {RUNTIME_CONCURRENT_GC, {"Runtime/ConcurrentGc", 0}},
+      {RUNTIME_HEAP_HARD_LIMIT, {"Runtime/HeapHardLimitMb", 0}},
+      {RUNTIME_BENCHMARK_ROUNDS, {"Runtime/BenchmarkRounds", 3}},
+      {PREPACK_ENABLED, {"PrePack/Enabled", false}},
+      {PREPACK_COMMAND, {"PrePack/Command", ""}}};
 
   QString preferencesFile;
 };
@@ -109,10 +174,16 @@ class PreferencesDialog : public QWidget {
 private:
   void buildInterfacePage();
   void buildPathsPage();
+  void buildJobsPage();
+  void buildRuntimePage();
+  void buildPostPackPage();
 
   void setupConnections();
   void setupInterfacePageConnections();
   void setupPathsPageConnections();
+  void setupJobsPageConnections();
+  void setupRuntimePageConnections();
+  void setupPostPackPageConnections();
 
   void parseSettingsFile();
 
@@ -126,6 +197,9 @@ class PreferencesDialog : public QWidget {
     QGridLayout *itemLayout{};
 
     QCheckBox *windowSizeCheckbox{};
+    QCheckBox *diagnosticsReportCheckbox{};
+    QCheckBox *diagnosticsStallsCheckbox{};
+    QCheckBox *diagnosticsTraceCheckbox{};
   };
 
   struct PathsPage {
@@ -145,12 +219,117 @@ class PreferencesDialog : public QWidget {
     QAction *mapsPathAction{};
   };
 
+  struct JobsPage {
+    QWidget *widget{};
+    QVBoxLayout *widgetLayout{};
+
+    QGroupBox *groupBox{};
+    QGridLayout *itemLayout{};
+
+    QCheckBox *useDaemonCheckbox{};
+
+    QLabel *maxConcurrentJobsLabel{};
+    QSpinBox *maxConcurrentJobsSpinbox{};
+
+    QCheckBox *speculativeDryRunCheckbox{};
+
+    QGroupBox *priorityGroupBox{};
+    QGridLayout *priorityLayout{};
+
+    QLabel *foregroundLabel{};
+    QLabel *backgroundLabel{};
+
+    QLabel *niceLevelLabel{};
+    QSpinBox *foregroundNiceSpinbox{};
+    QSpinBox *backgroundNiceSpinbox{};
+
+    QLabel *ioClassLabel{};
+    QComboBox *foregroundIoClassCombo{};
+    QComboBox *backgroundIoClassCombo{};
+
+    QLabel *cpuBudgetLabel{};
+    QSpinBox *foregroundCpuBudgetSpinbox{};
+    QSpinBox *backgroundCpuBudgetSpinbox{};
+
+    QGroupBox *preflightGroupBox{};
+    QGridLayout *preflightLayout{};
+
+    QCheckBox *preflightCheckbox{};
+    QCheckBox *preflightBlockCheckbox{};
+
+    QGroupBox *prePackGroupBox{};
+    QGridLayout *prePackLayout{};
+
+    QCheckBox *prePackCheckbox{};
+    QLabel *prePackCommandLabel{};
+    QLineEdit *prePackCommandField{};
+  };
+
+  struct RuntimePage {
+    QWidget *widget{};
+    QVBoxLayout *widgetLayout{};
+
+    QGroupBox *groupBox{};
+    QGridLayout *itemLayout{};
+
+    QLabel *profileLabel{};
+    QComboBox *profileCombo{};
+
+    QLabel *benchmarkRoundsLabel{};
+    QSpinBox *benchmarkRoundsSpinbox{};
+
+    QGroupBox *customGroupBox{};
+    QGridLayout *customLayout{};
+
+    QLabel *tieredCompilationLabel{};
+    QComboBox *tieredCompilationCombo{};
+
+    QLabel *quickJitForLoopsLabel{};
+    QComboBox *quickJitForLoopsCombo{};
+
+    QLabel *tieredPgoLabel{};
+    QComboBox *tieredPgoCombo{};
+
+    QLabel *readyToRunLabel{};
+    QComboBox *readyToRunCombo{};
+
+    QLabel *gcModeLabel{};
+    QComboBox *gcModeCombo{};
+
+    QLabel *concurrentGcLabel{};
+    QComboBox *concurrentGcCombo{};
+
+    QLabel *heapHardLimitLabel{};
+    QSpinBox *heapHardLimitSpinbox{};
+  };
+
+  struct PostPackPage {
+    QWidget *widget{};
+    QVBoxLayout *widgetLayout{};
+
+    QGroupBox *groupBox{};
+    QGridLayout *itemLayout{};
+
+    QCheckBox *recompressCheckbox{};
+    QLabel *compressionLevelLabel{};
+    QSpinBox *compressionLevelSpinbox{};
+
+    QCheckBox *verifyCheckbox{};
+    QCheckBox *manifestCheckbox{};
+  };
+
   InterfacePage interfacePage{};
   PathsPage pathsPage{};
+  JobsPage jobsPage{};
+  RuntimePage runtimePage{};
+  PostPackPage postPackPage{};
 
   QListWidget *pageList{};
   QListWidgetItem *interfaceItem{};
   QListWidgetItem *pathsItem{};
+  QListWidgetItem *jobsItem{};
+  QListWidgetItem *runtimeItem{};
+  QListWidgetItem *postPackItem{};
 
   QStackedWidget *pages{};
 
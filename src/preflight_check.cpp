@@ -0,0 +1,694 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "preflight_check.h"
+#include "pk3_archive.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QtConcurrent>
+#include <algorithm>
+#include <numeric>
+
+namespace {
+// the game tries these when an image isn't found with the extension given
+const QStringList imageExtensions = {".tga", ".jpg", ".png"};
+
+// assets provided by more than one location are common in a mapping
+// install, so only this many are listed per map
+constexpr int MAX_LISTED_SHADOWED = 20;
+
+QByteArray line(const QString &str) { return "[preflight] " + str.toUtf8(); }
+
+Pack3rOutputParser::LogLevel
+severityLevel(const PreflightCheck::Severity severity) {
+  switch (severity) {
+  case PreflightCheck::SEVERITY_ERROR:
+    return Pack3rOutputParser::LOG_ERROR;
+  case PreflightCheck::SEVERITY_WARNING:
+    return Pack3rOutputParser::LOG_WARN;
+  default:
+    return Pack3rOutputParser::LOG_INFO;
+  }
+}
+
+QStringList imageCandidates(const QString &image) {
+  const qsizetype dot = image.lastIndexOf('.');
+  const bool hasExtension = dot > image.lastIndexOf('/');
+  const QString base = hasExtension ? image.left(dot) : image;
+  QStringList candidates{};
+
+  if (hasExtension) {
+    candidates.append(image);
+  }
+
+  for (const auto &extension : imageExtensions) {
+    if (!candidates.contains(base + extension, Qt::CaseInsensitive)) {
+      candidates.append(base + extension);
+    }
+  }
+
+  return candidates;
+}
+
+QStringList modelCandidates(const QString &model) {
+  // ET also loads compressed models in place of .md3
+  if (model.endsWith(".md3", Qt::CaseInsensitive)) {
+    return {model, model.chopped(4) + ".mdc"};
+  }
+
+  return {model};
+}
+} // namespace
+
+PreflightCheck::PreflightCheck(QObject *parent)
+    : QObject(parent), watcher(new QFutureWatcher<Problem>(this)),
+      indexCache(std::make_shared<IndexCache>()) {
+  connect(watcher, &QFutureWatcher<Problem>::resultReadyAt, this,
+          [this](const int index) {
+            const Problem problem = watcher->resultAt(index);
+
+            if (problem.map.isEmpty()) {
+              emit outputLine(line(problem.message),
+                              severityLevel(problem.severity));
+              return;
+            }
+
+            counts[problem.map][problem.severity]++;
+
+            QString severity{};
+
+            if (problem.severity == SEVERITY_ERROR) {
+              severity = tr("error: ");
+            } else if (problem.severity == SEVERITY_WARNING) {
+              severity = tr("warning: ");
+            }
+
+            emit outputLine(line(QFileInfo(problem.map).fileName() + ": " +
+                                 severity + problem.message),
+                            severityLevel(problem.severity));
+          });
+
+  connect(watcher, &QFutureWatcher<Problem>::finished, this, [this] {
+    if (watcher->isCanceled()) {
+      emit outputLine(line(tr("Canceled")), Pack3rOutputParser::LOG_INFO);
+      emit finished({}, true);
+      return;
+    }
+
+    QStringList passed{};
+
+    for (const auto &map : checkedMaps) {
+      const auto mapCounts = counts.value(map);
+      const QString mapName = QFileInfo(map).fileName();
+
+      if (mapCounts[SEVERITY_ERROR] == 0 && mapCounts[SEVERITY_WARNING] == 0) {
+        emit outputLine(line(tr("%1: no problems found").arg(mapName)),
+                        Pack3rOutputParser::LOG_INFO);
+      } else {
+        emit outputLine(line(tr("%1: %2 errors, %3 warnings")
+                                 .arg(mapName)
+                                 .arg(mapCounts[SEVERITY_ERROR])
+                                 .arg(mapCounts[SEVERITY_WARNING])),
+                        severityLevel(mapCounts[SEVERITY_ERROR] > 0
+                                          ? SEVERITY_ERROR
+                                          : SEVERITY_WARNING));
+      }
+
+      if (mapCounts[SEVERITY_ERROR] == 0) {
+        passed.append(map);
+      }
+    }
+
+    emit finished(passed, false);
+  });
+}
+
+void PreflightCheck::run(const QString &mapsPath, const QStringList &mapPaths,
+                         const QStringList &excludedPk3s,
+                         const ShaderIndex::Definitions &shaders) {
+  if (isRunning()) {
+    return;
+  }
+
+  checkedMaps = mapPaths;
+  counts.clear();
+
+  const QString root = QDir::cleanPath(QDir::fromNativeSeparators(mapsPath));
+  watcher->setFuture(QtConcurrent::run(&PreflightCheck::check, indexCache,
+                                       root, mapPaths, excludedPk3s, shaders));
+}
+
+void PreflightCheck::cancel() {
+  if (isRunning()) {
+    watcher->cancel();
+  }
+}
+
+bool PreflightCheck::isRunning() const { return watcher->isRunning(); }
+
+QList<QStringList> PreflightCheck::dependencies(
+    const QString &mapsPath, const QStringList &mapPaths,
+    const QList<QStringList> &packedAssets, const QStringList &excludedPk3s,
+    const ShaderIndex::Definitions &shaders) const {
+  const QString root = QDir::cleanPath(QDir::fromNativeSeparators(mapsPath));
+  qsizetype containerCount = 0;
+  const AssetIndex index =
+      indexCache->index(root, excludedPk3s, containerCount);
+
+  QList<qsizetype> order(mapPaths.size());
+  std::iota(order.begin(), order.end(), 0);
+
+  return QtConcurrent::blockingMapped<QList<QStringList>>(
+      order, [&](const qsizetype i) {
+        return mapDependencies(root, mapPaths[i], packedAssets.value(i), index,
+                               shaders);
+      });
+}
+
+void PreflightCheck::check(QPromise<Problem> &promise,
+                           const std::shared_ptr<IndexCache> &cache,
+                           const QString &mapsPath,
+                           const QStringList &mapPaths,
+                           const QStringList &excludedPk3s,
+                           const ShaderIndex::Definitions &shaders) {
+  QElapsedTimer timer{};
+  timer.start();
+
+  qsizetype containerCount = 0;
+  const AssetIndex index = cache->index(mapsPath, excludedPk3s, containerCount);
+
+  if (promise.isCanceled()) {
+    return;
+  }
+
+  promise.addResult({{},
+                     SEVERITY_INFO,
+                     QObject::tr("Indexed %1 files from %2 pk3s and "
+                                 "directories in %3 ms")
+                         .arg(index.size())
+                         .arg(containerCount)
+                         .arg(timer.elapsed())});
+
+  // maps are checked in parallel, problems are reported in map order
+  const auto results = QtConcurrent::blockingMapped<QList<QList<Problem>>>(
+      mapPaths, [&index, &shaders](const QString &mapPath) {
+        return checkMap(mapPath, index, shaders);
+      });
+
+  for (const auto &problems : results) {
+    for (const auto &problem : problems) {
+      promise.addResult(problem);
+    }
+  }
+
+  promise.addResult({{},
+                     SEVERITY_INFO,
+                     QObject::tr("Checked %n map(s) in %1 ms", "",
+                                 static_cast<int>(mapPaths.size()))
+                         .arg(timer.elapsed())});
+}
+
+// the lock is only held to swap snapshots, so concurrent callers may both
+// list a changed container, but never see a partially updated snapshot
+PreflightCheck::AssetIndex
+PreflightCheck::IndexCache::index(const QString &root,
+                                  const QStringList &excludedPk3s,
+                                  qsizetype &containerCount) {
+  Snapshot previous{};
+
+  {
+    const QMutexLocker locker(&mutex);
+    previous = snapshot;
+  }
+
+  const Snapshot next = scan(root, excludedPk3s, previous, containerCount);
+
+  {
+    const QMutexLocker locker(&mutex);
+    snapshot = next;
+  }
+
+  return next.index;
+}
+
+/*
+ * The game searches pk3s in reverse alphabetical order, and loose files
+ * before any pk3. pk3dirs aren't known to the game, but Pack3r treats them
+ * like loose files. Each pk3 and top level directory is listed separately
+ * so they can be listed in parallel, and merged in load order afterwards.
+ *
+ * Containers which haven't changed since 'previous' aren't listed again,
+ * and if none of them have, the previous index is reused as is.
+ */
+PreflightCheck::Snapshot PreflightCheck::scan(const QString &root,
+                                              const QStringList &excludedPk3s,
+                                              const Snapshot &previous,
+                                              qsizetype &containerCount) {
+  struct Container {
+    QString name;   // reported location, empty for etmain
+    QString path;   // what to list
+    QString prefix; // prepended to listed paths
+    bool isPk3{};
+    bool recursive{};
+  };
+
+  struct Listing {
+    Files files;
+    QHash<QString, Directory> directories;
+    Pk3Listing pk3;
+    bool changed{};
+  };
+
+  const QDir rootDir(root);
+  const bool sameRoot = previous.root == root;
+  QList<Container> containers{};
+  Snapshot result{};
+  result.root = root;
+
+  for (const auto &pk3 : rootDir.entryList({"*.pk3"}, QDir::Files,
+                                           QDir::Name | QDir::IgnoreCase)) {
+    const QFileInfo info(root + "/" + pk3);
+    const bool excluded =
+        std::any_of(excludedPk3s.cbegin(), excludedPk3s.cend(),
+                    [&info](const QString &path) {
+                      return QFileInfo(path) == info;
+                    });
+
+    if (excluded) {
+      result.excludedPk3s.append(pk3);
+    } else {
+      containers.append({pk3, info.filePath(), {}, true, false});
+    }
+  }
+
+  for (const auto &pk3dir :
+       rootDir.entryList({"*.pk3dir"}, QDir::Dirs | QDir::NoDotAndDotDot,
+                         QDir::Name | QDir::IgnoreCase)) {
+    containers.append({pk3dir, root + "/" + pk3dir, {}, false, true});
+  }
+
+  containers.append({{}, root, {}, false, false});
+
+  for (const auto &dir : rootDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot,
+                                           QDir::Name | QDir::IgnoreCase)) {
+    if (!dir.endsWith(".pk3dir", Qt::CaseInsensitive)) {
+      containers.append({{}, root + "/" + dir, dir + "/", false, true});
+    }
+  }
+
+  containerCount = containers.size();
+
+  const auto listings = QtConcurrent::blockingMapped<QList<Listing>>(
+      containers, [&previous, sameRoot](const Container &container) {
+        Listing listing{};
+
+        if (container.isPk3) {
+          const QFileInfo info(container.path);
+          const auto cached = previous.pk3s.constFind(container.path);
+          listing.pk3.modified = info.lastModified().toMSecsSinceEpoch();
+          listing.pk3.size = info.size();
+
+          if (sameRoot && cached != previous.pk3s.cend() &&
+              cached->modified == listing.pk3.modified &&
+              cached->size == listing.pk3.size) {
+            listing.pk3 = *cached;
+            return listing;
+          }
+
+          listing.changed = true;
+          Pk3Archive archive(container.path);
+
+          if (archive.open()) {
+            for (const auto &entry : archive.entries()) {
+              if (!entry.isDirectory()) {
+                listing.pk3.files.append(
+                    {entry.name.toLower(), {container.name, entry.name}});
+              }
+            }
+          }
+
+          return listing;
+        }
+
+        // see MapIndex::scan(), an unchanged directory has the same files
+        // and subdirectories as the last time it was listed
+        const qsizetype baseLength = container.path.size() + 1;
+        QStringList pending = {container.path};
+
+        while (!pending.isEmpty()) {
+          const QString path = pending.takeLast();
+          const qint64 modified =
+              QFileInfo(path).lastModified().toMSecsSinceEpoch();
+          const auto cached = previous.directories.constFind(path);
+          Directory dir{};
+
+          if (sameRoot && cached != previous.directories.cend() &&
+              cached->modified == modified) {
+            dir = *cached;
+          } else {
+            const QDir qdir(path);
+            dir.modified = modified;
+            dir.subdirectories =
+                qdir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+            dir.files = qdir.entryList(QDir::Files);
+            listing.changed = true;
+          }
+
+          const QString relative =
+              path == container.path
+                  ? container.prefix
+                  : container.prefix + path.mid(baseLength) + "/";
+
+          for (const auto &file : dir.files) {
+            const QString filePath = relative + file;
+            listing.files.append(
+                {filePath.toLower(), {container.name, filePath}});
+          }
+
+          if (container.recursive) {
+            for (const auto &subdirectory : dir.subdirectories) {
+              pending.append(path + "/" + subdirectory);
+            }
+          }
+
+          listing.directories.insert(path, dir);
+        }
+
+        return listing;
+      });
+
+  // removing a container changes the modification time of the root,
+  // which is listed again then
+  bool changed = !sameRoot || result.excludedPk3s != previous.excludedPk3s;
+
+  for (qsizetype i = 0; i < containers.size(); i++) {
+    const Listing &listing = listings[i];
+    changed = changed || listing.changed;
+
+    if (containers[i].isPk3) {
+      result.pk3s.insert(containers[i].path, listing.pk3);
+    } else {
+      result.directories.insert(listing.directories);
+    }
+  }
+
+  if (!changed) {
+    result.index = previous.index;
+    return result;
+  }
+
+  // pk3s were listed in alphabetical order, so later ones win, and loose
+  // files come last
+  for (qsizetype i = 0; i < containers.size(); i++) {
+    const Files &files =
+        containers[i].isPk3 ? listings[i].pk3.files : listings[i].files;
+
+    for (const auto &[key, location] : files) {
+      result.index[key].append(location);
+    }
+  }
+
+  return result;
+}
+
+/*
+ * Entities are lines of '"key" "value"' pairs. Models of brush entities
+ * are '*n' and refer to the brushes of the entity, not to a file.
+ */
+QList<PreflightCheck::Reference>
+PreflightCheck::mapReferences(const QString &mapPath, QString &error) {
+  QList<Reference> references{};
+
+  for (const auto &shader : ShaderIndex::mapShaders(mapPath, error)) {
+    references.append({shader, REFERENCE_SHADER});
+  }
+
+  if (!error.isEmpty()) {
+    return {};
+  }
+
+  QFile file(mapPath);
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    error = file.errorString();
+    return {};
+  }
+
+  QSet<QString> seen{};
+
+  while (!file.atEnd()) {
+    const QByteArray entityLine = file.readLine().trimmed();
+
+    if (!entityLine.startsWith('"')) {
+      continue;
+    }
+
+    // "key" "value" splits into '', key, ' ', value, ''
+    const QList<QByteArray> parts = entityLine.split('"');
+
+    if (parts.size() < 5) {
+      continue;
+    }
+
+    const QByteArray key = parts[1].toLower();
+    const QString value = QString::fromUtf8(parts[3]).replace('\\', '/');
+
+    if (value.isEmpty() || value.startsWith('*') || seen.contains(value)) {
+      continue;
+    }
+
+    if (key == "model" || key == "model2") {
+      references.append({value, REFERENCE_MODEL});
+      seen.insert(value);
+    } else if (key == "noise") {
+      references.append({value, REFERENCE_SOUND});
+      seen.insert(value);
+    }
+  }
+
+  return references;
+}
+
+QList<PreflightCheck::Problem>
+PreflightCheck::checkMap(const QString &mapPath, const AssetIndex &index,
+                         const ShaderIndex::Definitions &shaders) {
+  QList<Problem> problems{};
+  const auto report = [&](const Severity severity, const QString &message) {
+    problems.append({mapPath, severity, message});
+  };
+
+  QString error{};
+  const QList<Reference> references = mapReferences(mapPath, error);
+
+  if (!error.isEmpty()) {
+    report(SEVERITY_ERROR, QObject::tr("Unable to read map: %1").arg(error));
+    return problems;
+  }
+
+  // the same image is usually used by many shaders,
+  // so each file is only resolved and reported once
+  QHash<QString, bool> resolved{};
+  int shadowedCount = 0;
+
+  const auto resolve = [&](const QStringList &candidates) {
+    for (const auto &candidate : candidates) {
+      const QString key = candidate.toLower();
+      const auto cached = resolved.constFind(key);
+
+      if (cached != resolved.cend()) {
+        if (*cached) {
+          return true;
+        }
+
+        continue;
+      }
+
+      const auto found = index.constFind(key);
+      resolved.insert(key, found != index.cend());
+
+      if (found == index.cend()) {
+        continue;
+      }
+
+      const Location &used = found->last();
+
+      // only lookups in pk3s are case-insensitive everywhere
+      if (!used.container.endsWith(".pk3", Qt::CaseInsensitive) &&
+          used.path != candidate) {
+        report(SEVERITY_WARNING,
+               QObject::tr("%1 is %2 on disk, which is only found on "
+                           "case-insensitive file systems")
+                   .arg(candidate, used.path));
+      }
+
+      if (found->size() > 1 && shadowedCount++ < MAX_LISTED_SHADOWED) {
+        QStringList locations{};
+
+        for (const auto &location : *found) {
+          locations.append(location.container.isEmpty() ? "etmain"
+                                                        : location.container);
+        }
+
+        report(SEVERITY_INFO, QObject::tr("%1 is in %2, the last one is used")
+                                  .arg(used.path, locations.join(", ")));
+      }
+
+      return true;
+    }
+
+    return false;
+  };
+
+  for (const auto &reference : references) {
+    switch (reference.kind) {
+    case REFERENCE_SHADER: {
+      const auto definition = shaders.constFind(reference.path.toLower());
+
+      if (definition == shaders.cend()) {
+        if (!resolve(imageCandidates(reference.path))) {
+          report(SEVERITY_ERROR,
+                 QObject::tr("Missing texture %1, it's not defined in any "
+                             "shader script and there's no image with that "
+                             "name")
+                     .arg(reference.path));
+        }
+
+        break;
+      }
+
+      const ShaderIndex::Definition &used = definition->first();
+
+      for (const auto &image : used.images) {
+        if (!resolve(imageCandidates(image))) {
+          report(SEVERITY_ERROR,
+                 QObject::tr("Shader %1 (%2:%3) uses missing image %4")
+                     .arg(used.name, used.script)
+                     .arg(used.line)
+                     .arg(image));
+        }
+      }
+
+      break;
+    }
+    case REFERENCE_MODEL:
+      if (!resolve(modelCandidates(reference.path))) {
+        report(SEVERITY_ERROR,
+               QObject::tr("Missing model %1").arg(reference.path));
+      }
+
+      break;
+    case REFERENCE_SOUND:
+      if (!resolve({reference.path})) {
+        report(SEVERITY_ERROR,
+               QObject::tr("Missing sound %1").arg(reference.path));
+      }
+
+      break;
+    }
+  }
+
+  if (shadowedCount > MAX_LISTED_SHADOWED) {
+    report(SEVERITY_INFO,
+           QObject::tr("...and %1 more files in more than one location")
+               .arg(shadowedCount - MAX_LISTED_SHADOWED));
+  }
+
+  return problems;
+}
+
+QStringList
+PreflightCheck::mapDependencies(const QString &root, const QString &mapPath,
+                                const QStringList &packedAssets,
+                                const AssetIndex &index,
+                                const ShaderIndex::Definitions &shaders) {
+  QSet<QString> files{QFileInfo(mapPath).absoluteFilePath()};
+
+  const auto resolve = [&](const QStringList &candidates) {
+    for (const auto &candidate : candidates) {
+      const auto found = index.constFind(candidate.toLower());
+
+      if (found == index.cend()) {
+        continue;
+      }
+
+      const Location &used = found->last();
+
+      if (used.container.isEmpty()) {
+        files.insert(root + "/" + used.path);
+      } else if (used.container.endsWith(".pk3", Qt::CaseInsensitive)) {
+        files.insert(root + "/" + used.container);
+      } else {
+        files.insert(root + "/" + used.container + "/" + used.path);
+      }
+
+      return;
+    }
+  };
+
+  // an unreadable map only depends on itself, Pack3r reports the error
+  QString error{};
+
+  for (const auto &reference : mapReferences(mapPath, error)) {
+    switch (reference.kind) {
+    case REFERENCE_SHADER: {
+      const auto definition = shaders.constFind(reference.path.toLower());
+
+      if (definition == shaders.cend()) {
+        resolve(imageCandidates(reference.path));
+        break;
+      }
+
+      // scripts in pk3s are listed as pk3/entry
+      const ShaderIndex::Definition &used = definition->first();
+      const qsizetype pk3End =
+          used.script.indexOf(".pk3/", 0, Qt::CaseInsensitive);
+      files.insert(root + "/" +
+                   (pk3End < 0 ? used.script : used.script.left(pk3End + 4)));
+
+      for (const auto &image : used.images) {
+        resolve(imageCandidates(image));
+      }
+
+      break;
+    }
+    case REFERENCE_MODEL:
+      resolve(modelCandidates(reference.path));
+      break;
+    case REFERENCE_SOUND:
+      resolve({reference.path});
+      break;
+    }
+  }
+
+  for (const auto &asset : packedAssets) {
+    resolve({asset});
+  }
+
+  QStringList sorted = files.values();
+  sorted.sort();
+  return sorted;
+}
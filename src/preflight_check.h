@@ -0,0 +1,174 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "pack3r_output_parser.h"
+#include "shader_index.h"
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QPromise>
+#include <array>
+#include <memory>
+
+// Checks maps before Pack3r is run, by resolving the assets they reference
+// against an index of the mapping install built on the thread pool.
+//
+// Shaders used by brushes and patches are resolved through the shader index
+// to the images their stages use, or to a texture image if the shader isn't
+// defined in any script. Models and sounds of entities are resolved as is.
+// Lookups are case-insensitive like in the game, but loose files whose case
+// doesn't match the reference are reported, as they'd fail on case-sensitive
+// file systems. Assets provided by more than one pk3 or directory are
+// reported along with the one which is used, in the games load order.
+//
+// The index is kept between checks and Ninja exports. Each pk3 is only
+// listed again once its modification time or size changes, and each
+// directory once its modification time changes, like MapIndex does.
+class PreflightCheck : public QObject {
+  Q_OBJECT
+
+public:
+  enum Severity {
+    SEVERITY_INFO,
+    SEVERITY_WARNING,
+    SEVERITY_ERROR,
+
+    NUM_SEVERITIES // endcap
+  };
+
+  struct Problem {
+    QString map; // empty for messages about the whole check
+    Severity severity{};
+    QString message;
+  };
+
+  explicit PreflightCheck(QObject *parent);
+
+  // 'excludedPk3s' are outputs of the maps being checked, as a previous
+  // build of a map would otherwise provide its own assets
+  void run(const QString &mapsPath, const QStringList &mapPaths,
+           const QStringList &excludedPk3s,
+           const ShaderIndex::Definitions &shaders);
+  void cancel();
+  bool isRunning() const;
+
+  // files each map is built from, resolved the same way as the check: the
+  // map, the images, models and sounds it uses, the scripts defining its
+  // shaders, and 'packedAssets' of the map, which are paths relative to the
+  // maps path, such as the assets listed by a dry run. Files in pk3s are
+  // represented by the pk3. Blocks, so it's meant for the thread pool.
+  QList<QStringList>
+  dependencies(const QString &mapsPath, const QStringList &mapPaths,
+               const QList<QStringList> &packedAssets,
+               const QStringList &excludedPk3s,
+               const ShaderIndex::Definitions &shaders) const;
+
+signals:
+  void outputLine(const QByteArray &line,
+                  Pack3rOutputParser::LogLevel level);
+  // maps without errors
+  void finished(const QStringList &passedMaps, bool canceled);
+
+private:
+  enum ReferenceKind {
+    REFERENCE_SHADER,
+    REFERENCE_MODEL,
+    REFERENCE_SOUND,
+  };
+
+  struct Reference {
+    QString path;
+    ReferenceKind kind{};
+  };
+
+  struct Location {
+    QString container; // pk3 or pk3dir name, empty if loose in etmain
+    QString path;      // as stored, in its original case
+  };
+
+  // lowercase path to every location of the file, in load order,
+  // so the last location is the one the game uses
+  using AssetIndex = QHash<QString, QList<Location>>;
+  using Files = QList<QPair<QString, Location>>;
+
+  struct Directory {
+    qint64 modified{};
+    QStringList subdirectories;
+    QStringList files;
+  };
+
+  struct Pk3Listing {
+    qint64 modified{};
+    qint64 size{};
+    Files files;
+  };
+
+  struct Snapshot {
+    QString root;
+    QStringList excludedPk3s;
+    QHash<QString, Directory> directories;
+    QHash<QString, Pk3Listing> pk3s;
+    AssetIndex index;
+  };
+
+  // shared by checks and Ninja exports running on the thread pool, which
+  // each update it with the containers they had to list again
+  class IndexCache {
+  public:
+    AssetIndex index(const QString &root, const QStringList &excludedPk3s,
+                     qsizetype &containerCount);
+
+  private:
+    QMutex mutex;
+    Snapshot snapshot;
+  };
+
+  static void check(QPromise<Problem> &promise,
+                    const std::shared_ptr<IndexCache> &cache,
+                    const QString &mapsPath, const QStringList &mapPaths,
+                    const QStringList &excludedPk3s,
+                    const ShaderIndex::Definitions &shaders);
+
+  static Snapshot scan(const QString &root, const QStringList &excludedPk3s,
+                       const Snapshot &previous, qsizetype &containerCount);
+  static QList<Reference> mapReferences(const QString &mapPath,
+                                        QString &error);
+  static QList<Problem> checkMap(const QString &mapPath,
+                                 const AssetIndex &index,
+                                 const ShaderIndex::Definitions &shaders);
+  static QStringList mapDependencies(const QString &root,
+                                     const QString &mapPath,
+                                     const QStringList &packedAssets,
+                                     const AssetIndex &index,
+                                     const ShaderIndex::Definitions &shaders);
+
+  QFutureWatcher<Problem> *watcher;
+  std::shared_ptr<IndexCache> indexCache;
+  QStringList checkedMaps;
+  QHash<QString, std::array<int, NUM_SEVERITIES>> counts;
+};
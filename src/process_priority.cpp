@@ -0,0 +1,150 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "process_priority.h"
+#include "preferences.h"
+
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+// glibc has no wrapper or header for ioprio_set()
+constexpr int IOPRIO_WHO_PROCESS = 1;
+constexpr int IOPRIO_CLASS_SHIFT = 13;
+constexpr int IOPRIO_CLASS_BE = 2;
+constexpr int IOPRIO_CLASS_IDLE = 3;
+constexpr int IOPRIO_BE_LOWEST = 7;
+
+int ioPriority(const ProcessPriority::IoClass ioClass) {
+  switch (ioClass) {
+  case ProcessPriority::IO_LOW:
+    return IOPRIO_CLASS_BE << IOPRIO_CLASS_SHIFT | IOPRIO_BE_LOWEST;
+  case ProcessPriority::IO_IDLE:
+    return IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT;
+  default:
+    return 0;
+  }
+}
+} // namespace
+#endif
+
+ProcessPriority::Profile ProcessPriority::foreground() {
+  Profile profile{};
+  profile.niceLevel =
+      preferences.readSetting(Preferences::Settings::PRIORITY_FOREGROUND_NICE)
+          .toInt();
+  profile.ioClass = static_cast<IoClass>(
+      preferences.readSetting(Preferences::Settings::PRIORITY_FOREGROUND_IO)
+          .toInt());
+  profile.cpuBudget =
+      preferences.readSetting(Preferences::Settings::PRIORITY_FOREGROUND_CPUS)
+          .toInt();
+  return profile;
+}
+
+ProcessPriority::Profile ProcessPriority::background() {
+  Profile profile{};
+  profile.niceLevel =
+      preferences.readSetting(Preferences::Settings::PRIORITY_BACKGROUND_NICE)
+          .toInt();
+  profile.ioClass = static_cast<IoClass>(
+      preferences.readSetting(Preferences::Settings::PRIORITY_BACKGROUND_IO)
+          .toInt());
+  profile.cpuBudget =
+      preferences.readSetting(Preferences::Settings::PRIORITY_BACKGROUND_CPUS)
+          .toInt();
+  return profile;
+}
+
+void ProcessPriority::apply(QProcess *process, const Profile &profile) {
+#ifdef Q_OS_LINUX
+  const int niceLevel = qBound(-20, profile.niceLevel, 19);
+  const int ioprio = ioPriority(profile.ioClass);
+
+  // the mask is built here, as only async-signal-safe calls
+  // are allowed in the child between fork() and exec()
+  cpu_set_t cpus{};
+  bool restrictCpus = false;
+
+  if (profile.cpuBudget > 0 &&
+      sched_getaffinity(0, sizeof(cpus), &cpus) == 0 &&
+      profile.cpuBudget < CPU_COUNT(&cpus)) {
+    // keep the highest numbered cores, leaving the first ones free
+    int kept = 0;
+
+    for (int cpu = CPU_SETSIZE - 1; cpu >= 0; cpu--) {
+      if (CPU_ISSET(cpu, &cpus) && kept++ >= profile.cpuBudget) {
+        CPU_CLR(cpu, &cpus);
+      }
+    }
+
+    restrictCpus = true;
+  }
+
+  // failures are ignored, e.g. raising the priority without permission
+  // should still run Pack3r with the priority it would've had anyway
+  process->setChildProcessModifier([niceLevel, ioprio, cpus, restrictCpus] {
+    if (niceLevel != 0) {
+      setpriority(PRIO_PROCESS, 0, niceLevel);
+    }
+
+    if (ioprio != 0) {
+      syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, ioprio);
+    }
+
+    if (restrictCpus) {
+      sched_setaffinity(0, sizeof(cpus), &cpus);
+    }
+  });
+#else
+  Q_UNUSED(process)
+  Q_UNUSED(profile)
+#endif
+}
+
+bool ProcessPriority::isSupported() {
+#ifdef Q_OS_LINUX
+  return true;
+#else
+  return false;
+#endif
+}
+
+QJsonObject ProcessPriority::toJson(const Profile &profile) {
+  return {{"niceLevel", profile.niceLevel},
+          {"ioClass", profile.ioClass},
+          {"cpuBudget", profile.cpuBudget}};
+}
+
+ProcessPriority::Profile ProcessPriority::fromJson(const QJsonObject &json) {
+  Profile profile{};
+  profile.niceLevel = json["niceLevel"].toInt();
+  profile.ioClass = static_cast<IoClass>(
+      qBound(0, json["ioClass"].toInt(), NUM_IO_CLASSES - 1));
+  profile.cpuBudget = qMax(0, json["cpuBudget"].toInt());
+  return profile;
+}
@@ -0,0 +1,62 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QJsonObject>
+#include <QProcess>
+
+// Scheduling settings for spawned Pack3r processes, so that packing in the
+// background doesn't make the editor or the game stutter. Interactive runs
+// use the foreground profile, batch jobs use the background profile.
+//
+// Settings are only applied on Linux, elsewhere Pack3r runs with the
+// default priority of the application.
+class ProcessPriority {
+public:
+  enum IoClass {
+    IO_NORMAL,
+    IO_LOW,  // lowest level of the best-effort class
+    IO_IDLE, // only gets disk time when no one else needs it
+
+    NUM_IO_CLASSES // endcap
+  };
+
+  struct Profile {
+    int niceLevel{}; // negative values need CAP_SYS_NICE
+    IoClass ioClass{};
+    int cpuBudget{}; // number of cores to run on, 0 for all
+  };
+
+  static Profile foreground();
+  static Profile background();
+
+  // must be called before the process is started
+  static void apply(QProcess *process, const Profile &profile);
+  static bool isSupported();
+
+  // used to pass the profile of a job to the pack daemon
+  static QJsonObject toJson(const Profile &profile);
+  static Profile fromJson(const QJsonObject &json);
+};
@@ -30,18 +30,40 @@
 #include "qtpack3r_widget.h"
 #include "dialog.h"
 #include "filesystem.h"
+#include "pk3_browser_dialog.h"
+#include "pk3_diff_dialog.h"
 #include "preferences.h"
+#include "reference_explorer_dialog.h"
+#include "run_history_dialog.h"
 
+#include <QDateTime>
+#include <QLocale>
 #include <QMimeData>
 #include <QSignalBlocker>
+#include <QtConcurrent>
 
 QtPack3rWidget::QtPack3rWidget(
     QWidget *parent, const QPointer<PreferencesDialog> &preferencesDialogPtr)
     : QWidget(parent), preferencesDialog(preferencesDialogPtr) {
   setupCommands();
 
-  outputParser = new Pack3rOutputParser(this);
-  processHandler = new Pack3rProcessHandler(this, outputParser);
+  processHandler = new Pack3rProcessHandler(this);
+  batchRunner = new Pack3rBatchRunner(this);
+  mapSearchWatcher = new QFutureWatcher<QStringList>(this);
+  ninjaExportWatcher = new QFutureWatcher<QList<QStringList>>(this);
+  mapIndex = new MapIndex(this);
+  shaderIndex = new ShaderIndex(this);
+  preflightCheck = new PreflightCheck(this);
+  postPackRunner = new PostPackRunner(this);
+  duplicateAssetFinder = new DuplicateAssetFinder(this);
+  jankMonitor = new JankMonitor(this);
+  runHistory = new RunHistory(this);
+  referenceGraph = new ReferenceGraph(this);
+  runtimeBenchmark = new RuntimeBenchmark(this);
+  speculativeDryRun = new SpeculativeDryRun(this);
+  speculationTimer = new QTimer(this);
+  speculationTimer->setSingleShot(true);
+  speculationTimer->setInterval(500);
   clipboard = QApplication::clipboard();
 
   setLayout(buildUI());
@@ -53,7 +75,14 @@ QtPack3rWidget::QtPack3rWidget(
 
   checkPack3rVersion();
 
+  // the cached index is usable right away, the refresh only picks up changes
+  mapIndex->load();
+  mapIndex->refresh();
+  shaderIndex->load();
+  shaderIndex->refresh();
+
   setAcceptDrops(true);
+  speculationArmed = true;
 }
 
 void QtPack3rWidget::setupCommands() {
@@ -76,6 +105,13 @@ void QtPack3rWidget::parseOptions() const {
 
   setting = preferences.readSetting(Preferences::Settings::WRAP_OUTPUT_LINES);
   ui.output.wrapCheckbox->setChecked(setting.toBool());
+
+  setting = preferences.readSetting(Preferences::Settings::CAPTURE_ALL_OUTPUT);
+  ui.debug.captureAllCheckbox->setChecked(setting.toBool());
+
+  setting = preferences.readSetting(Preferences::Settings::HIGHLIGHT_OUTPUT);
+  ui.output.highlightCheckbox->setChecked(setting.toBool());
+  ui.output.outputField->setHighlighting(setting.toBool());
 }
 
 void QtPack3rWidget::setDefaults() {
@@ -108,18 +144,32 @@ void QtPack3rWidget::checkPack3rVersion() const {
 }
 
 void QtPack3rWidget::dragEnterEvent(QDragEnterEvent *event) {
-  // map files are text/plain mime type
-  if (event->mimeData()->hasText() && event->mimeData()->hasUrls()) {
+  // map files are text/plain mime type, but folders have no text,
+  // so accept any local url and filter out unsupported ones on drop
+  if (event->mimeData()->hasUrls()) {
     event->acceptProposedAction();
   }
 }
 
 void QtPack3rWidget::dropEvent(QDropEvent *event) {
-  // toLocalFile() always returns forward slashes
-  const QString file =
-      QDir::toNativeSeparators(event->mimeData()->urls().first().toLocalFile());
+  QStringList files{};
+  QStringList directories{};
+
+  for (const auto &url : event->mimeData()->urls()) {
+    // toLocalFile() always returns forward slashes
+    const QString path = QDir::toNativeSeparators(url.toLocalFile());
+
+    if (QFileInfo(path).isDir()) {
+      directories.append(path);
+    } else if (path.endsWith(".map") || path.endsWith(".reg")) {
+      files.append(path);
+    }
+  }
+
+  // a single map is just selected, every other drop is packed as a batch
+  if (directories.isEmpty() && files.size() == 1) {
+    const QString &file = files.first();
 
-  if (file.endsWith(".map") || file.endsWith(".reg")) {
     if (!isValidMapPath(file)) {
       QMessageBox dialog{};
       Dialog::setupMessageBox(dialog, Dialog::INVALID_MAP_PATH);
@@ -130,6 +180,256 @@ void QtPack3rWidget::dropEvent(QDropEvent *event) {
     ui.paths.mapPathField->setText(file);
     autoFillOutputPath(file);
     updateCommandPreview();
+    speculateDryRun();
+    return;
+  }
+
+  if (directories.isEmpty()) {
+    enqueueMaps(files);
+    return;
+  }
+
+  // walking a large directory tree can take a while, don't block the UI
+  if (mapSearchWatcher->isRunning()) {
+    return;
+  }
+
+  ui.statusBar.statusBarMessage->setText(tr("Searching for maps..."));
+  mapSearchWatcher->setFuture(QtConcurrent::run([files, directories] {
+    return files + FileSystem::findMapFiles(directories);
+  }));
+}
+
+void QtPack3rWidget::enqueueMaps(const QStringList &maps) {
+  ui.statusBar.statusBarMessage->clear();
+
+  QStringList validMaps{};
+
+  for (const auto &map : maps) {
+    if (isValidMapPath(map)) {
+      validMaps.append(map);
+    }
+  }
+
+  if (validMaps.isEmpty()) {
+    QMessageBox dialog{};
+    Dialog::setupMessageBox(dialog, Dialog::INVALID_MAP_PATH);
+    dialog.exec();
+    return;
+  }
+
+  const QString pack3rPath = ui.paths.pack3rPathField->text();
+
+  if (pack3rPath.isEmpty()) {
+    QMessageBox dialog{};
+    Dialog::setupMessageBox(dialog, Dialog::PACK3R_RUN_ERROR);
+    dialog.setText(tr("Unable to find Pack3r executable!"));
+    dialog.setInformativeText(
+        tr("Make sure path to Pack3r executable is set."));
+    dialog.exec();
+    return;
+  }
+
+  QMessageBox dialog{};
+  Dialog::setupMessageBox(dialog, Dialog::ENQUEUE_MAPS);
+  dialog.setText(tr("Pack %n map(s)?", "", static_cast<int>(validMaps.size())));
+
+  if (dialog.exec() != QMessageBox::Yes) {
+    return;
+  }
+
+  QList<Pack3rBatchRunner::BatchJob> jobs{};
+  const auto priority = ProcessPriority::background();
+  const auto runtime = RuntimeProfile::selected();
+
+  // a dry run doesn't read the compiled map
+  const bool compile = !pack3rCommands[DRYRUN].first;
+  // every pk3 would get the same name, and the output paths of the jobs
+  // wouldn't be where Pack3r writes them
+  const bool rename = validMaps.size() == 1;
+
+  if (pack3rCommands[RENAME].first && !rename) {
+    updatePack3rOutput(
+        tr("[batch] Rename (-r) is ignored when packing more than one map")
+            .toUtf8());
+  }
+
+  for (const auto &map : validMaps) {
+    const QString outputPath = outputPathForMap(map);
+    jobs.append({QFileInfo(map).completeBaseName(), pack3rPath,
+                 buildArguments(map, outputPath, rename), outputPath, priority,
+                 runtime,
+                 compile ? PrePackCommand::forMap(map)
+                         : PrePackCommand::Command{}});
+  }
+
+  QStringList outputs{};
+
+  for (const auto &job : jobs) {
+    outputs.append(job.outputFile);
+  }
+
+  if (startPreflight(validMaps, outputs, jobs)) {
+    return;
+  }
+
+  batchRunner->enqueue(jobs);
+  setRunningState(processHandler->isRunning());
+}
+
+bool QtPack3rWidget::startPreflight(
+    const QStringList &maps, const QStringList &outputs,
+    const QList<Pack3rBatchRunner::BatchJob> &jobs) {
+  if (!preferences.readSetting(Preferences::Settings::PREFLIGHT_ENABLED)
+           .toBool() ||
+      preferences.readSetting(Preferences::Settings::MAPS_PATH)
+          .toString()
+          .isEmpty()) {
+    return false;
+  }
+
+  if (preflightWaiting || preflightCheck->isRunning()) {
+    updatePack3rOutput(
+        tr("[preflight] Wait for the current check to finish").toUtf8());
+    return true;
+  }
+
+  preflightMaps = maps;
+  preflightOutputs = outputs;
+  preflightJobs = jobs;
+  preflightWaiting = true;
+  setRunningState(true);
+
+  // shaders defined in scripts would be reported as missing textures
+  // without the index, so wait for it if it's being built
+  if (shaderIndex->isRefreshing()) {
+    updatePack3rOutput(
+        tr("[preflight] Waiting for the shader index to be updated").toUtf8());
+  } else {
+    runPreflight();
+  }
+
+  return true;
+}
+
+void QtPack3rWidget::runPreflight() {
+  preflightWaiting = false;
+  preflightCheck->run(
+      preferences.readSetting(Preferences::Settings::MAPS_PATH).toString(),
+      preflightMaps, preflightOutputs, shaderIndex->allDefinitions());
+}
+
+void QtPack3rWidget::finishPreflight(const QStringList &passedMaps,
+                                     const bool canceled) {
+  const bool block =
+      preferences.readSetting(Preferences::Settings::PREFLIGHT_BLOCK_ON_ERRORS)
+          .toBool();
+  const QList<Pack3rBatchRunner::BatchJob> jobs =
+      std::exchange(preflightJobs, {});
+  preflightWaiting = false;
+
+  if (canceled) {
+    setRunningState(processHandler->isRunning());
+    return;
+  }
+
+  if (jobs.isEmpty()) {
+    if (!block || passedMaps.contains(runMapPath)) {
+      processHandler->spawnProcess(runCommand, runOutputFile, runPrePack);
+      return;
+    }
+
+    appendStatusLine(tr("[preflight] Pack3r was not run because of the "
+                        "errors above, blocking runs on errors can be "
+                        "turned off in preferences")
+                         .toUtf8(),
+                     Pack3rOutputParser::LOG_ERROR);
+    setRunningState(processHandler->isRunning());
+    return;
+  }
+
+  QList<Pack3rBatchRunner::BatchJob> runnable{};
+
+  for (qsizetype i = 0; i < jobs.size(); i++) {
+    if (!block || passedMaps.contains(preflightMaps[i])) {
+      runnable.append(jobs[i]);
+    }
+  }
+
+  if (runnable.size() < jobs.size()) {
+    appendStatusLine(tr("[preflight] Skipping %n map(s) with errors", "",
+                        static_cast<int>(jobs.size() - runnable.size()))
+                         .toUtf8(),
+                     Pack3rOutputParser::LOG_WARN);
+  }
+
+  if (!runnable.isEmpty()) {
+    batchRunner->enqueue(runnable);
+  }
+
+  setRunningState(processHandler->isRunning());
+}
+
+void QtPack3rWidget::speculateDryRun() {
+  speculationTimer->stop();
+
+  // the dry run would compete with a run for the same files
+  if (!preferences.readSetting(Preferences::Settings::SPECULATIVE_DRY_RUN)
+           .toBool() ||
+      processHandler->isRunning() || batchRunner->isRunning() ||
+      preflightWaiting || preflightCheck->isRunning()) {
+    return;
+  }
+
+  speculativeDryRun->start(currentCmd, ui.paths.mapPathField->text());
+}
+
+// shows the background dry run instead of running Pack3r again,
+// returns false if it isn't for the command being run or hasn't finished
+bool QtPack3rWidget::showSpeculativeDryRun() {
+  SpeculativeDryRun::Result result{};
+
+  if (!speculativeDryRun->result(runCommand, result)) {
+    return false;
+  }
+
+  updatePack3rOutput(
+      tr("[dry run] Showing the background dry run from %1")
+          .arg(QDateTime::fromMSecsSinceEpoch(result.finishedAt)
+                   .toString("HH:mm:ss"))
+          .toUtf8());
+  appendOutputBatch(result.lines);
+  updatePack3rOutput(
+      tr("[dry run] Pack3r exited with code %1").arg(result.exitCode).toUtf8());
+  return true;
+}
+
+void QtPack3rWidget::printMapAssets(const SpeculativeDryRun::Result &result) {
+  const QString mapName = QFileInfo(result.mapPath).fileName();
+
+  if (result.assets.isEmpty()) {
+    updatePack3rOutput(
+        tr("[assets] No assets found in the dry run of %1 (exit code %2)")
+            .arg(mapName)
+            .arg(result.exitCode)
+            .toUtf8());
+    return;
+  }
+
+  updatePack3rOutput(tr("[assets] %n asset(s) in the dry run of %1", "",
+                        static_cast<int>(result.assets.size()))
+                         .arg(mapName)
+                         .toUtf8());
+
+  if (result.exitCode != 0) {
+    updatePack3rOutput(
+        tr("[assets] Dry run exited with code %1, the list may be incomplete")
+            .arg(result.exitCode)
+            .toUtf8());
+  }
+
+  for (const auto &asset : result.assets) {
+    updatePack3rOutput("[assets]   " + asset.toUtf8());
   }
 }
 
@@ -241,8 +541,338 @@ void QtPack3rWidget::resetWidgetState() {
   updateCommandPreview();
 }
 
-void QtPack3rWidget::updatePack3rOutput(const QByteArray &data) const {
-  ui.output.outputField->appendPlainText(data);
+// status lines of QtPack3r itself, as opposed to Pack3r output
+void QtPack3rWidget::updatePack3rOutput(const QByteArrayView data) {
+  appendStatusLine(data, Pack3rOutputParser::LOG_INFO);
+}
+
+void QtPack3rWidget::appendStatusLine(
+    const QByteArrayView line, const Pack3rOutputParser::LogLevel level) {
+  addStatusLine(line, level, 0);
+}
+
+void QtPack3rWidget::appendOutputBatch(const QByteArray &lines) {
+  addOutputLines(lines, 0);
+}
+
+// batch job output is stored with the label of the job, instead of the
+// label being added to every line
+void QtPack3rWidget::appendJobStatus(const QString &label,
+                                     const QByteArray &line,
+                                     const Pack3rOutputParser::LogLevel level) {
+  addStatusLine(line, level, logStore.source(label));
+}
+
+void QtPack3rWidget::appendJobOutput(const QString &label,
+                                     const QByteArray &lines) {
+  addOutputLines(lines, logStore.source(label));
+}
+
+void QtPack3rWidget::addStatusLine(const QByteArrayView line,
+                                   const Pack3rOutputParser::LogLevel level,
+                                   const quint16 source) {
+  const JankMonitor::SlotTimer slotTimer(jankMonitor, "appendStatusLine");
+
+  if (logStore.append(line, level, source)) {
+    ui.output.outputField->linesAppended();
+  }
+}
+
+// the output field is only updated once per batch, no matter how many lines
+// it has, and lines are only decoded when they're painted
+void QtPack3rWidget::addOutputLines(const QByteArray &lines,
+                                    const quint16 source) {
+  const JankMonitor::SlotTimer slotTimer(jankMonitor, "appendOutputBatch");
+  const RunTrace::Scope traceScope("append output");
+  bool visible = false;
+  qsizetype start = 0;
+
+  while (start < lines.size()) {
+    qsizetype end = lines.indexOf('\n', start);
+
+    if (end == -1) {
+      end = lines.size();
+    }
+
+    const QByteArrayView line(lines.constData() + start, end - start);
+
+    if (logStore.append(line, source)) {
+      visible = true;
+    }
+
+    start = end + 1;
+  }
+
+  if (visible) {
+    ui.output.outputField->linesAppended();
+  }
+}
+
+void QtPack3rWidget::clearOutput() {
+  logStore.clear();
+  referenceGraph->clear();
+  ui.output.outputField->reset();
+  ui.output.outputField->resetAllocationCount();
+}
+
+void QtPack3rWidget::showRunDiagnostics() {
+  QMessageBox dialog{};
+  Dialog::setupMessageBox(dialog, Dialog::RUN_DIAGNOSTICS);
+
+  if (jankMonitor->report().eventLoop.count() == 0) {
+    dialog.setText(tr("No runs yet"));
+  } else {
+    dialog.setText(
+        JankMonitor::formatReport(jankMonitor->report(), true).join('\n'));
+  }
+
+  dialog.exec();
+}
+
+// allocations per MB of output from the parser and the log store,
+// as output handling is the hottest path of the application during a run.
+// Decoding visible lines and appending them to the output field isn't
+// counted, so this only covers storing the output, not displaying it
+void QtPack3rWidget::updateOutputStats() const {
+  const quint64 bytes = processHandler->outputBytes();
+  const quint64 allocations = processHandler->parserAllocations() +
+                              logStore.allocationCount() +
+                              ui.output.outputField->allocationCount();
+  const double megabytes = static_cast<double>(bytes) / (1024.0 * 1024.0);
+
+  ui.statusBar.statusBarMessage->setToolTip(
+      tr("Output: %1 lines, %2, %3 allocations per MB")
+          .arg(logStore.lineCount())
+          .arg(QLocale().formattedDataSize(static_cast<qint64>(bytes)))
+          .arg(megabytes > 0 ? static_cast<double>(allocations) / megabytes
+                             : 0.0,
+               0, 'f', 1));
+}
+
+void QtPack3rWidget::showRunHistory() {
+  auto *dialog = new RunHistoryDialog(this, runHistory,
+                                      ui.paths.mapPathField->text());
+  dialog->open();
+}
+
+// not modal, so the output can be followed while references arrive
+void QtPack3rWidget::showReferenceExplorer() {
+  auto *dialog = new ReferenceExplorerDialog(this, referenceGraph);
+  dialog->show();
+}
+
+void QtPack3rWidget::benchmarkRuntimeProfiles() {
+  if (processHandler->isRunning() || batchRunner->isRunning() ||
+      runtimeBenchmark->isRunning() || !canRunPack3r()) {
+    return;
+  }
+
+  const int rounds =
+      preferences.readSetting(Preferences::Settings::RUNTIME_BENCHMARK_ROUNDS)
+          .toInt();
+
+  QMessageBox dialog{};
+  Dialog::setupMessageBox(dialog, Dialog::RUNTIME_BENCHMARK);
+  dialog.setText(tr("Pack %1 %n time(s) with each profile?", "", rounds)
+                     .arg(QFileInfo(ui.paths.mapPathField->text()).fileName()));
+
+  if (dialog.exec() != QMessageBox::Yes) {
+    return;
+  }
+
+  speculativeDryRun->cancel();
+  clearOutput();
+
+  if (runtimeBenchmark->run(currentCmd, rounds)) {
+    setRunningState(true);
+  }
+}
+
+void QtPack3rWidget::browseOutput() {
+  const QString path = builtOutputPath(ui.paths.outputPathField->text(),
+                                       ui.paths.mapPathField->text());
+
+  if (!QFileInfo(path).isFile()) {
+    updatePack3rOutput(
+        tr("[pk3] %1 hasn't been built yet").arg(path).toUtf8());
+    return;
+  }
+
+  auto *dialog = new Pk3BrowserDialog(this);
+  QString error{};
+
+  if (!dialog->load(path, error)) {
+    appendStatusLine(
+        tr("[pk3] Unable to open %1: %2").arg(path, error).toUtf8(),
+        Pack3rOutputParser::LOG_ERROR);
+    delete dialog;
+    return;
+  }
+
+  dialog->open();
+}
+
+// compares against the pk3 as it was before it was last rebuilt,
+// or lets the user choose what to compare against if there's no such build
+void QtPack3rWidget::compareOutput() {
+  const QString path = builtOutputPath(ui.paths.outputPathField->text(),
+                                       ui.paths.mapPathField->text());
+  Pk3Diff::Listing before{};
+  Pk3Diff::Listing after{};
+  QString error{};
+
+  if (QFileInfo(path).isFile() && !Pk3Diff::read(path, after, error)) {
+    appendStatusLine(
+        tr("[pk3] Unable to open %1: %2").arg(path, error).toUtf8(),
+        Pack3rOutputParser::LOG_ERROR);
+    return;
+  }
+
+  if (!Pk3Diff::loadPrevious(path, before)) {
+    updatePack3rOutput(
+        tr("[pk3] No previous build of %1 recorded").arg(path).toUtf8());
+  }
+
+  auto *dialog = new Pk3DiffDialog(this);
+  dialog->compare(before, after);
+  dialog->open();
+}
+
+// commands are built like for a batch, dependencies are scanned the same way
+// as in the preflight check, along with the assets of a finished dry run
+void QtPack3rWidget::exportNinjaBuild() {
+  const QString mapsPath =
+      preferences.readSetting(Preferences::Settings::MAPS_PATH).toString();
+  const QString pack3rPath = ui.paths.pack3rPathField->text();
+
+  if (mapsPath.isEmpty()) {
+    updatePack3rOutput(
+        tr("[ninja] Set the default maps path in preferences first").toUtf8());
+    return;
+  }
+
+  if (pack3rPath.isEmpty()) {
+    updatePack3rOutput(tr("[ninja] Set the path to Pack3r first").toUtf8());
+    return;
+  }
+
+  if (ninjaExportWatcher->isRunning()) {
+    return;
+  }
+
+  const QStringList maps = QFileDialog::getOpenFileNames(
+      this, tr("Maps to export"), mapsPath + "/maps", tr("Maps (*.map)"));
+
+  if (maps.isEmpty()) {
+    return;
+  }
+
+  ninjaBuildPath = QFileDialog::getSaveFileName(
+      this, tr("Export Ninja build file"), "build.ninja",
+      tr("Ninja build files (*.ninja)"));
+
+  if (ninjaBuildPath.isEmpty()) {
+    return;
+  }
+
+  ninjaTargets.clear();
+  QList<QStringList> packedAssets{};
+  QStringList outputs{};
+
+  for (const auto &map : maps) {
+    const QString outputPath = outputPathForMap(map);
+    const QStringList arguments = buildArguments(map, outputPath);
+
+    // empty unless a dry run of the same command has finished
+    SpeculativeDryRun::Result dryRun{};
+    speculativeDryRun->result({pack3rPath, arguments}, dryRun);
+
+    packedAssets.append(dryRun.assets);
+    outputs.append(outputPath);
+    ninjaTargets.append({map, outputPath, pack3rPath, arguments, {}});
+  }
+
+  updatePack3rOutput(tr("[ninja] Scanning dependencies of %n map(s)", "",
+                        static_cast<int>(maps.size()))
+                         .toUtf8());
+
+  ninjaExportWatcher->setFuture(
+      QtConcurrent::run(&PreflightCheck::dependencies, preflightCheck,
+                        mapsPath, maps, packedAssets, outputs,
+                        shaderIndex->allDefinitions()));
+}
+
+void QtPack3rWidget::writeNinjaBuild() {
+  const auto dependencies = ninjaExportWatcher->result();
+
+  for (qsizetype i = 0; i < ninjaTargets.size(); i++) {
+    ninjaTargets[i].dependencies = dependencies.value(i);
+  }
+
+  QString error{};
+
+  if (!NinjaExport::write(ninjaBuildPath, ninjaTargets, error)) {
+    appendStatusLine(tr("[ninja] %1").arg(error).toUtf8(),
+                     Pack3rOutputParser::LOG_ERROR);
+    return;
+  }
+
+  updatePack3rOutput(tr("[ninja] Wrote %1 with %n map(s)", "",
+                        static_cast<int>(ninjaTargets.size()))
+                         .arg(ninjaBuildPath)
+                         .toUtf8());
+}
+
+// the whole log is copied here, as the log store is cleared on the next run
+void QtPack3rWidget::recordRun(const int exitCode) {
+  RunHistory::Run run{};
+  run.startedAt = runStartedAt;
+  run.map = runMapPath;
+  run.program = runCommand.first;
+  run.arguments = runCommand.second;
+  run.pack3rVersion = ui.statusBar.pack3rVersion->text();
+  run.durationMs = runTimer.elapsed();
+  run.exitCode = exitCode;
+  run.outputBytes = processHandler->outputBytes();
+  run.lineCount = logStore.lineCount();
+
+  QByteArray log{};
+  log.reserve(static_cast<qsizetype>(run.outputBytes + run.lineCount));
+
+  for (qsizetype i = 0; i < logStore.lineCount(); i++) {
+    log.append(logStore.line(static_cast<quint32>(i)));
+    log.append('\n');
+  }
+
+  runHistory->record(run, log);
+}
+
+// traces are named after the output, and kept per run so runs can be compared.
+// Dry runs have no output, so they're named after the map instead
+void QtPack3rWidget::writeRunTrace() {
+  QString name = QFileInfo(runOutputFile).completeBaseName();
+
+  if (name.isEmpty()) {
+    name = QFileInfo(runMapPath).completeBaseName();
+  }
+
+  if (name.isEmpty()) {
+    name = "dryrun";
+  }
+
+  const QString path = FileSystem::getCacheFilePath(
+      QString("trace-%1-%2.json")
+          .arg(name, QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")));
+  QString error{};
+
+  if (RunTrace::finish(path, error)) {
+    updatePack3rOutput("[trace] " + tr("Wrote trace to %1").arg(path).toUtf8());
+  } else {
+    appendStatusLine(
+        "[trace] " +
+            tr("Unable to write trace to %1: %2").arg(path, error).toUtf8(),
+        Pack3rOutputParser::LOG_WARN);
+  }
 }
 
 void QtPack3rWidget::updatePack3rPath(const QString &newPath) {
@@ -254,3 +884,9 @@ void QtPack3rWidget::updatePack3rPath(const QString &newPath) {
 void QtPack3rWidget::setPack3rVersionString(const QString &version) const {
   ui.statusBar.pack3rVersion->setText(version);
 }
+
+void QtPack3rWidget::setRunningState(const bool running) const {
+  ui.commandPreview.runButton->setEnabled(!running);
+  ui.commandPreview.cancelButton->setEnabled(running ||
+                                             batchRunner->isRunning());
+}
@@ -24,9 +24,25 @@
 
 #pragma once
 
+#include "duplicate_asset_finder.h"
+#include "jank_monitor.h"
+#include "map_index.h"
+#include "ninja_export.h"
+#include "pack3r_batch_runner.h"
+#include "pack3r_log_store.h"
+#include "pack3r_output_field.h"
 #include "pack3r_output_parser.h"
 #include "pack3r_process_handler.h"
+#include "post_pack_runner.h"
+#include "preflight_check.h"
+#include "pre_pack_command.h"
 #include "preferences.h"
+#include "reference_graph.h"
+#include "run_history.h"
+#include "run_trace.h"
+#include "runtime_benchmark.h"
+#include "shader_index.h"
+#include "speculative_dry_run.h"
 
 #include <QApplication>
 #include <QButtonGroup>
@@ -34,7 +50,9 @@
 #include <QClipboard>
 #include <QComboBox>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFileDialog>
+#include <QFutureWatcher>
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QLabel>
@@ -46,6 +64,7 @@
 #include <QPushButton>
 #include <QScrollBar>
 #include <QStatusBar>
+#include <QTimer>
 
 // Linux users will very likely have a system-wide monospace font set to one
 // they prefer, but Windows default is 'Courier New', which looks awful here.
@@ -67,6 +86,17 @@ class QtPack3rWidget : public QWidget {
 public slots:
   void findPack3r();
   void openMap();
+  void openMapPicker();
+  void findDuplicateAssets();
+  void checkMapShaders();
+  void showMapAssets();
+  void showRunDiagnostics();
+  void showRunHistory();
+  void showReferenceExplorer();
+  void benchmarkRuntimeProfiles();
+  void browseOutput();
+  void compareOutput();
+  void exportNinjaBuild();
   void setOutput();
 
 private:
@@ -101,6 +131,12 @@ public slots:
       "None", "Fatal", "Error", "Warn", "Info (Default)", "Debug", "Trace",
   };
 
+  // same order as Pack3rLogStore::Filter
+  const QStringList outputFilters = {
+      "Fatal", "Error",       "Warn",         "Info",
+      "Debug", "Trace (All)", "Shader debug", "Reference debug",
+  };
+
   // user interface building
   QGridLayout *buildUI();
   void setupPathsGroupBox();
@@ -120,17 +156,41 @@ public slots:
 
   // state management
   void updateCommandPreview();
+  QStringList buildArguments(const QString &mapPath,
+                             const QString &outputPath,
+                             bool rename = true) const;
   void updateCheckbox(Pack3rOptions option, bool isChecked,
                       QLineEdit *field = nullptr);
   void updateOptionValue(Pack3rOptions option, const QString &value);
   void updateComboboxValue(Pack3rOptions option, const QString &value);
+  void addStatusLine(QByteArrayView line, Pack3rOutputParser::LogLevel level,
+                     quint16 source);
+  void addOutputLines(const QByteArray &lines, quint16 source);
+  void clearOutput();
+  void updateOutputStats() const;
+  void writeRunTrace();
+  void recordRun(int exitCode);
+
+  // returns false if the check is turned off, and the maps can be run
+  bool startPreflight(const QStringList &maps, const QStringList &outputs,
+                      const QList<Pack3rBatchRunner::BatchJob> &jobs = {});
+  void runPreflight();
+  void finishPreflight(const QStringList &passedMaps, bool canceled);
+  void speculateDryRun();
+  bool showSpeculativeDryRun();
+  void printMapAssets(const SpeculativeDryRun::Result &result);
+  void writeNinjaBuild();
 
   void setupCommands();
   void parseOptions() const;
   void setDefaults();
 
   bool canRunPack3r() const;
+  void selectMap(const QString &path);
   void autoFillOutputPath(const QString &file) const;
+  QString outputPathForMap(const QString &file) const;
+  QString builtOutputPath(const QString &outputPath,
+                          const QString &mapPath) const;
   static bool isValidMapPath(const QString &path);
   void replaceMapFileExtension(QString &str) const;
   void updateOutputExtension() const;
@@ -138,6 +198,7 @@ public slots:
 
   void dragEnterEvent(QDragEnterEvent *event) override;
   void dropEvent(QDropEvent *event) override;
+  void enqueueMaps(const QStringList &maps);
 
   const QString noScanDefaultStr = "pak1.pk3 pak2.pk3 mp_bin.pk3";
   const QString noPackDefaultStr =
@@ -146,9 +207,52 @@ public slots:
 
   QClipboard *clipboard{};
   Pack3rProcessHandler *processHandler;
-  QPointer<Pack3rOutputParser> outputParser;
+  Pack3rBatchRunner *batchRunner;
+  QFutureWatcher<QStringList> *mapSearchWatcher;
+  MapIndex *mapIndex;
+  ShaderIndex *shaderIndex;
+  PreflightCheck *preflightCheck;
+  PostPackRunner *postPackRunner;
+  DuplicateAssetFinder *duplicateAssetFinder;
+  JankMonitor *jankMonitor;
+  RunHistory *runHistory;
+  ReferenceGraph *referenceGraph;
+  RuntimeBenchmark *runtimeBenchmark;
+  SpeculativeDryRun *speculativeDryRun;
+
+  // restarts the dry run once options have stopped changing
+  QTimer *speculationTimer;
+  // set once the widget is set up, so only the user's edits start dry runs
+  bool speculationArmed{};
+  // assets are printed once the dry run finishes
+  bool mapAssetsRequested{};
+
+  // output file of the current run, the field can be edited while it runs
+  QString runOutputFile;
+  // what was run, recorded into run history once the run finishes
+  QString runMapPath;
+  QPair<QString, QStringList> runCommand{};
+  PrePackCommand::Command runPrePack{};
+  qint64 runStartedAt{};
+  QElapsedTimer runTimer;
+
+  // maps being checked before they're run, along with their batch jobs,
+  // which are empty when the map in the paths is being run
+  QStringList preflightMaps;
+  QList<Pack3rBatchRunner::BatchJob> preflightJobs;
+  QStringList preflightOutputs;
+  bool preflightWaiting{};
+
+  // maps being exported as a Ninja build file, waiting for the
+  // dependency scan
+  QFutureWatcher<QList<QStringList>> *ninjaExportWatcher;
+  QList<NinjaExport::Target> ninjaTargets;
+  QString ninjaBuildPath;
+
   QPointer<PreferencesDialog> preferencesDialog;
 
+  Pack3rLogStore logStore;
+
   QGridLayout *layout{};
 
   struct Option {
@@ -180,6 +284,7 @@ public slots:
     QCheckBox *outputCheckbox{};
     QLineEdit *outputPathField{};
     QAction *outputPathAction{};
+    QAction *outputBrowseAction{};
   };
 
   struct UIOptions {
@@ -215,6 +320,7 @@ public slots:
     QComboBox *verbosityCombobox{};
     QCheckBox *shaderDebugCheckbox{};
     QCheckBox *referenceDebugCheckbox{};
+    QCheckBox *captureAllCheckbox{};
   };
 
   struct UICommandPreview {
@@ -226,6 +332,7 @@ public slots:
     QHBoxLayout *buttonLayout{};
 
     QPushButton *runButton{};
+    QPushButton *cancelButton{};
     QPushButton *copyButton{};
     QPushButton *resetButton{};
   };
@@ -234,11 +341,14 @@ public slots:
     QGroupBox *groupBox{};
     QGridLayout *layout{};
 
-    QPlainTextEdit *outputField{};
+    Pack3rOutputField *outputField{};
 
     QHBoxLayout *buttonLayout{};
 
     QCheckBox *wrapCheckbox{};
+    QCheckBox *highlightCheckbox{};
+    QLabel *filterLabel{};
+    QComboBox *filterCombobox{};
     QPushButton *copyButton{};
     QPushButton *clearButton{};
   };
@@ -263,9 +373,16 @@ public slots:
   UI ui{};
 
 private slots:
-  void updatePack3rOutput(const QByteArray &data) const;
+  void updatePack3rOutput(QByteArrayView data);
+  void appendStatusLine(QByteArrayView line,
+                        Pack3rOutputParser::LogLevel level);
+  void appendOutputBatch(const QByteArray &lines);
+  void appendJobStatus(const QString &label, const QByteArray &line,
+                       Pack3rOutputParser::LogLevel level);
+  void appendJobOutput(const QString &label, const QByteArray &lines);
   void copyFieldToClipboard(const QPlainTextEdit *field) const;
   void resetWidgetState();
   void updatePack3rPath(const QString &newPath);
   void setPack3rVersionString(const QString &version) const;
+  void setRunningState(bool running) const;
 };
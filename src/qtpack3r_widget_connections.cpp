@@ -22,9 +22,12 @@
  * SOFTWARE.
  */
 
+#include "pk3_diff.h"
 #include "preferences.h"
 #include "qtpack3r_widget.h"
 
+#include <QDateTime>
+
 void QtPack3rWidget::setupConnections() {
   setupPathsConnections();
   setupOptionsConnections();
@@ -40,7 +43,7 @@ void QtPack3rWidget::setupPathsConnections() {
   connect(preferencesDialog, &PreferencesDialog::pack3rPathChanged, this,
           &QtPack3rWidget::updatePack3rPath);
 
-  connect(outputParser, &Pack3rOutputParser::pack3rVersionParsed, this,
+  connect(processHandler, &Pack3rProcessHandler::pack3rVersionParsed, this,
           &QtPack3rWidget::setPack3rVersionString);
 
   connect(ui.paths.mapPathAction, &QAction::triggered, this,
@@ -52,6 +55,8 @@ void QtPack3rWidget::setupPathsConnections() {
   });
   connect(ui.paths.outputPathAction, &QAction::triggered, this,
           &QtPack3rWidget::setOutput);
+  connect(ui.paths.outputBrowseAction, &QAction::triggered, this,
+          &QtPack3rWidget::browseOutput);
   connect(ui.paths.outputPathField, &QLineEdit::textChanged, this,
           [&] { updateOptionValue(OUTPUT, ui.paths.outputPathField->text()); });
 }
@@ -114,6 +119,15 @@ void QtPack3rWidget::setupDebugConnections() {
   connect(ui.debug.referenceDebugCheckbox, &QCheckBox::toggled, this, [&] {
     updateCheckbox(REFDEBUG, ui.debug.referenceDebugCheckbox->isChecked());
   });
+  connect(ui.debug.captureAllCheckbox, &QCheckBox::toggled, this, [&] {
+    const bool captureAll = ui.debug.captureAllCheckbox->isChecked();
+    ui.debug.verbosityCombobox->setEnabled(!captureAll);
+    ui.debug.shaderDebugCheckbox->setEnabled(!captureAll);
+    ui.debug.referenceDebugCheckbox->setEnabled(!captureAll);
+    preferences.writeSetting(Preferences::Settings::CAPTURE_ALL_OUTPUT,
+                             captureAll);
+    updateCommandPreview();
+  });
 }
 
 void QtPack3rWidget::setupCommandPreviewConnections() {
@@ -123,11 +137,146 @@ void QtPack3rWidget::setupCommandPreviewConnections() {
               return;
             }
 
-            ui.output.outputField->clear();
-            processHandler->spawnProcess(currentCmd,
-                                         ui.paths.outputPathField->text());
+            clearOutput();
+            runOutputFile = ui.paths.outputPathField->text();
+            runMapPath = ui.paths.mapPathField->text();
+            runCommand = currentCmd;
+            runPrePack = pack3rCommands[DRYRUN].first
+                             ? PrePackCommand::Command{}
+                             : PrePackCommand::forMap(runMapPath);
+
+            if (pack3rCommands[DRYRUN].first && showSpeculativeDryRun()) {
+              return;
+            }
+
+            // Pack3r reads the same files, don't compete with it
+            speculativeDryRun->cancel();
+
+            if (!startPreflight({runMapPath}, {runOutputFile})) {
+              processHandler->spawnProcess(runCommand, runOutputFile,
+                                           runPrePack);
+            }
+          });
+
+  connect(ui.commandPreview.cancelButton, &QPushButton::released, this, [&] {
+    if (preflightWaiting) {
+      finishPreflight({}, true);
+    }
+
+    preflightCheck->cancel();
+    processHandler->cancelProcess();
+    batchRunner->cancelAll();
+    postPackRunner->cancel();
+    runtimeBenchmark->cancel();
+  });
+
+  connect(processHandler, &Pack3rProcessHandler::processStarted, this, [&] {
+    if (preferences.readSetting(Preferences::Settings::DIAGNOSTICS_TRACE)
+            .toBool()) {
+      RunTrace::begin();
+    }
+
+    // Pack3r doesn't write the pk3 until it has parsed the whole map
+    if (!pack3rCommands[DRYRUN].first) {
+      Pk3Diff::savePrevious(builtOutputPath(runOutputFile, runMapPath));
+    }
+
+    jankMonitor->start();
+    runStartedAt = QDateTime::currentMSecsSinceEpoch();
+    runTimer.start();
+    setRunningState(true);
+  });
+  connect(processHandler, &Pack3rProcessHandler::processFinished, this,
+          [&](const int exitCode) {
+            updateOutputStats();
+            jankMonitor->stop();
+            recordRun(exitCode);
+
+            if (preferences
+                    .readSetting(Preferences::Settings::DIAGNOSTICS_REPORT)
+                    .toBool()) {
+              const bool includeStalls =
+                  preferences
+                      .readSetting(Preferences::Settings::DIAGNOSTICS_STALLS)
+                      .toBool();
+
+              for (const auto &line : JankMonitor::formatReport(
+                       jankMonitor->report(), includeStalls)) {
+                updatePack3rOutput("[diagnostics] " + line.toUtf8());
+              }
+            }
+
+            if (RunTrace::isActive()) {
+              writeRunTrace();
+            }
+
+            // a dry run doesn't write anything for post-pack stages to use,
+            // otherwise stay in running state until the stages finish
+            if (exitCode != 0 || pack3rCommands[DRYRUN].first ||
+                !postPackRunner->run(
+                    builtOutputPath(runOutputFile, runMapPath))) {
+              setRunningState(false);
+            }
+          });
+
+  connect(postPackRunner, &PostPackRunner::outputLine, this,
+          &QtPack3rWidget::updatePack3rOutput);
+  connect(postPackRunner, &PostPackRunner::finished, this,
+          [&] { setRunningState(false); });
+
+  connect(runHistory, &RunHistory::outputLine, this,
+          &QtPack3rWidget::updatePack3rOutput);
+
+  connect(runtimeBenchmark, &RuntimeBenchmark::outputLine, this,
+          &QtPack3rWidget::updatePack3rOutput);
+  connect(runtimeBenchmark, &RuntimeBenchmark::finished, this,
+          [&] { setRunningState(processHandler->isRunning()); });
+
+  connect(shaderIndex, &ShaderIndex::outputLine, this,
+          &QtPack3rWidget::updatePack3rOutput);
+  connect(shaderIndex, &ShaderIndex::indexUpdated, this, [&] {
+    if (preflightWaiting && !shaderIndex->isRefreshing()) {
+      runPreflight();
+    }
+  });
+
+  connect(speculationTimer, &QTimer::timeout, this,
+          &QtPack3rWidget::speculateDryRun);
+  connect(speculativeDryRun, &SpeculativeDryRun::finished, this, [&] {
+    SpeculativeDryRun::Result result{};
+
+    if (mapAssetsRequested && speculativeDryRun->result(currentCmd, result)) {
+      mapAssetsRequested = false;
+      printMapAssets(result);
+    }
+  });
+
+  connect(preflightCheck, &PreflightCheck::outputLine, this,
+          &QtPack3rWidget::appendStatusLine);
+  connect(preflightCheck, &PreflightCheck::finished, this,
+          &QtPack3rWidget::finishPreflight);
+
+  connect(duplicateAssetFinder, &DuplicateAssetFinder::outputLine, this,
+          &QtPack3rWidget::updatePack3rOutput);
+
+  connect(batchRunner, &Pack3rBatchRunner::outputLine, this,
+          &QtPack3rWidget::updatePack3rOutput);
+  connect(batchRunner, &Pack3rBatchRunner::outputReady, this,
+          &QtPack3rWidget::appendJobOutput);
+  connect(batchRunner, &Pack3rBatchRunner::jobStatus, this,
+          &QtPack3rWidget::appendJobStatus);
+  connect(batchRunner, &Pack3rBatchRunner::progressChanged, this,
+          [&](const int finished, const int total) {
+            ui.statusBar.statusBarMessage->setText(
+                tr("Batch: %1/%2 maps packed").arg(finished).arg(total));
+            setRunningState(processHandler->isRunning());
           });
 
+  connect(mapSearchWatcher, &QFutureWatcher<QStringList>::finished, this,
+          [&] { enqueueMaps(mapSearchWatcher->result()); });
+  connect(ninjaExportWatcher, &QFutureWatcher<QList<QStringList>>::finished,
+          this, &QtPack3rWidget::writeNinjaBuild);
+
   connect(ui.commandPreview.copyButton, &QPushButton::released, this,
           [&] { copyFieldToClipboard(ui.commandPreview.commandPreviewField); });
 
@@ -136,21 +285,34 @@ void QtPack3rWidget::setupCommandPreviewConnections() {
 }
 
 void QtPack3rWidget::setupOutputConnections() {
-  connect(outputParser, &Pack3rOutputParser::pack3rOutputProcessed, this,
-          &QtPack3rWidget::updatePack3rOutput);
+  connect(processHandler, &Pack3rProcessHandler::outputReady, this,
+          &QtPack3rWidget::appendOutputBatch);
+  connect(processHandler, &Pack3rProcessHandler::referencesParsed,
+          referenceGraph, &ReferenceGraph::add);
 
   connect(ui.output.wrapCheckbox, &QCheckBox::toggled, this, [&] {
-    const auto wrapMode = ui.output.wrapCheckbox->isChecked()
-                              ? QTextOption::WrapAtWordBoundaryOrAnywhere
-                              : QTextOption::NoWrap;
-    ui.output.outputField->setWordWrapMode(wrapMode);
+    ui.output.outputField->setWrapping(ui.output.wrapCheckbox->isChecked());
     preferences.writeSetting(Preferences::Settings::WRAP_OUTPUT_LINES,
                              ui.output.wrapCheckbox->isChecked());
   });
 
+  connect(ui.output.highlightCheckbox, &QCheckBox::toggled, this, [&] {
+    ui.output.outputField->setHighlighting(
+        ui.output.highlightCheckbox->isChecked());
+    preferences.writeSetting(Preferences::Settings::HIGHLIGHT_OUTPUT,
+                             ui.output.highlightCheckbox->isChecked());
+  });
+
   connect(ui.output.copyButton, &QPushButton::released, this,
-          [&] { copyFieldToClipboard(ui.output.outputField); });
+          [&] { clipboard->setText(ui.output.outputField->text()); });
+
+  connect(ui.output.filterCombobox, &QComboBox::currentIndexChanged, this,
+          [&] {
+            logStore.setFilter(static_cast<Pack3rLogStore::Filter>(
+                ui.output.filterCombobox->currentIndex()));
+            ui.output.outputField->reset();
+          });
 
   connect(ui.output.clearButton, &QPushButton::released, this,
-          [&] { ui.output.outputField->clear(); });
+          &QtPack3rWidget::clearOutput);
 }
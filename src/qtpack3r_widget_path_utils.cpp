@@ -28,6 +28,7 @@
 
 #include "dialog.h"
 #include "filesystem.h"
+#include "map_picker_dialog.h"
 #include "preferences.h"
 
 void QtPack3rWidget::findPack3r() {
@@ -54,6 +55,88 @@ void QtPack3rWidget::openMap() {
     return;
   }
 
+  selectMap(path);
+}
+
+void QtPack3rWidget::openMapPicker() {
+  ui.paths.defaultMapPathSet =
+      !preferences.readSetting(Preferences::Settings::MAPS_PATH)
+           .toString()
+           .isEmpty();
+
+  auto *picker = new MapPickerDialog(this, mapIndex);
+  connect(picker, &MapPickerDialog::mapSelected, this,
+          [&](const QString &path) { selectMap(path); });
+  picker->open();
+}
+
+void QtPack3rWidget::findDuplicateAssets() {
+  const QString mapsPath =
+      preferences.readSetting(Preferences::Settings::MAPS_PATH).toString();
+
+  if (mapsPath.isEmpty()) {
+    updatePack3rOutput(
+        tr("[duplicates] Set the default maps path in preferences first")
+            .toUtf8());
+    return;
+  }
+
+  if (duplicateAssetFinder->isRunning()) {
+    return;
+  }
+
+  duplicateAssetFinder->run(
+      mapsPath, ui.paths.outputPathField->text(),
+      ui.options.noPackField->text().split(' ', Qt::SkipEmptyParts));
+}
+
+void QtPack3rWidget::checkMapShaders() {
+  if (preferences.readSetting(Preferences::Settings::MAPS_PATH)
+          .toString()
+          .isEmpty()) {
+    updatePack3rOutput(
+        tr("[shaders] Set the default maps path in preferences first")
+            .toUtf8());
+    return;
+  }
+
+  if (ui.paths.mapPathField->text().isEmpty()) {
+    updatePack3rOutput(tr("[shaders] Select a map first").toUtf8());
+    return;
+  }
+
+  shaderIndex->checkMap(ui.paths.mapPathField->text());
+}
+
+void QtPack3rWidget::showMapAssets() {
+  if (ui.paths.pack3rPathField->text().isEmpty()) {
+    updatePack3rOutput(tr("[assets] Set the path to Pack3r first").toUtf8());
+    return;
+  }
+
+  if (ui.paths.mapPathField->text().isEmpty()) {
+    updatePack3rOutput(tr("[assets] Select a map first").toUtf8());
+    return;
+  }
+
+  SpeculativeDryRun::Result result{};
+
+  if (speculativeDryRun->result(currentCmd, result)) {
+    printMapAssets(result);
+    return;
+  }
+
+  mapAssetsRequested = true;
+  updatePack3rOutput(tr("[assets] Waiting for a dry run of %1")
+                         .arg(QFileInfo(ui.paths.mapPathField->text())
+                                  .fileName())
+                         .toUtf8());
+
+  // already running if the map was dry run in the background
+  speculativeDryRun->start(currentCmd, ui.paths.mapPathField->text());
+}
+
+void QtPack3rWidget::selectMap(const QString &path) {
   if (!isValidMapPath(path)) {
     QMessageBox dialog{};
     Dialog::setupMessageBox(dialog, Dialog::INVALID_MAP_PATH);
@@ -83,10 +166,13 @@ void QtPack3rWidget::openMap() {
 
       preferences.writeSetting(Preferences::Settings::MAPS_PATH,
                                splits.join(NATIVE_PATHSEP) + NATIVE_PATHSEP);
+      mapIndex->refresh();
+      shaderIndex->refresh();
     }
   }
 
   updateCommandPreview();
+  speculateDryRun();
 }
 
 void QtPack3rWidget::setOutput() {
@@ -117,12 +203,27 @@ bool QtPack3rWidget::isValidMapPath(const QString &path) {
 }
 
 void QtPack3rWidget::autoFillOutputPath(const QString &file) const {
+  ui.paths.outputPathField->setText(outputPathForMap(file));
+}
+
+QString QtPack3rWidget::outputPathForMap(const QString &file) const {
   const QString mapsDir = QDir::toNativeSeparators("maps/");
   QString outputPath = file;
 
   outputPath.remove(mapsDir, Qt::CaseInsensitive);
   replaceMapFileExtension(outputPath);
-  ui.paths.outputPathField->setText(outputPath);
+  return outputPath;
+}
+
+// output written to a directory is named after the map
+QString QtPack3rWidget::builtOutputPath(const QString &outputPath,
+                                        const QString &mapPath) const {
+  if (QFileInfo(outputPath).isDir() && !mapPath.isEmpty()) {
+    return QDir(outputPath).filePath(
+        QFileInfo(outputPathForMap(mapPath)).fileName());
+  }
+
+  return outputPath;
 }
 
 void QtPack3rWidget::replaceMapFileExtension(QString &str) const {
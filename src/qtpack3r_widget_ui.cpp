@@ -80,6 +80,10 @@ void QtPack3rWidget::setupPathsGroupBox() {
   ui.paths.outputPathAction = ui.paths.outputPathField->addAction(
       QApplication::style()->standardIcon(QStyle::SP_DialogOpenButton),
       QLineEdit::ActionPosition::TrailingPosition);
+  ui.paths.outputBrowseAction = ui.paths.outputPathField->addAction(
+      QApplication::style()->standardIcon(QStyle::SP_FileDialogContentsView),
+      QLineEdit::ActionPosition::TrailingPosition);
+  ui.paths.outputBrowseAction->setToolTip(tr("Browse contents of the pk3"));
 
   ui.paths.layout = new QGridLayout;
 
@@ -212,6 +216,11 @@ void QtPack3rWidget::setupDebugGroupBox() {
   ui.debug.referenceDebugCheckbox->setToolTip(
       tr("Print asset resolution details (Info verbosity needed)"));
 
+  ui.debug.captureAllCheckbox = new QCheckBox(tr("Capture everything"), this);
+  ui.debug.captureAllCheckbox->setToolTip(
+      tr("Always run with Trace verbosity, shader debug and reference debug, "
+         "and filter the output afterwards instead of re-running Pack3r"));
+
   ui.debug.verbosityLayout = new QGridLayout;
   ui.debug.verbosityLayout->addWidget(ui.debug.verbosityLabel, 0, 0, 1, 1);
   ui.debug.verbosityLayout->addWidget(ui.debug.verbosityCombobox, 0, 1, 1, 2);
@@ -220,6 +229,7 @@ void QtPack3rWidget::setupDebugGroupBox() {
   ui.debug.mainLayout->addLayout(ui.debug.verbosityLayout, 0, 0, 1, 2);
   ui.debug.mainLayout->addWidget(ui.debug.shaderDebugCheckbox, 0, 2);
   ui.debug.mainLayout->addWidget(ui.debug.referenceDebugCheckbox, 0, 3);
+  ui.debug.mainLayout->addWidget(ui.debug.captureAllCheckbox, 0, 4);
 
   ui.debug.groupBox->setLayout(ui.debug.mainLayout);
 }
@@ -240,6 +250,10 @@ void QtPack3rWidget::setupCommandPreviewGroupBox() {
   ui.commandPreview.runButton = new QPushButton(tr("Run Pack3r"), this);
   ui.commandPreview.runButton->setToolTip(tr("Run command with Pack3r"));
 
+  ui.commandPreview.cancelButton = new QPushButton(tr("Cancel"), this);
+  ui.commandPreview.cancelButton->setToolTip(tr("Cancel the running command"));
+  ui.commandPreview.cancelButton->setEnabled(false);
+
   ui.commandPreview.copyButton = new QPushButton(tr("Copy"), this);
   ui.commandPreview.copyButton->setToolTip(
       tr("Copy the current command to clipboard"));
@@ -249,6 +263,7 @@ void QtPack3rWidget::setupCommandPreviewGroupBox() {
 
   ui.commandPreview.buttonLayout = new QHBoxLayout;
   ui.commandPreview.buttonLayout->addWidget(ui.commandPreview.runButton);
+  ui.commandPreview.buttonLayout->addWidget(ui.commandPreview.cancelButton);
   ui.commandPreview.buttonLayout->addStretch(1);
   ui.commandPreview.buttonLayout->addWidget(ui.commandPreview.copyButton);
   ui.commandPreview.buttonLayout->addWidget(ui.commandPreview.resetButton);
@@ -264,15 +279,32 @@ void QtPack3rWidget::setupCommandPreviewGroupBox() {
 void QtPack3rWidget::setupOutputGroupBox() {
   ui.output.groupBox = new QGroupBox(tr("Output"), this);
 
-  ui.output.outputField = new QPlainTextEdit(this);
-  ui.output.outputField->setReadOnly(true);
+  ui.output.outputField = new Pack3rOutputField(logStore, this);
   ui.output.outputField->setFont(MONOSPACE_FONT);
-  ui.output.outputField->setWordWrapMode(QTextOption::NoWrap);
 
   ui.output.wrapCheckbox = new QCheckBox(tr("Wrap lines"), this);
   ui.output.wrapCheckbox->setToolTip(
       tr("Toggle line wrapping for the output display"));
 
+  ui.output.highlightCheckbox = new QCheckBox(tr("Highlight"), this);
+  ui.output.highlightCheckbox->setToolTip(
+      tr("Highlight log levels, missing assets and asset paths in the output"));
+
+  const QString filterToolTip =
+      tr("Show only output up to the selected log level, or only shader or "
+         "reference debug output");
+  ui.output.filterLabel = new QLabel(tr("Show"), this);
+  ui.output.filterLabel->setToolTip(filterToolTip);
+
+  ui.output.filterCombobox = new QComboBox(this);
+  ui.output.filterCombobox->setToolTip(filterToolTip);
+
+  for (const auto &filter : outputFilters) {
+    ui.output.filterCombobox->addItem(tr("%1").arg(filter));
+  }
+
+  ui.output.filterCombobox->setCurrentIndex(Pack3rLogStore::FILTER_TRACE);
+
   ui.output.copyButton = new QPushButton(tr("Copy"), this);
   ui.output.copyButton->setToolTip(tr("Copy current output to clipboard"));
 
@@ -281,7 +313,10 @@ void QtPack3rWidget::setupOutputGroupBox() {
 
   ui.output.buttonLayout = new QHBoxLayout;
   ui.output.buttonLayout->addWidget(ui.output.wrapCheckbox);
+  ui.output.buttonLayout->addWidget(ui.output.highlightCheckbox);
   ui.output.buttonLayout->addStretch(1);
+  ui.output.buttonLayout->addWidget(ui.output.filterLabel);
+  ui.output.buttonLayout->addWidget(ui.output.filterCombobox);
   ui.output.buttonLayout->addWidget(ui.output.copyButton);
   ui.output.buttonLayout->addWidget(ui.output.clearButton);
 
@@ -352,24 +387,60 @@ void QtPack3rWidget::updateCommandPreview() {
     currentCmd.first.append(ui.paths.pack3rPathField->text());
   }
 
-  if (!ui.paths.mapPathField->text().isEmpty()) {
-    currentCmd.second.append(ui.paths.mapPathField->text());
+  currentCmd.second = buildArguments(ui.paths.mapPathField->text(),
+                                     pack3rCommands[OUTPUT].second.value);
+
+  ui.commandPreview.commandPreviewField->setPlainText(
+      currentCmd.first + " " + currentCmd.second.join(" "));
+
+  // a dry run for another map or other options is of no use anymore
+  speculativeDryRun->invalidate(currentCmd);
+
+  if (speculationArmed) {
+    speculationTimer->start();
+  }
+}
+
+// builds Pack3r arguments for the given map with the currently selected
+// options, so the same options can be applied to maps other than the one
+// in the map path field. The rename option is left out unless 'rename' is
+// set, as a single name can't be applied to more than one map.
+QStringList QtPack3rWidget::buildArguments(const QString &mapPath,
+                                           const QString &outputPath,
+                                           const bool rename) const {
+  QStringList arguments{};
+
+  if (!mapPath.isEmpty()) {
+    arguments.append(mapPath);
   }
 
+  const bool captureAll = ui.debug.captureAllCheckbox->isChecked();
+
   for (int i = 0; i < NUM_PACK3R_OPTIONS; i++) {
     const auto cmdkvp = pack3rCommands[i];
 
-    if (!cmdkvp.first) {
+    if (!cmdkvp.first || (i == RENAME && !rename)) {
+      continue;
+    }
+
+    // debug options are overridden when capturing everything
+    if (captureAll && (i == VERBOSITY || i == SHADERDEBUG || i == REFDEBUG)) {
       continue;
     }
 
-    currentCmd.second.append(cmdkvp.second.command);
+    arguments.append(cmdkvp.second.command);
 
     if (cmdkvp.second.hasValue) {
-      currentCmd.second.append(cmdkvp.second.value);
+      arguments.append(i == OUTPUT ? outputPath : cmdkvp.second.value);
     }
   }
 
-  ui.commandPreview.commandPreviewField->setPlainText(
-      currentCmd.first + " " + currentCmd.second.join(" "));
+  if (captureAll) {
+    arguments.append(pack3rCommands[VERBOSITY].second.command);
+    arguments.append("trace");
+    arguments.append(pack3rCommands[SHADERDEBUG].second.command);
+    arguments.append(pack3rCommands[REFDEBUG].second.command);
+  }
+
+  return arguments;
 }
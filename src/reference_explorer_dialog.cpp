@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "reference_explorer_dialog.h"
+
+#include <QHeaderView>
+
+ReferenceExplorerDialog::ReferenceExplorerDialog(
+    QWidget *parent, ReferenceGraph *referenceGraph)
+    : QDialog(parent), graph(referenceGraph) {
+  setWindowTitle(tr("References"));
+  setAttribute(Qt::WA_DeleteOnClose);
+  resize(800, 600);
+
+  model = new ReferenceTreeModel(this, graph);
+  shownReferences = graph->referenceCount();
+  layout = new QVBoxLayout(this);
+  statusLayout = new QHBoxLayout();
+
+  filterField = new QLineEdit(this);
+  filterField->setPlaceholderText(tr("Filter files by path"));
+  filterField->setClearButtonEnabled(true);
+
+  referenceView = new QTreeView(this);
+  referenceView->setModel(model);
+  referenceView->setUniformRowHeights(true);
+  referenceView->setAlternatingRowColors(true);
+  referenceView->header()->setStretchLastSection(false);
+  referenceView->header()->setSectionResizeMode(
+      ReferenceTreeModel::COLUMN_NAME, QHeaderView::Stretch);
+
+  statusLabel = new QLabel(this);
+  refreshButton = new QPushButton(tr("Refresh"), this);
+
+  statusLayout->addWidget(statusLabel, 1);
+  statusLayout->addWidget(refreshButton);
+
+  layout->addWidget(filterField);
+  layout->addWidget(referenceView);
+  layout->addLayout(statusLayout);
+
+  connect(filterField, &QLineEdit::textChanged, this,
+          [&](const QString &text) {
+            model->setFilter(text.trimmed());
+            updateStatus();
+          });
+  connect(refreshButton, &QPushButton::released, this, [&] { refresh(); });
+
+  connect(graph, &ReferenceGraph::referencesAdded, this,
+          [&] { updateStatus(); });
+
+  // the tree refers to nodes of the graph, so it can't outlive them
+  connect(graph, &ReferenceGraph::cleared, this, [&] { refresh(); });
+
+  updateStatus();
+}
+
+void ReferenceExplorerDialog::refresh() {
+  shownReferences = graph->referenceCount();
+  model->reload();
+  updateStatus();
+}
+
+void ReferenceExplorerDialog::updateStatus() const {
+  if (graph->nodes().isEmpty()) {
+    statusLabel->setText(
+        tr("No references yet, run Pack3r with reference or shader debug "
+           "output enabled"));
+    refreshButton->setEnabled(false);
+    return;
+  }
+
+  QString status = tr("%1 files, %2 references")
+                       .arg(model->fileCount())
+                       .arg(shownReferences);
+
+  if (!filterField->text().trimmed().isEmpty()) {
+    status += tr(", %1 matching").arg(model->matchCount());
+  }
+
+  const qsizetype newReferences = graph->referenceCount() - shownReferences;
+
+  if (newReferences > 0) {
+    status += tr(" (%1 new, refresh to show them)").arg(newReferences);
+  }
+
+  statusLabel->setText(status);
+  refreshButton->setEnabled(newReferences > 0);
+}
@@ -0,0 +1,60 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "reference_tree_model.h"
+
+#include <QDialog>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTreeView>
+#include <QVBoxLayout>
+
+// Explorer for the references of the current run, showing what pulled each
+// file into the pk3. New references arrive while Pack3r is running, and are
+// added to the tree when it's refreshed, so expanded nodes stay put.
+class ReferenceExplorerDialog : public QDialog {
+  Q_OBJECT
+
+public:
+  ReferenceExplorerDialog(QWidget *parent, ReferenceGraph *referenceGraph);
+
+private:
+  void refresh();
+  void updateStatus() const;
+
+  ReferenceGraph *graph;
+  ReferenceTreeModel *model{};
+  qsizetype shownReferences{};
+
+  QVBoxLayout *layout{};
+  QHBoxLayout *statusLayout{};
+  QLineEdit *filterField{};
+  QTreeView *referenceView{};
+  QLabel *statusLabel{};
+  QPushButton *refreshButton{};
+};
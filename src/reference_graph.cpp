@@ -0,0 +1,169 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "reference_graph.h"
+
+#include <QRegularExpression>
+
+namespace {
+// the referenced path always has at least one directory, and the source is
+// whatever follows it, excluding padding and a full stop
+const QRegularExpression referencedByPattern(
+    R"(^(?:\[\w+\]\s*)?(?:\w+\s+)??['"]?([\w\-.]+(?:/[\w\-.]+)+)['"]?)"
+    R"(\s+(?:is\s+|was\s+)?referenced\s+(?:by|in|from)\s+(.+?)[.\s]*$)",
+    QRegularExpression::CaseInsensitiveOption);
+
+const QRegularExpression referencesPattern(
+    R"(^(?:\[\w+\]\s*)?(.+?)\s+references\s+)"
+    R"(['"]?([\w\-.]+(?:/[\w\-.]+)+)['"]?)",
+    QRegularExpression::CaseInsensitiveOption);
+
+// the referrer is described by its kind, e.g. 'entity 12 (misc_model)'
+ReferenceGraph::Kind sourceKind(const QString &source) {
+  const QString word = source.section(' ', 0, 0).toLower();
+
+  if (word == "shader") {
+    return ReferenceGraph::KIND_SHADER;
+  } else if (word == "entity") {
+    return ReferenceGraph::KIND_ENTITY;
+  } else if (word == "brush" || word == "patch") {
+    return ReferenceGraph::KIND_BRUSH;
+  }
+
+  return ReferenceGraph::KIND_OTHER;
+}
+
+QString stripQuotes(QString name) {
+  name.remove('\'');
+  name.remove('"');
+  return name;
+}
+} // namespace
+
+ReferenceGraph::ReferenceGraph(QObject *parent) : QObject(parent) {}
+
+bool ReferenceGraph::parseLine(const QByteArrayView line,
+                               Reference &reference) {
+  // cheap enough to run on every line, unlike the expressions
+  if (!QLatin1String(line.data(), line.size())
+           .contains(QLatin1String("referenc"), Qt::CaseInsensitive)) {
+    return false;
+  }
+
+  const QString text = QString::fromUtf8(line);
+  QRegularExpressionMatch match = referencedByPattern.match(text);
+
+  if (match.hasMatch()) {
+    reference.target = match.captured(1);
+    reference.source = match.captured(2).trimmed();
+    return true;
+  }
+
+  match = referencesPattern.match(text);
+
+  if (match.hasMatch()) {
+    reference.source = match.captured(1).trimmed();
+    reference.target = match.captured(2);
+    return true;
+  }
+
+  return false;
+}
+
+bool ReferenceGraph::isShaderReference(const Reference &reference) {
+  return sourceKind(reference.source) == KIND_SHADER;
+}
+
+void ReferenceGraph::add(const QList<Reference> &references) {
+  qsizetype added = 0;
+
+  for (const auto &reference : references) {
+    // shaders are named like the textures they replace, without extensions
+    const qsizetype target = addNode(
+        reference.target, reference.target.section('/', -1).contains('.')
+                              ? KIND_FILE
+                              : KIND_SHADER);
+
+    const Kind kind = sourceKind(reference.source);
+    const QString shader = stripQuotes(reference.source.section(' ', 1));
+    const qsizetype source = addNode(
+        kind == KIND_SHADER && !shader.isEmpty() ? shader : reference.source,
+        kind);
+
+    if (target != source && !edges.contains({target, source})) {
+      edges.insert({target, source});
+      nodeList[target].referrers.append(source);
+      added++;
+    }
+  }
+
+  if (added > 0) {
+    emit referencesAdded();
+  }
+}
+
+void ReferenceGraph::clear() {
+  if (nodeList.isEmpty()) {
+    return;
+  }
+
+  nodeList.clear();
+  nodeIndex.clear();
+  edges.clear();
+  emit cleared();
+}
+
+const QList<ReferenceGraph::Node> &ReferenceGraph::nodes() const {
+  return nodeList;
+}
+
+qsizetype ReferenceGraph::referenceCount() const { return edges.size(); }
+
+QString ReferenceGraph::kindName(const Kind kind) {
+  switch (kind) {
+  case KIND_FILE:
+    return tr("File");
+  case KIND_SHADER:
+    return tr("Shader");
+  case KIND_ENTITY:
+    return tr("Entity");
+  case KIND_BRUSH:
+    return tr("Brush");
+  default:
+    return tr("Other");
+  }
+}
+
+qsizetype ReferenceGraph::addNode(const QString &name, const Kind kind) {
+  const QString key = name.toLower();
+  const auto it = nodeIndex.constFind(key);
+
+  if (it != nodeIndex.constEnd()) {
+    return *it;
+  }
+
+  nodeList.append({name, kind, {}});
+  nodeIndex.insert(key, nodeList.size() - 1);
+  return nodeList.size() - 1;
+}
@@ -0,0 +1,90 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QByteArrayView>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+
+// Graph of what referenced each asset, built from the reference and shader
+// debug output of Pack3r (-rd and -sd) as it arrives.
+//
+// Nodes are files, shaders, and the map elements referencing them, and each
+// reference is an edge from the referenced node to its referrer. Shaders are
+// referenced by their name, without an extension, so a file referenced by a
+// shader links to whatever referenced that shader.
+class ReferenceGraph : public QObject {
+  Q_OBJECT
+
+public:
+  enum Kind {
+    KIND_FILE,
+    KIND_SHADER,
+    KIND_ENTITY,
+    KIND_BRUSH,
+    KIND_OTHER,
+
+    NUM_KINDS // endcap
+  };
+
+  struct Reference {
+    QString target;
+    QString source;
+  };
+
+  struct Node {
+    QString name;
+    Kind kind{};
+    QList<qsizetype> referrers;
+  };
+
+  explicit ReferenceGraph(QObject *parent);
+
+  // parses lines like 'textures/a/b.tga referenced by shader textures/a/b'
+  // or 'shader textures/a/b references textures/a/b.tga', thread-safe
+  static bool parseLine(QByteArrayView line, Reference &reference);
+  // references from shaders are -sd output, anything else is -rd output
+  static bool isShaderReference(const Reference &reference);
+
+  void add(const QList<Reference> &references);
+  void clear();
+
+  const QList<Node> &nodes() const;
+  qsizetype referenceCount() const;
+
+  static QString kindName(Kind kind);
+
+signals:
+  void referencesAdded();
+  void cleared();
+
+private:
+  qsizetype addNode(const QString &name, Kind kind);
+
+  QList<Node> nodeList;
+  QHash<QString, qsizetype> nodeIndex; // by lowercase name
+  QSet<QPair<qsizetype, qsizetype>> edges;
+};
@@ -0,0 +1,269 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "reference_tree_model.h"
+
+#include <algorithm>
+
+namespace {
+constexpr qsizetype ROOT = 0;
+} // namespace
+
+ReferenceTreeModel::ReferenceTreeModel(QObject *parent,
+                                       const ReferenceGraph *referenceGraph)
+    : QAbstractItemModel(parent), graph(referenceGraph) {
+  reload();
+}
+
+void ReferenceTreeModel::reload() {
+  beginResetModel();
+
+  const auto &graphNodes = graph->nodes();
+  files.clear();
+
+  for (qsizetype i = 0; i < graphNodes.size(); i++) {
+    if (graphNodes[i].kind == ReferenceGraph::KIND_FILE) {
+      files.append(i);
+    }
+  }
+
+  std::sort(files.begin(), files.end(),
+            [&graphNodes](const qsizetype a, const qsizetype b) {
+              return QString::compare(graphNodes[a].name, graphNodes[b].name,
+                                      Qt::CaseInsensitive) < 0;
+            });
+
+  resetNodes();
+  endResetModel();
+}
+
+void ReferenceTreeModel::setFilter(const QString &filter) {
+  if (filter == currentFilter) {
+    return;
+  }
+
+  beginResetModel();
+  currentFilter = filter;
+  resetNodes();
+  endResetModel();
+}
+
+qsizetype ReferenceTreeModel::fileCount() const { return files.size(); }
+
+qsizetype ReferenceTreeModel::matchCount() const {
+  return nodes[ROOT].children.size();
+}
+
+QModelIndex ReferenceTreeModel::index(const int row, const int column,
+                                      const QModelIndex &parent) const {
+  const qsizetype parentNode = nodeIndex(parent);
+
+  if (parentNode < 0 || row < 0 || column < 0 || column >= NUM_COLUMNS ||
+      row >= nodes[parentNode].children.size()) {
+    return {};
+  }
+
+  return createIndex(row, column,
+                     static_cast<quintptr>(nodes[parentNode].children[row]));
+}
+
+QModelIndex ReferenceTreeModel::parent(const QModelIndex &child) const {
+  const qsizetype node = nodeIndex(child);
+
+  if (node <= ROOT || nodes[node].parent <= ROOT) {
+    return {};
+  }
+
+  const qsizetype parentNode = nodes[node].parent;
+  return createIndex(nodes[parentNode].row, 0,
+                     static_cast<quintptr>(parentNode));
+}
+
+int ReferenceTreeModel::rowCount(const QModelIndex &parent) const {
+  if (parent.column() > 0) {
+    return 0;
+  }
+
+  const qsizetype node = nodeIndex(parent);
+  return node < 0 ? 0 : static_cast<int>(nodes[node].children.size());
+}
+
+int ReferenceTreeModel::columnCount(const QModelIndex &) const {
+  return NUM_COLUMNS;
+}
+
+QVariant ReferenceTreeModel::data(const QModelIndex &index,
+                                  const int role) const {
+  const qsizetype nodeIdx = nodeIndex(index);
+
+  if (nodeIdx <= ROOT) {
+    return {};
+  }
+
+  const ReferenceGraph::Node &graphNode =
+      graph->nodes()[nodes[nodeIdx].graphNode];
+
+  if (role == Qt::ToolTipRole && index.column() == COLUMN_NAME) {
+    return graphNode.name;
+  }
+
+  if (role == Qt::TextAlignmentRole && index.column() == COLUMN_REFERRERS) {
+    return static_cast<int>(Qt::AlignRight | Qt::AlignVCenter);
+  }
+
+  if (role != Qt::DisplayRole) {
+    return {};
+  }
+
+  switch (index.column()) {
+  case COLUMN_NAME:
+    return graphNode.name;
+  case COLUMN_KIND:
+    return ReferenceGraph::kindName(graphNode.kind);
+  case COLUMN_REFERRERS:
+    return static_cast<qlonglong>(graphNode.referrers.size());
+  default:
+    return {};
+  }
+}
+
+QVariant ReferenceTreeModel::headerData(const int section,
+                                        const Qt::Orientation orientation,
+                                        const int role) const {
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+    return {};
+  }
+
+  switch (section) {
+  case COLUMN_NAME:
+    return tr("Name");
+  case COLUMN_KIND:
+    return tr("Kind");
+  case COLUMN_REFERRERS:
+    return tr("Referenced by");
+  default:
+    return {};
+  }
+}
+
+bool ReferenceTreeModel::hasChildren(const QModelIndex &parent) const {
+  const qsizetype node = nodeIndex(parent);
+
+  if (node < 0) {
+    return false;
+  }
+
+  if (nodes[node].fetched) {
+    return !nodes[node].children.isEmpty();
+  }
+
+  return !graph->nodes()[nodes[node].graphNode].referrers.isEmpty();
+}
+
+bool ReferenceTreeModel::canFetchMore(const QModelIndex &parent) const {
+  const qsizetype node = nodeIndex(parent);
+  return node >= 0 && !nodes[node].fetched;
+}
+
+void ReferenceTreeModel::fetchMore(const QModelIndex &parent) {
+  const qsizetype node = nodeIndex(parent);
+
+  if (node < 0 || nodes[node].fetched) {
+    return;
+  }
+
+  nodes[node].fetched = true;
+  QList<qsizetype> referrers{};
+
+  for (const auto referrer :
+       graph->nodes()[nodes[node].graphNode].referrers) {
+    if (!isAncestor(node, referrer)) {
+      referrers.append(referrer);
+    }
+  }
+
+  if (referrers.isEmpty()) {
+    return;
+  }
+
+  beginInsertRows(parent, 0, static_cast<int>(referrers.size() - 1));
+
+  for (const auto referrer : referrers) {
+    Node child{};
+    child.graphNode = referrer;
+    child.parent = node;
+    child.row = static_cast<int>(nodes[node].children.size());
+    nodes[node].children.append(nodes.size());
+    nodes.append(std::move(child));
+  }
+
+  endInsertRows();
+}
+
+void ReferenceTreeModel::resetNodes() {
+  nodes.clear();
+
+  Node root{};
+  root.fetched = true;
+  nodes.append(root);
+
+  const auto &graphNodes = graph->nodes();
+
+  for (const auto file : std::as_const(files)) {
+    if (!currentFilter.isEmpty() &&
+        !graphNodes[file].name.contains(currentFilter, Qt::CaseInsensitive)) {
+      continue;
+    }
+
+    Node node{};
+    node.graphNode = file;
+    node.parent = ROOT;
+    node.row = static_cast<int>(nodes[ROOT].children.size());
+    nodes[ROOT].children.append(nodes.size());
+    nodes.append(std::move(node));
+  }
+}
+
+bool ReferenceTreeModel::isAncestor(qsizetype node,
+                                    const qsizetype graphNode) const {
+  for (; node > ROOT; node = nodes[node].parent) {
+    if (nodes[node].graphNode == graphNode) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+qsizetype ReferenceTreeModel::nodeIndex(const QModelIndex &index) const {
+  if (nodes.isEmpty()) {
+    return -1;
+  }
+
+  if (!index.isValid()) {
+    return ROOT;
+  }
+
+  return static_cast<qsizetype>(index.internalId());
+}
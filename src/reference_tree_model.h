@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "reference_graph.h"
+
+#include <QAbstractItemModel>
+
+// Tree of every file in a ReferenceGraph, where the children of each node
+// are what referenced it, so expanding a file shows the chain which pulled
+// it into the pk3.
+//
+// Referrers are only added when a node is expanded, so the tree doesn't
+// depend on how deep or cyclic the graph is. A referrer which is already
+// an ancestor of the node isn't shown again.
+//
+// Files are listed as they were on the last reload(), while referrers are
+// taken from the graph as it is when a node is expanded.
+class ReferenceTreeModel : public QAbstractItemModel {
+  Q_OBJECT
+
+public:
+  enum Columns {
+    COLUMN_NAME,
+    COLUMN_KIND,
+    COLUMN_REFERRERS,
+
+    NUM_COLUMNS // endcap
+  };
+
+  ReferenceTreeModel(QObject *parent, const ReferenceGraph *referenceGraph);
+
+  void reload();
+
+  // matches names containing 'filter'
+  void setFilter(const QString &filter);
+
+  qsizetype fileCount() const;
+  qsizetype matchCount() const;
+
+  QModelIndex index(int row, int column,
+                    const QModelIndex &parent = {}) const override;
+  QModelIndex parent(const QModelIndex &child) const override;
+  int rowCount(const QModelIndex &parent = {}) const override;
+  int columnCount(const QModelIndex &parent = {}) const override;
+  QVariant data(const QModelIndex &index, int role) const override;
+  QVariant headerData(int section, Qt::Orientation orientation,
+                      int role) const override;
+
+  bool hasChildren(const QModelIndex &parent = {}) const override;
+  bool canFetchMore(const QModelIndex &parent) const override;
+  void fetchMore(const QModelIndex &parent) override;
+
+private:
+  struct Node {
+    qsizetype graphNode{-1};
+    qsizetype parent{-1};
+    int row{};
+    QList<qsizetype> children;
+    bool fetched{};
+  };
+
+  void resetNodes();
+  bool isAncestor(qsizetype node, qsizetype graphNode) const;
+  qsizetype nodeIndex(const QModelIndex &index) const;
+
+  const ReferenceGraph *graph;
+  QList<qsizetype> files; // graph nodes, sorted by name
+  QList<Node> nodes;
+  QString currentFilter;
+};
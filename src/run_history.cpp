@@ -0,0 +1,408 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "run_history.h"
+#include "filesystem.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+constexpr quint32 DATABASE_MAGIC = 0x51505248; // "QPRH"
+constexpr quint32 DATABASE_VERSION = 1;
+constexpr quint32 INDEX_MAGIC = 0x51505249; // "QPRI"
+constexpr quint32 INDEX_VERSION = 2;
+
+// magic and version
+constexpr qint64 DATABASE_HEADER_SIZE = 8;
+
+const QString databaseFilename = "history/runs.dat";
+const QString indexFilename = "history/runs.idx";
+
+// a run this much slower than the median is flagged
+constexpr double SLOW_RUN_FACTOR = 1.25;
+// the median of fewer runs than this isn't meaningful
+constexpr qsizetype MIN_RUNS_FOR_MEDIAN = 3;
+
+QByteArray serializeRun(const RunHistory::Run &run) {
+  QByteArray data{};
+  QDataStream stream(&data, QIODevice::WriteOnly);
+  stream.setVersion(QDataStream::Qt_6_2);
+  stream << run.id << run.startedAt << run.map << run.program << run.arguments
+         << run.pack3rVersion << run.durationMs << run.exitCode
+         << run.outputBytes << run.lineCount << run.logFile;
+  return data;
+}
+
+bool deserializeRun(const QByteArray &data, RunHistory::Run &run) {
+  QDataStream stream(data);
+  stream.setVersion(QDataStream::Qt_6_2);
+  stream >> run.id >> run.startedAt >> run.map >> run.program >>
+      run.arguments >> run.pack3rVersion >> run.durationMs >> run.exitCode >>
+      run.outputBytes >> run.lineCount >> run.logFile;
+  return stream.status() == QDataStream::Ok;
+}
+
+// reads the length prefixed record at the current position of 'file'
+bool readRecord(QFile &file, RunHistory::Run &run) {
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+
+  quint32 length{};
+  stream >> length;
+
+  if (stream.status() != QDataStream::Ok ||
+      file.bytesAvailable() < static_cast<qint64>(length)) {
+    return false;
+  }
+
+  return deserializeRun(file.read(length), run);
+}
+
+RunHistory::Summary summarize(const RunHistory::Run &run,
+                              const qint64 offset) {
+  return {run.id,
+          offset,
+          run.startedAt,
+          run.durationMs,
+          run.exitCode,
+          run.pack3rVersion,
+          run.outputBytes,
+          run.program + " " + run.arguments.join(' ')};
+}
+} // namespace
+
+RunHistory::RunHistory(QObject *parent)
+    : QObject(parent), watcher(new QFutureWatcher<QString>(this)) {
+  connect(watcher, &QFutureWatcher<QString>::finished, this, [&] {
+    const QString error = watcher->result();
+    recording = false;
+
+    if (!error.isEmpty()) {
+      emit outputLine(
+          tr("[history] Unable to record run: %1").arg(error).toUtf8());
+    }
+
+    if (!pendingRecords.isEmpty()) {
+      const auto [run, log] = pendingRecords.takeFirst();
+      startRecording(run, log);
+    }
+  });
+}
+
+// runs still waiting to be recorded aren't lost on exit
+RunHistory::~RunHistory() {
+  watcher->waitForFinished();
+
+  for (const auto &[run, log] : std::as_const(pendingRecords)) {
+    QString error{};
+    append(run, log, error);
+  }
+}
+
+// compressing a large log takes a while, so runs finishing while another
+// one is recorded wait for it instead of blocking the caller
+void RunHistory::record(const Run &run, const QByteArray &log) {
+  if (recording) {
+    pendingRecords.append({run, log});
+  } else {
+    startRecording(run, log);
+  }
+}
+
+void RunHistory::startRecording(const Run &run, const QByteArray &log) {
+  recording = true;
+  watcher->setFuture(QtConcurrent::run([this, run, log] {
+    QString error{};
+    append(run, log, error);
+    return error;
+  }));
+}
+
+QStringList RunHistory::maps() {
+  const QMutexLocker locker(&mutex);
+  ensureLoaded();
+
+  QStringList result = index.keys();
+  std::sort(result.begin(), result.end(),
+            [&](const QString &a, const QString &b) {
+              return index[a].last().startedAt > index[b].last().startedAt;
+            });
+  return result;
+}
+
+QList<RunHistory::Summary> RunHistory::runs(const QString &map) {
+  const QMutexLocker locker(&mutex);
+  ensureLoaded();
+  return index.value(map);
+}
+
+bool RunHistory::readRun(const Summary &summary, Run &run, QString &error) {
+  const QMutexLocker locker(&mutex);
+  QFile file(FileSystem::getDataFilePath(databaseFilename));
+
+  if (!file.open(QIODevice::ReadOnly) || !file.seek(summary.offset)) {
+    error = file.errorString();
+    return false;
+  }
+
+  if (!readRecord(file, run) || run.id != summary.id) {
+    error = tr("Run #%1 is corrupt").arg(summary.id);
+    return false;
+  }
+
+  return true;
+}
+
+bool RunHistory::readLog(const Run &run, QByteArray &log, QString &error) {
+  if (run.logFile.isEmpty()) {
+    error = tr("No log was recorded for run #%1").arg(run.id);
+    return false;
+  }
+
+  QFile file(FileSystem::getDataFilePath("history/" + run.logFile));
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    error = file.errorString();
+    return false;
+  }
+
+  log = qUncompress(file.readAll());
+
+  if (log.isEmpty() && run.lineCount > 0) {
+    error = tr("Log of run #%1 is corrupt").arg(run.id);
+    return false;
+  }
+
+  return true;
+}
+
+qint64 RunHistory::medianDuration(const QList<Summary> &runs) {
+  QList<qint64> durations{};
+
+  for (const auto &summary : runs) {
+    if (summary.exitCode == 0) {
+      durations.append(summary.durationMs);
+    }
+  }
+
+  if (durations.size() < MIN_RUNS_FOR_MEDIAN) {
+    return -1;
+  }
+
+  const auto middle = durations.begin() + durations.size() / 2;
+  std::nth_element(durations.begin(), middle, durations.end());
+  return *middle;
+}
+
+bool RunHistory::isSlow(const Summary &summary, const qint64 median) {
+  return median > 0 && summary.exitCode == 0 &&
+         static_cast<double>(summary.durationMs) >
+             static_cast<double>(median) * SLOW_RUN_FACTOR;
+}
+
+// the log is compressed before locking, so queries from the GUI thread
+// don't wait for it
+bool RunHistory::append(Run run, const QByteArray &log, QString &error) {
+  const QByteArray compressedLog = qCompress(log);
+
+  const QMutexLocker locker(&mutex);
+  ensureLoaded();
+
+  run.id = nextId;
+
+  if (!log.isEmpty()) {
+    run.logFile = QString("logs/%1.log.z").arg(run.id);
+    QSaveFile logFile(FileSystem::getDataFilePath("history/" + run.logFile));
+
+    if (!logFile.open(QIODevice::WriteOnly)) {
+      error = logFile.errorString();
+      return false;
+    }
+
+    logFile.write(compressedLog);
+
+    if (!logFile.commit()) {
+      error = logFile.errorString();
+      return false;
+    }
+  }
+
+  QFile file(FileSystem::getDataFilePath(databaseFilename));
+
+  if (!file.open(QIODevice::Append)) {
+    error = file.errorString();
+    return false;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+
+  if (file.size() == 0) {
+    stream << DATABASE_MAGIC << DATABASE_VERSION;
+  }
+
+  const qint64 offset = file.size();
+  const QByteArray record = serializeRun(run);
+  stream << static_cast<quint32>(record.size());
+  stream.writeRawData(record.constData(), static_cast<int>(record.size()));
+
+  if (stream.status() != QDataStream::Ok || !file.flush()) {
+    error = file.errorString();
+    return false;
+  }
+
+  index[run.map].append(summarize(run, offset));
+  indexedSize = file.size();
+  nextId++;
+  saveIndex();
+
+  return true;
+}
+
+void RunHistory::ensureLoaded() {
+  if (loaded) {
+    return;
+  }
+
+  loaded = true;
+
+  const qint64 databaseSize =
+      QFileInfo(FileSystem::getDataFilePath(databaseFilename)).size();
+
+  // the index can be behind if recording was interrupted,
+  // but if it's ahead, the database was replaced
+  if (!loadIndex() || indexedSize > databaseSize) {
+    index.clear();
+    nextId = 1;
+    scanDatabase(DATABASE_HEADER_SIZE);
+    saveIndex();
+  } else if (indexedSize < databaseSize) {
+    scanDatabase(indexedSize);
+    saveIndex();
+  }
+}
+
+bool RunHistory::loadIndex() {
+  QFile file(FileSystem::getDataFilePath(indexFilename));
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+
+  quint32 magic{};
+  quint32 version{};
+  quint32 count{};
+  stream >> magic >> version >> indexedSize >> nextId >> count;
+
+  if (magic != INDEX_MAGIC || version != INDEX_VERSION) {
+    return false;
+  }
+
+  for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+    QString map;
+    Summary summary{};
+    stream >> map >> summary.id >> summary.offset >> summary.startedAt >>
+        summary.durationMs >> summary.exitCode >> summary.pack3rVersion >>
+        summary.outputBytes >> summary.command;
+    index[map].append(summary);
+  }
+
+  return stream.status() == QDataStream::Ok;
+}
+
+void RunHistory::saveIndex() const {
+  QSaveFile file(FileSystem::getDataFilePath(indexFilename));
+
+  if (!file.open(QIODevice::WriteOnly)) {
+    return;
+  }
+
+  quint32 count = 0;
+
+  for (const auto &runs : index) {
+    count += static_cast<quint32>(runs.size());
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+  stream << INDEX_MAGIC << INDEX_VERSION << indexedSize << nextId << count;
+
+  for (auto it = index.cbegin(); it != index.cend(); ++it) {
+    for (const auto &summary : *it) {
+      stream << it.key() << summary.id << summary.offset << summary.startedAt
+             << summary.durationMs << summary.exitCode << summary.pack3rVersion
+             << summary.outputBytes << summary.command;
+    }
+  }
+
+  file.commit();
+}
+
+void RunHistory::scanDatabase(const qint64 from) {
+  QFile file(FileSystem::getDataFilePath(databaseFilename));
+
+  if (!file.open(QIODevice::ReadWrite)) {
+    indexedSize = 0;
+    return;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+
+  quint32 magic{};
+  quint32 version{};
+  stream >> magic >> version;
+
+  // not something we can append to, start over
+  if (magic != DATABASE_MAGIC || version != DATABASE_VERSION) {
+    file.resize(0);
+    indexedSize = 0;
+    return;
+  }
+
+  file.seek(from);
+  qint64 offset = from;
+  Run run{};
+
+  while (readRecord(file, run)) {
+    index[run.map].append(summarize(run, offset));
+    nextId = qMax(nextId, run.id + 1);
+    offset = file.pos();
+  }
+
+  // drop a partially written run at the end, so the next one is readable
+  if (offset < file.size()) {
+    file.resize(offset);
+  }
+
+  indexedSize = offset;
+}
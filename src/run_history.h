@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+
+// Keeps a record of every pack run, so pack times of a map can be compared
+// across changes to the map and Pack3r versions.
+//
+// Runs are appended to a run database which is never rewritten, and the log
+// of each run is stored compressed next to it. A separate index holds the
+// per-map summary of every run and its offset in the database, so trends
+// can be shown without reading the database, and the full record of a run
+// is a single seek away. The index is brought up to date from the database
+// if it's missing or behind, e.g. after a crash while recording.
+//
+// Runs are recorded on a worker thread, queries can be made from any thread.
+class RunHistory : public QObject {
+  Q_OBJECT
+
+public:
+  struct Run {
+    quint64 id{};
+    qint64 startedAt{}; // ms since epoch
+    QString map;
+    QString program;
+    QStringList arguments;
+    QString pack3rVersion;
+    qint64 durationMs{};
+    int exitCode{};
+    quint64 outputBytes{};
+    qint64 lineCount{};
+    QString logFile; // relative to the history directory, empty if no log
+  };
+
+  // everything needed to list a run, the full run is only read for its log
+  struct Summary {
+    quint64 id{};
+    qint64 offset{}; // of the run in the database
+    qint64 startedAt{};
+    qint64 durationMs{};
+    int exitCode{};
+    QString pack3rVersion;
+    quint64 outputBytes{};
+    QString command;
+  };
+
+  explicit RunHistory(QObject *parent);
+  ~RunHistory() override;
+
+  // 'log' is the full output of the run
+  void record(const Run &run, const QByteArray &log);
+
+  // maps with recorded runs, most recently packed first
+  QStringList maps();
+  // oldest run first
+  QList<Summary> runs(const QString &map);
+  bool readRun(const Summary &summary, Run &run, QString &error);
+  bool readLog(const Run &run, QByteArray &log, QString &error);
+
+  // median duration of successful runs, -1 if there are too few of them
+  static qint64 medianDuration(const QList<Summary> &runs);
+  static bool isSlow(const Summary &summary, qint64 median);
+
+signals:
+  void outputLine(const QByteArray &line);
+
+private:
+  void startRecording(const Run &run, const QByteArray &log);
+  bool append(Run run, const QByteArray &log, QString &error);
+
+  // these must be called with the mutex locked
+  void ensureLoaded();
+  bool loadIndex();
+  void saveIndex() const;
+  void scanDatabase(qint64 from);
+
+  QFutureWatcher<QString> *watcher;
+  // runs to record once the one being recorded is done, oldest first.
+  // Cleared once finished() is handled, not when the future finishes
+  bool recording{};
+  QList<QPair<Run, QByteArray>> pendingRecords;
+
+  QMutex mutex;
+  bool loaded{};
+  QHash<QString, QList<Summary>> index;
+  qint64 indexedSize{};
+  quint64 nextId{1};
+};
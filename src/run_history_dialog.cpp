@@ -0,0 +1,247 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "run_history_dialog.h"
+#include "qtpack3r_widget.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QLocale>
+#include <QPainter>
+
+namespace {
+QString formatDuration(const qint64 ms) {
+  return QString("%1.%2 s").arg(ms / 1000).arg(ms % 1000 / 100);
+}
+
+// bar per run, oldest on the left, with a line at the median
+class DurationChart : public QWidget {
+public:
+  explicit DurationChart(QWidget *parent) : QWidget(parent) {
+    setMinimumHeight(120);
+  }
+
+  void setRuns(const QList<RunHistory::Summary> &newRuns,
+               const qint64 newMedian) {
+    runs = newRuns;
+    median = newMedian;
+    update();
+  }
+
+protected:
+  void paintEvent(QPaintEvent *) override {
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+
+    qint64 longest = 0;
+
+    for (const auto &run : runs) {
+      longest = qMax(longest, run.durationMs);
+    }
+
+    if (longest == 0) {
+      return;
+    }
+
+    const double scale = static_cast<double>(height() - 4) /
+                         static_cast<double>(longest);
+    const double barWidth =
+        static_cast<double>(width()) / static_cast<double>(runs.size());
+
+    for (qsizetype i = 0; i < runs.size(); i++) {
+      QColor color = palette().highlight().color();
+
+      if (runs[i].exitCode != 0) {
+        color = palette().mid().color();
+      } else if (RunHistory::isSlow(runs[i], median)) {
+        color = Qt::red;
+      }
+
+      const double barHeight = static_cast<double>(runs[i].durationMs) * scale;
+      painter.fillRect(QRectF(barWidth * static_cast<double>(i),
+                              height() - barHeight,
+                              qMax(1.0, barWidth - 1.0), barHeight),
+                       color);
+    }
+
+    if (median > 0) {
+      const double y = height() - static_cast<double>(median) * scale;
+      painter.setPen(QPen(palette().text().color(), 1, Qt::DashLine));
+      painter.drawLine(QPointF(0, y), QPointF(width(), y));
+    }
+  }
+
+private:
+  QList<RunHistory::Summary> runs;
+  qint64 median{-1};
+};
+} // namespace
+
+RunHistoryDialog::RunHistoryDialog(QWidget *parent, RunHistory *runHistory,
+                                   const QString &currentMap)
+    : QDialog(parent), history(runHistory) {
+  setWindowTitle(tr("Run history"));
+  setAttribute(Qt::WA_DeleteOnClose);
+  resize(800, 500);
+
+  layout = new QVBoxLayout(this);
+
+  mapSelector = new QComboBox(this);
+
+  for (const auto &map : history->maps()) {
+    mapSelector->addItem(QFileInfo(map).fileName(), map);
+    mapSelector->setItemData(mapSelector->count() - 1, map, Qt::ToolTipRole);
+  }
+
+  chart = new DurationChart(this);
+
+  runTable = new QTableWidget(0, NUM_COLUMNS, this);
+  runTable->setHorizontalHeaderLabels({tr("Started"), tr("Duration"),
+                                       tr("vs. median"), tr("Exit code"),
+                                       tr("Pack3r version"), tr("Output")});
+  runTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  runTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+  runTable->setSelectionMode(QAbstractItemView::SingleSelection);
+  runTable->verticalHeader()->hide();
+  runTable->horizontalHeader()->setStretchLastSection(true);
+
+  statusLabel = new QLabel(this);
+  showLogButton = new QPushButton(tr("Show log"), this);
+
+  layout->addWidget(mapSelector);
+  layout->addWidget(chart);
+  layout->addWidget(runTable);
+  layout->addWidget(statusLabel);
+  layout->addWidget(showLogButton, 0, Qt::AlignRight);
+
+  connect(mapSelector, &QComboBox::currentIndexChanged, this,
+          [&] { updateRuns(); });
+  connect(runTable, &QTableWidget::cellDoubleClicked, this,
+          [&] { showLog(); });
+  connect(showLogButton, &QPushButton::released, this, [&] { showLog(); });
+
+  const int current = mapSelector->findData(currentMap);
+
+  if (current != -1) {
+    mapSelector->setCurrentIndex(current);
+  }
+
+  updateRuns();
+}
+
+void RunHistoryDialog::updateRuns() {
+  const QString map = mapSelector->currentData().toString();
+  const QList<RunHistory::Summary> summaries = history->runs(map);
+  const qint64 median = RunHistory::medianDuration(summaries);
+
+  static_cast<DurationChart *>(chart)->setRuns(summaries, median);
+
+  runs.clear();
+  runTable->setRowCount(0);
+
+  // newest first
+  for (auto it = summaries.crbegin(); it != summaries.crend(); ++it) {
+    const RunHistory::Summary &run = *it;
+    const int row = runTable->rowCount();
+    runTable->insertRow(row);
+    runs.append(run);
+
+    const QStringList columns = {
+        QDateTime::fromMSecsSinceEpoch(run.startedAt)
+            .toString("yyyy-MM-dd HH:mm:ss"),
+        formatDuration(run.durationMs),
+        median > 0 && run.exitCode == 0
+            ? QString("%1%2%")
+                  .arg(run.durationMs >= median ? "+" : "")
+                  .arg(100.0 * static_cast<double>(run.durationMs - median) /
+                           static_cast<double>(median),
+                       0, 'f', 0)
+            : QString("-"),
+        QString::number(run.exitCode),
+        run.pack3rVersion,
+        QLocale().formattedDataSize(static_cast<qint64>(run.outputBytes)),
+    };
+
+    for (int column = 0; column < NUM_COLUMNS; column++) {
+      auto *item = new QTableWidgetItem(columns[column]);
+      item->setToolTip(run.command);
+
+      if (RunHistory::isSlow(run, median)) {
+        item->setForeground(Qt::red);
+        item->setToolTip(tr("Significantly slower than the median of %1")
+                             .arg(formatDuration(median)));
+      }
+
+      runTable->setItem(row, column, item);
+    }
+  }
+
+  runTable->resizeColumnsToContents();
+  runTable->selectRow(0);
+  showLogButton->setEnabled(!runs.isEmpty());
+
+  if (summaries.isEmpty()) {
+    statusLabel->setText(tr("No runs recorded yet"));
+  } else if (median < 0) {
+    statusLabel->setText(tr("%n run(s)", "", static_cast<int>(runs.size())));
+  } else {
+    statusLabel->setText(tr("%n run(s), median of successful runs %1", "",
+                            static_cast<int>(runs.size()))
+                             .arg(formatDuration(median)));
+  }
+}
+
+void RunHistoryDialog::showLog() {
+  const int row = runTable->currentRow();
+
+  if (row < 0 || row >= runs.size()) {
+    return;
+  }
+
+  RunHistory::Run run{};
+  QByteArray log{};
+  QString error{};
+
+  if (!history->readRun(runs[row], run, error) ||
+      !history->readLog(run, log, error)) {
+    statusLabel->setText(error);
+    return;
+  }
+
+  auto *dialog = new QDialog(this);
+  dialog->setWindowTitle(tr("Run #%1").arg(runs[row].id));
+  dialog->setAttribute(Qt::WA_DeleteOnClose);
+  dialog->resize(900, 600);
+
+  auto *logField = new QPlainTextEdit(dialog);
+  logField->setReadOnly(true);
+  logField->setFont(MONOSPACE_FONT);
+  logField->setWordWrapMode(QTextOption::NoWrap);
+  logField->setPlainText(QString::fromUtf8(log));
+
+  auto *dialogLayout = new QVBoxLayout(dialog);
+  dialogLayout->addWidget(logField);
+  dialog->open();
+}
@@ -0,0 +1,69 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "run_history.h"
+
+#include <QComboBox>
+#include <QDialog>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+// Shows recorded runs of a map with a chart of their durations,
+// flagging runs which were significantly slower than the median.
+class RunHistoryDialog : public QDialog {
+  Q_OBJECT
+
+public:
+  RunHistoryDialog(QWidget *parent, RunHistory *runHistory,
+                   const QString &currentMap);
+
+private:
+  enum Columns {
+    COLUMN_STARTED,
+    COLUMN_DURATION,
+    COLUMN_MEDIAN,
+    COLUMN_EXIT_CODE,
+    COLUMN_VERSION,
+    COLUMN_OUTPUT,
+
+    NUM_COLUMNS // endcap
+  };
+
+  void updateRuns();
+  void showLog();
+
+  RunHistory *history;
+  QList<RunHistory::Summary> runs;
+
+  QVBoxLayout *layout{};
+  QComboBox *mapSelector{};
+  QWidget *chart{};
+  QTableWidget *runTable{};
+  QLabel *statusLabel{};
+  QPushButton *showLogButton{};
+};
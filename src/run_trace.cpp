@@ -0,0 +1,240 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "run_trace.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThread>
+#include <atomic>
+
+namespace {
+// QtPack3r and Pack3r are shown as separate processes in the timeline
+constexpr int QTPACK3R_PID = 1;
+constexpr int PACK3R_PID = 2;
+constexpr int PACK3R_PHASES_TID = 1;
+
+struct Event {
+  char phase{}; // 'X' complete, 'i' instant, 'C' counter
+  QString name;
+  int pid{};
+  int tid{};
+  qint64 timestamp{};
+  qint64 duration{};
+  QJsonObject args;
+};
+
+std::atomic<bool> active{false};
+// started once and never restarted, so it can be read from any thread
+// without locking. begin() publishes the trace start through startNsecs
+const QElapsedTimer clock = [] {
+  QElapsedTimer timer{};
+  timer.start();
+  return timer;
+}();
+std::atomic<qint64> startNsecs{0};
+QMutex mutex{};
+QList<Event> events{};
+QHash<QThread *, int> threadIds{};
+QStringList threadNames{};
+
+// must be called with the mutex locked
+int currentThreadId() {
+  QThread *thread = QThread::currentThread();
+  const auto it = threadIds.constFind(thread);
+
+  if (it != threadIds.cend()) {
+    return *it;
+  }
+
+  QString name = thread->objectName();
+
+  if (name.isEmpty()) {
+    name = thread == QCoreApplication::instance()->thread()
+               ? QStringLiteral("GUI")
+               : QStringLiteral("Thread %1").arg(threadNames.size() + 1);
+  }
+
+  threadNames.append(name);
+  threadIds.insert(thread, static_cast<int>(threadNames.size()));
+  return static_cast<int>(threadNames.size());
+}
+
+void record(Event event, const bool onCurrentThread) {
+  if (!active.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  const QMutexLocker locker(&mutex);
+
+  if (onCurrentThread) {
+    event.pid = QTPACK3R_PID;
+    event.tid = currentThreadId();
+  }
+
+  events.append(std::move(event));
+}
+
+QJsonObject metadata(const char *type, const int pid, const int tid,
+                     const QString &name) {
+  return {{"ph", "M"},
+          {"name", type},
+          {"pid", pid},
+          {"tid", tid},
+          {"args", QJsonObject{{"name", name}}}};
+}
+} // namespace
+
+RunTrace::Scope::Scope(const char *name)
+    : name(name), start(isActive() ? now() : -1) {}
+
+RunTrace::Scope::~Scope() {
+  if (start >= 0) {
+    complete(name, start, now());
+  }
+}
+
+void RunTrace::begin() {
+  const QMutexLocker locker(&mutex);
+  events.clear();
+  threadIds.clear();
+  threadNames.clear();
+  startNsecs = clock.nsecsElapsed();
+  active = true;
+}
+
+bool RunTrace::isActive() { return active.load(std::memory_order_relaxed); }
+
+bool RunTrace::finish(const QString &path, QString &error) {
+  const QMutexLocker locker(&mutex);
+  active = false;
+
+  QJsonArray traceEvents{};
+  traceEvents.append(metadata("process_name", QTPACK3R_PID, 0, PROJECT_NAME));
+  traceEvents.append(metadata("process_name", PACK3R_PID, 0, "Pack3r"));
+  traceEvents.append(
+      metadata("thread_name", PACK3R_PID, PACK3R_PHASES_TID, "Phases"));
+
+  for (qsizetype i = 0; i < threadNames.size(); i++) {
+    traceEvents.append(metadata("thread_name", QTPACK3R_PID,
+                                static_cast<int>(i + 1), threadNames[i]));
+  }
+
+  for (const auto &event : events) {
+    QJsonObject object{{"ph", QString(QChar(event.phase))},
+                       {"name", event.name},
+                       {"pid", event.pid},
+                       {"tid", event.tid},
+                       {"ts", event.timestamp}};
+
+    if (event.phase == 'X') {
+      object.insert("dur", event.duration);
+    } else if (event.phase == 'i') {
+      object.insert("s", "t");
+    }
+
+    if (!event.args.isEmpty()) {
+      object.insert("args", event.args);
+    }
+
+    traceEvents.append(object);
+  }
+
+  events.clear();
+
+  QSaveFile file(path);
+
+  if (!file.open(QIODevice::WriteOnly)) {
+    error = file.errorString();
+    return false;
+  }
+
+  file.write(QJsonDocument(QJsonObject{{"traceEvents", traceEvents},
+                                       {"displayTimeUnit", "ms"}})
+                 .toJson(QJsonDocument::Compact));
+
+  if (!file.commit()) {
+    error = file.errorString();
+    return false;
+  }
+
+  return true;
+}
+
+qint64 RunTrace::now() {
+  return (clock.nsecsElapsed() - startNsecs.load()) / 1000;
+}
+
+void RunTrace::instant(const QString &name) {
+  if (!isActive()) {
+    return;
+  }
+
+  Event event{};
+  event.phase = 'i';
+  event.name = name;
+  event.timestamp = now();
+  record(std::move(event), true);
+}
+
+void RunTrace::complete(const QString &name, const qint64 start,
+                        const qint64 end, const Track track,
+                        const QJsonObject &args) {
+  if (!isActive()) {
+    return;
+  }
+
+  Event event{};
+  event.phase = 'X';
+  event.name = name;
+  event.timestamp = start;
+  event.duration = end - start;
+  event.args = args;
+
+  if (track == TRACK_PACK3R_PHASES) {
+    event.pid = PACK3R_PID;
+    event.tid = PACK3R_PHASES_TID;
+  }
+
+  record(std::move(event), track == TRACK_CURRENT_THREAD);
+}
+
+void RunTrace::counter(const QString &name, const double value) {
+  if (!isActive()) {
+    return;
+  }
+
+  Event event{};
+  event.phase = 'C';
+  event.name = name;
+  event.pid = PACK3R_PID;
+  event.timestamp = now();
+  event.args = {{"value", value}};
+  record(std::move(event), false);
+}
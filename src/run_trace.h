@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QJsonObject>
+
+/* Collects a timeline of a pack run in the Chrome trace event format, which
+ * can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ *
+ * QtPack3r's own work is recorded per thread, while Pack3r phases inferred
+ * from its output and CPU usage samples of the Pack3r process are shown as
+ * a separate process in the timeline.
+ *
+ * Recording functions can be called from any thread, and do nothing unless
+ * a trace has been started, so instrumentation can be left in place.
+ */
+class RunTrace {
+public:
+  enum Track {
+    TRACK_CURRENT_THREAD,
+    TRACK_PACK3R_PHASES,
+  };
+
+  // records a slice from construction to destruction on the current thread
+  class Scope {
+  public:
+    explicit Scope(const char *name);
+    ~Scope();
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    const char *name;
+    qint64 start;
+  };
+
+  static void begin();
+  static bool isActive();
+  static bool finish(const QString &path, QString &error);
+
+  // microseconds since begin()
+  static qint64 now();
+
+  static void instant(const QString &name);
+  static void complete(const QString &name, qint64 start, qint64 end,
+                       Track track = TRACK_CURRENT_THREAD,
+                       const QJsonObject &args = {});
+  static void counter(const QString &name, double value);
+};
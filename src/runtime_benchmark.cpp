@@ -0,0 +1,287 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "runtime_benchmark.h"
+#include "process_priority.h"
+#include "system_memory.h"
+
+#include <QFileInfo>
+#include <algorithm>
+
+namespace {
+// VmHWM is the peak resident set size, so sampling doesn't miss short
+// spikes, only growth during the last interval before the process exits
+constexpr int MEMORY_SAMPLE_INTERVAL_MS = 100;
+
+qint64 median(QList<qint64> values) {
+  std::sort(values.begin(), values.end());
+  return values.isEmpty() ? 0 : values[values.size() / 2];
+}
+} // namespace
+
+RuntimeBenchmark::RuntimeBenchmark(QObject *parent)
+    : QObject(parent), memoryTimer(new QTimer(this)) {
+  memoryTimer->setInterval(MEMORY_SAMPLE_INTERVAL_MS);
+  connect(memoryTimer, &QTimer::timeout, this,
+          &RuntimeBenchmark::samplePeakMemory);
+}
+
+bool RuntimeBenchmark::run(const QPair<QString, QStringList> &command,
+                           const int rounds) {
+  if (isRunning()) {
+    return false;
+  }
+
+  outputDir = std::make_unique<QTemporaryDir>();
+
+  if (!outputDir->isValid()) {
+    emit outputLine(tr("[benchmark] Unable to create a temporary directory: "
+                       "%1")
+                        .arg(outputDir->errorString())
+                        .toUtf8());
+    outputDir.reset();
+    return false;
+  }
+
+  // -f as nobody's there to answer the overwrite prompt between runs
+  QStringList arguments{};
+  QString outputName = "benchmark.pk3";
+
+  for (qsizetype i = 0; i < command.second.size(); i++) {
+    if (command.second[i] == "-o") {
+      if (i + 1 < command.second.size()) {
+        outputName = QFileInfo(command.second[i + 1]).fileName();
+      }
+
+      i++;
+    } else if (command.second[i] != "-f" && command.second[i] != "-d") {
+      arguments.append(command.second[i]);
+    }
+  }
+
+  if (!outputName.endsWith(".pk3", Qt::CaseInsensitive) &&
+      !outputName.endsWith(".zip", Qt::CaseInsensitive)) {
+    outputName = "benchmark.pk3";
+  }
+
+  arguments << "-o" << outputDir->filePath(outputName) << "-f";
+  benchmarkCommand = {command.first, arguments};
+
+  presets = {RuntimeProfile::PRESET_DEFAULT, RuntimeProfile::PRESET_QUICK_START,
+             RuntimeProfile::PRESET_FULL_JIT,
+             RuntimeProfile::PRESET_THROUGHPUT};
+
+  // only worth a run if it differs from the default
+  if (!RuntimeProfile::variables(
+           RuntimeProfile::preset(RuntimeProfile::PRESET_CUSTOM))
+           .isEmpty()) {
+    presets.append(RuntimeProfile::PRESET_CUSTOM);
+  }
+
+  samples = QList<QList<Sample>>(presets.size());
+  totalRuns = 1 + static_cast<int>(presets.size()) * qMax(1, rounds);
+  runIndex = 0;
+
+  emit outputLine(tr("[benchmark] %1 runs of %2 profiles, plus a warm-up run")
+                      .arg(totalRuns - 1)
+                      .arg(presets.size())
+                      .toUtf8());
+
+  startNextRun();
+  return true;
+}
+
+void RuntimeBenchmark::cancel() {
+  if (!process) {
+    return;
+  }
+
+  memoryTimer->stop();
+  process->disconnect(this);
+  process->kill();
+  process->deleteLater();
+  process = nullptr;
+  outputDir.reset();
+
+  emit outputLine(tr("[benchmark] Canceled").toUtf8());
+  emit finished();
+}
+
+bool RuntimeBenchmark::isRunning() const { return process != nullptr; }
+
+void RuntimeBenchmark::startNextRun() {
+  const bool warmUp = runIndex == 0;
+  runPreset = warmUp ? RuntimeProfile::PRESET_DEFAULT
+                     : presets[(runIndex - 1) % presets.size()];
+  runPeakMemoryKb = -1;
+
+  process = new QProcess(this);
+  process->setProgram(benchmarkCommand.first);
+  process->setArguments(benchmarkCommand.second);
+  process->setProcessChannelMode(QProcess::MergedChannels);
+
+  // output isn't shown, but the pipe must be drained for Pack3r to go on
+  process->setStandardOutputFile(QProcess::nullDevice());
+
+  ProcessPriority::apply(process, ProcessPriority::foreground());
+  RuntimeProfile::apply(process, RuntimeProfile::preset(runPreset));
+
+  connect(process, &QProcess::started, this, [&] {
+    wallTimer.start();
+    memoryTimer->start();
+  });
+  connect(process, &QProcess::finished, this,
+          [&](const int exitCode, const QProcess::ExitStatus status) {
+            finishRun(status == QProcess::NormalExit ? exitCode : -1);
+          });
+  connect(process, &QProcess::errorOccurred, this,
+          [&](const QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart) {
+              emit outputLine(tr("[benchmark] Failed to start Pack3r: %1")
+                                  .arg(process->errorString())
+                                  .toUtf8());
+              cancel();
+            }
+          });
+
+  emit outputLine(tr("[benchmark] Run %1/%2: %3")
+                      .arg(runIndex + 1)
+                      .arg(totalRuns)
+                      .arg(warmUp ? tr("warm-up")
+                                  : RuntimeProfile::presetName(runPreset))
+                      .toUtf8());
+
+  process->start();
+  process->closeWriteChannel();
+}
+
+void RuntimeBenchmark::finishRun(const int exitCode) {
+  memoryTimer->stop();
+
+  Sample sample{};
+  sample.wallMs = wallTimer.elapsed();
+  sample.peakMemoryKb = runPeakMemoryKb;
+  sample.exitCode = exitCode;
+
+  process->deleteLater();
+  process = nullptr;
+
+  if (exitCode != 0) {
+    emit outputLine(
+        tr("[benchmark] Pack3r exited with code %1, stopping the benchmark")
+            .arg(exitCode)
+            .toUtf8());
+    outputDir.reset();
+    emit finished();
+    return;
+  }
+
+  if (runIndex > 0) {
+    samples[presets.indexOf(runPreset)].append(sample);
+  }
+
+  runIndex++;
+
+  if (runIndex < totalRuns) {
+    startNextRun();
+    return;
+  }
+
+  outputDir.reset();
+  report();
+  emit finished();
+}
+
+void RuntimeBenchmark::samplePeakMemory() {
+  if (process && process->state() == QProcess::Running) {
+    runPeakMemoryKb = qMax(runPeakMemoryKb,
+                           SystemMemory::process(process->processId()).peakKb);
+  }
+}
+
+void RuntimeBenchmark::report() {
+  struct Result {
+    RuntimeProfile::Preset preset;
+    qint64 medianMs;
+    qint64 minMs;
+    qint64 peakMemoryKb;
+  };
+
+  QList<Result> results{};
+
+  for (qsizetype i = 0; i < presets.size(); i++) {
+    QList<qint64> times{};
+    qint64 peak = -1;
+
+    for (const auto &sample : samples[i]) {
+      times.append(sample.wallMs);
+      peak = qMax(peak, sample.peakMemoryKb);
+    }
+
+    results.append({presets[i], median(times),
+                    *std::min_element(times.cbegin(), times.cend()), peak});
+  }
+
+  emit outputLine(tr("[benchmark] %1 %2 %3 %4")
+                      .arg(tr("Profile"), -12)
+                      .arg(tr("Median"), 10)
+                      .arg(tr("Fastest"), 10)
+                      .arg(tr("Peak memory"), 12)
+                      .toUtf8());
+
+  for (const auto &result : results) {
+    const QString memory =
+        result.peakMemoryKb < 0
+            ? tr("n/a")
+            : QString("%1 MB").arg(result.peakMemoryKb / 1024);
+
+    emit outputLine(
+        QString("[benchmark] %1 %2 %3 %4")
+            .arg(RuntimeProfile::presetName(result.preset), -12)
+            .arg(QString("%1 s").arg(result.medianMs / 1000.0, 0, 'f', 2), 10)
+            .arg(QString("%1 s").arg(result.minMs / 1000.0, 0, 'f', 2), 10)
+            .arg(memory, 12)
+            .toUtf8());
+  }
+
+  const auto fastest = std::min_element(
+      results.cbegin(), results.cend(), [](const Result &a, const Result &b) {
+        return a.medianMs < b.medianMs;
+      });
+  const qint64 defaultMs = results.first().medianMs;
+
+  if (fastest->preset == RuntimeProfile::PRESET_DEFAULT || defaultMs == 0) {
+    emit outputLine(
+        tr("[benchmark] The default profile was the fastest").toUtf8());
+    return;
+  }
+
+  emit outputLine(
+      tr("[benchmark] Fastest profile: %1, %2% faster than the default")
+          .arg(RuntimeProfile::presetName(fastest->preset))
+          .arg(100.0 * static_cast<double>(defaultMs - fastest->medianMs) /
+                   static_cast<double>(defaultMs),
+               0, 'f', 1)
+          .toUtf8());
+}
@@ -0,0 +1,82 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "runtime_profile.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <memory>
+
+// Runs the same Pack3r job under each runtime profile, and reports the wall
+// time and peak memory of each, to find the fastest profile for the machine.
+//
+// The first run only warms up disk caches and isn't counted. After that,
+// runs alternate between profiles, so caches and thermal throttling affect
+// every profile alike. Output is written to a temporary directory, so the
+// real output is left alone.
+class RuntimeBenchmark : public QObject {
+  Q_OBJECT
+
+public:
+  explicit RuntimeBenchmark(QObject *parent);
+
+  bool run(const QPair<QString, QStringList> &command, int rounds);
+  void cancel();
+  bool isRunning() const;
+
+signals:
+  void outputLine(const QByteArray &line);
+  void finished();
+
+private:
+  struct Sample {
+    qint64 wallMs{};
+    qint64 peakMemoryKb{-1}; // -1 if unknown
+    int exitCode{};
+  };
+
+  void startNextRun();
+  void finishRun(int exitCode);
+  void samplePeakMemory();
+  void report();
+
+  QList<RuntimeProfile::Preset> presets;
+  QList<QList<Sample>> samples; // per preset
+  QPair<QString, QStringList> benchmarkCommand;
+  std::unique_ptr<QTemporaryDir> outputDir;
+
+  int totalRuns{};
+  int runIndex{};
+  RuntimeProfile::Preset runPreset{};
+
+  QProcess *process{};
+  QElapsedTimer wallTimer;
+  QTimer *memoryTimer;
+  qint64 runPeakMemoryKb{-1};
+};
@@ -0,0 +1,195 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "runtime_profile.h"
+#include "preferences.h"
+
+namespace {
+RuntimeProfile::Toggle readToggle(const Preferences::Settings setting) {
+  return static_cast<RuntimeProfile::Toggle>(
+      qBound(0, preferences.readSetting(setting).toInt(),
+             RuntimeProfile::NUM_TOGGLES - 1));
+}
+
+RuntimeProfile::Toggle toggleFromJson(const QJsonValue &value) {
+  return static_cast<RuntimeProfile::Toggle>(
+      qBound(0, value.toInt(), RuntimeProfile::NUM_TOGGLES - 1));
+}
+
+void appendToggle(QList<QPair<QString, QString>> &variables,
+                  const QString &name, const RuntimeProfile::Toggle toggle) {
+  if (toggle != RuntimeProfile::TOGGLE_DEFAULT) {
+    variables.append({name, toggle == RuntimeProfile::TOGGLE_ON ? "1" : "0"});
+  }
+}
+} // namespace
+
+RuntimeProfile::Profile RuntimeProfile::preset(const Preset preset) {
+  Profile profile{};
+
+  switch (preset) {
+  case PRESET_QUICK_START:
+    profile.tieredCompilation = TOGGLE_ON;
+    profile.quickJitForLoops = TOGGLE_ON;
+    profile.tieredPgo = TOGGLE_OFF;
+    profile.readyToRun = TOGGLE_ON;
+    profile.gcMode = GC_WORKSTATION;
+    profile.concurrentGc = TOGGLE_OFF;
+    break;
+  case PRESET_FULL_JIT:
+    profile.tieredCompilation = TOGGLE_OFF;
+    profile.readyToRun = TOGGLE_OFF;
+    profile.gcMode = GC_WORKSTATION;
+    profile.concurrentGc = TOGGLE_OFF;
+    break;
+  case PRESET_THROUGHPUT:
+    profile.tieredCompilation = TOGGLE_ON;
+    profile.tieredPgo = TOGGLE_ON;
+    profile.readyToRun = TOGGLE_ON;
+    profile.gcMode = GC_SERVER;
+    profile.concurrentGc = TOGGLE_OFF;
+    break;
+  case PRESET_CUSTOM:
+    profile.tieredCompilation =
+        readToggle(Preferences::Settings::RUNTIME_TIERED_COMPILATION);
+    profile.quickJitForLoops =
+        readToggle(Preferences::Settings::RUNTIME_QUICK_JIT_FOR_LOOPS);
+    profile.tieredPgo = readToggle(Preferences::Settings::RUNTIME_TIERED_PGO);
+    profile.readyToRun =
+        readToggle(Preferences::Settings::RUNTIME_READY_TO_RUN);
+    profile.gcMode = static_cast<GcMode>(qBound(
+        0,
+        preferences.readSetting(Preferences::Settings::RUNTIME_GC_MODE)
+            .toInt(),
+        NUM_GC_MODES - 1));
+    profile.concurrentGc =
+        readToggle(Preferences::Settings::RUNTIME_CONCURRENT_GC);
+    profile.heapHardLimitMb = qMax(
+        0,
+        preferences.readSetting(Preferences::Settings::RUNTIME_HEAP_HARD_LIMIT)
+            .toInt());
+    break;
+  default:
+    break;
+  }
+
+  return profile;
+}
+
+RuntimeProfile::Profile RuntimeProfile::selected() {
+  return preset(static_cast<Preset>(
+      qBound(0,
+             preferences.readSetting(Preferences::Settings::RUNTIME_PROFILE)
+                 .toInt(),
+             NUM_PRESETS - 1)));
+}
+
+QString RuntimeProfile::presetName(const Preset preset) {
+  switch (preset) {
+  case PRESET_DEFAULT:
+    return QObject::tr("Default");
+  case PRESET_QUICK_START:
+    return QObject::tr("Quick start");
+  case PRESET_FULL_JIT:
+    return QObject::tr("Full JIT");
+  case PRESET_THROUGHPUT:
+    return QObject::tr("Throughput");
+  case PRESET_CUSTOM:
+    return QObject::tr("Custom");
+  default:
+    return {};
+  }
+}
+
+QList<QPair<QString, QString>>
+RuntimeProfile::variables(const Profile &profile) {
+  QList<QPair<QString, QString>> variables{};
+
+  appendToggle(variables, "DOTNET_TieredCompilation",
+               profile.tieredCompilation);
+  appendToggle(variables, "DOTNET_TC_QuickJitForLoops",
+               profile.quickJitForLoops);
+  appendToggle(variables, "DOTNET_TieredPGO", profile.tieredPgo);
+  appendToggle(variables, "DOTNET_ReadyToRun", profile.readyToRun);
+
+  if (profile.gcMode != GC_DEFAULT) {
+    variables.append(
+        {"DOTNET_gcServer", profile.gcMode == GC_SERVER ? "1" : "0"});
+  }
+
+  appendToggle(variables, "DOTNET_gcConcurrent", profile.concurrentGc);
+
+  // GC settings are read as hexadecimal
+  if (profile.heapHardLimitMb > 0) {
+    const quint64 bytes =
+        static_cast<quint64>(profile.heapHardLimitMb) * 1024 * 1024;
+    variables.append(
+        {"DOTNET_GCHeapHardLimit", "0x" + QString::number(bytes, 16)});
+  }
+
+  return variables;
+}
+
+void RuntimeProfile::apply(QProcess *process, const Profile &profile) {
+  const auto profileVariables = variables(profile);
+
+  if (profileVariables.isEmpty()) {
+    return;
+  }
+
+  QProcessEnvironment environment = process->processEnvironment();
+
+  if (environment.isEmpty()) {
+    environment = QProcessEnvironment::systemEnvironment();
+  }
+
+  for (const auto &[name, value] : profileVariables) {
+    environment.insert(name, value);
+  }
+
+  process->setProcessEnvironment(environment);
+}
+
+QJsonObject RuntimeProfile::toJson(const Profile &profile) {
+  return {{"tieredCompilation", profile.tieredCompilation},
+          {"quickJitForLoops", profile.quickJitForLoops},
+          {"tieredPgo", profile.tieredPgo},
+          {"readyToRun", profile.readyToRun},
+          {"gcMode", profile.gcMode},
+          {"concurrentGc", profile.concurrentGc},
+          {"heapHardLimitMb", profile.heapHardLimitMb}};
+}
+
+RuntimeProfile::Profile RuntimeProfile::fromJson(const QJsonObject &json) {
+  Profile profile{};
+  profile.tieredCompilation = toggleFromJson(json["tieredCompilation"]);
+  profile.quickJitForLoops = toggleFromJson(json["quickJitForLoops"]);
+  profile.tieredPgo = toggleFromJson(json["tieredPgo"]);
+  profile.readyToRun = toggleFromJson(json["readyToRun"]);
+  profile.gcMode = static_cast<GcMode>(
+      qBound(0, json["gcMode"].toInt(), NUM_GC_MODES - 1));
+  profile.concurrentGc = toggleFromJson(json["concurrentGc"]);
+  profile.heapHardLimitMb = qMax(0, json["heapHardLimitMb"].toInt());
+  return profile;
+}
@@ -0,0 +1,84 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QJsonObject>
+#include <QProcess>
+
+// .NET runtime settings for spawned Pack3r processes, passed to the runtime
+// through DOTNET_ environment variables of the child. Settings left at their
+// default aren't set, so the child gets whatever was inherited for them.
+class RuntimeProfile {
+public:
+  enum Preset {
+    PRESET_DEFAULT,
+    PRESET_QUICK_START, // least time spent in the JIT, for small maps
+    PRESET_FULL_JIT,    // everything fully optimized on first call
+    PRESET_THROUGHPUT,  // tiered PGO and server GC, for large maps
+    PRESET_CUSTOM,      // settings from preferences
+
+    NUM_PRESETS // endcap
+  };
+
+  enum Toggle {
+    TOGGLE_DEFAULT,
+    TOGGLE_ON,
+    TOGGLE_OFF,
+
+    NUM_TOGGLES // endcap
+  };
+
+  enum GcMode {
+    GC_DEFAULT,
+    GC_WORKSTATION,
+    GC_SERVER,
+
+    NUM_GC_MODES // endcap
+  };
+
+  struct Profile {
+    Toggle tieredCompilation{};
+    Toggle quickJitForLoops{};
+    Toggle tieredPgo{};
+    Toggle readyToRun{};
+    GcMode gcMode{};
+    Toggle concurrentGc{};
+    int heapHardLimitMb{}; // 0 for no limit
+  };
+
+  static Profile preset(Preset preset);
+  static Profile selected();
+  static QString presetName(Preset preset);
+
+  // name and value of every variable set by the profile
+  static QList<QPair<QString, QString>> variables(const Profile &profile);
+
+  // must be called before the process is started
+  static void apply(QProcess *process, const Profile &profile);
+
+  // used to pass the profile of a job to the pack daemon
+  static QJsonObject toJson(const Profile &profile);
+  static Profile fromJson(const QJsonObject &json);
+};
@@ -0,0 +1,648 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "shader_index.h"
+#include "filesystem.h"
+#include "pk3_archive.h"
+#include "preferences.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QSaveFile>
+#include <QSet>
+#include <QtConcurrent>
+#include <algorithm>
+#include <memory>
+
+namespace {
+constexpr quint32 SHADER_INDEX_MAGIC = 0x51505349; // "QPSI"
+constexpr quint32 SHADER_INDEX_VERSION = 3;
+const QString shaderIndexFilename = "shader_index.dat";
+
+// longer lists in the map report are cut short
+constexpr qsizetype MAX_LISTED = 50;
+
+// keywords followed by a single image on the same line
+const QList<QByteArrayView> imageKeywords = {
+    "map",         "clampmap",     "videomap",      "qer_editorimage",
+    "implicitmap", "implicitmask", "implicitblend",
+};
+
+struct Token {
+  QByteArrayView text;
+  qint32 line{};
+};
+
+// splits a shader script into tokens the same way the game does,
+// braces are always tokens of their own
+class Tokenizer {
+public:
+  explicit Tokenizer(const QByteArrayView text) : text(text) {}
+
+  bool next(Token &token) {
+    skipWhitespace();
+
+    if (pos >= text.size()) {
+      return false;
+    }
+
+    token.line = line;
+    const qsizetype start = pos;
+
+    if (text[pos] == '{' || text[pos] == '}') {
+      pos++;
+      token.text = text.sliced(start, 1);
+      return true;
+    }
+
+    if (text[pos] == '"') {
+      pos++;
+
+      while (pos < text.size() && text[pos] != '"' && text[pos] != '\n') {
+        pos++;
+      }
+
+      token.text = text.sliced(start + 1, pos - start - 1);
+
+      if (pos < text.size() && text[pos] == '"') {
+        pos++;
+      }
+
+      return true;
+    }
+
+    while (pos < text.size() && !isSpace(text[pos]) && text[pos] != '{' &&
+           text[pos] != '}') {
+      pos++;
+    }
+
+    token.text = text.sliced(start, pos - start);
+    return true;
+  }
+
+private:
+  static bool isSpace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+  }
+
+  // skips whitespace and comments, counting lines
+  void skipWhitespace() {
+    while (pos < text.size()) {
+      const char c = text[pos];
+      const char next = pos + 1 < text.size() ? text[pos + 1] : '\0';
+
+      if (c == '\n') {
+        line++;
+        pos++;
+      } else if (isSpace(c)) {
+        pos++;
+      } else if (c == '/' && next == '/') {
+        while (pos < text.size() && text[pos] != '\n') {
+          pos++;
+        }
+      } else if (c == '/' && next == '*') {
+        pos += 2;
+
+        while (pos + 1 < text.size() &&
+               !(text[pos] == '*' && text[pos + 1] == '/')) {
+          if (text[pos] == '\n') {
+            line++;
+          }
+
+          pos++;
+        }
+
+        pos = qMin(text.size(), pos + 2);
+      } else {
+        break;
+      }
+    }
+  }
+
+  QByteArrayView text;
+  qsizetype pos{};
+  qint32 line{1};
+};
+
+bool isImageKeyword(const QByteArrayView token) {
+  return std::any_of(imageKeywords.cbegin(), imageKeywords.cend(),
+                     [token](const QByteArrayView keyword) {
+                       return token.compare(keyword, Qt::CaseInsensitive) == 0;
+                     });
+}
+
+void addImage(ShaderIndex::Shader &shader, const QByteArrayView token) {
+  // $lightmap, $whiteimage and the like are generated by the engine,
+  // and '-' means an image with the name of the shader
+  if (token.isEmpty() || token.startsWith('$') || token.startsWith('*') ||
+      token == "-") {
+    return;
+  }
+
+  const QString image = QString::fromLatin1(token).replace('\\', '/');
+
+  if (!shader.images.contains(image, Qt::CaseInsensitive)) {
+    shader.images.append(image);
+  }
+}
+
+QString normalizeShaderName(const QByteArrayView name) {
+  QString shader = QString::fromLatin1(name).replace('\\', '/');
+  return shader.startsWith("textures/", Qt::CaseInsensitive)
+             ? shader
+             : "textures/" + shader;
+}
+} // namespace
+
+ShaderIndex::ShaderIndex(QObject *parent)
+    : QObject(parent), scanWatcher(new QFutureWatcher<ScanResult>(this)) {
+  connect(scanWatcher, &QFutureWatcher<ScanResult>::finished, this, [this] {
+    const ScanResult result = scanWatcher->result();
+    setSnapshot(result.snapshot);
+    save();
+
+    if (!scanningMap.isEmpty()) {
+      reportMap(result);
+      scanningMap.clear();
+    }
+
+    if (refreshPending || !pendingMap.isEmpty()) {
+      refreshPending = false;
+      refresh();
+    }
+  });
+}
+
+void ShaderIndex::load() {
+  QFile file(FileSystem::getCacheFilePath(shaderIndexFilename));
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+
+  quint32 magic{};
+  quint32 version{};
+  stream >> magic >> version;
+
+  // the index is just a cache, discard anything we don't understand
+  if (magic != SHADER_INDEX_MAGIC || version != SHADER_INDEX_VERSION) {
+    return;
+  }
+
+  Snapshot loaded{};
+  quint32 count{};
+  stream >> loaded.root >> count;
+
+  for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+    QString key;
+    Script script{};
+    quint32 shaderCount{};
+    stream >> key >> script.version >> shaderCount;
+
+    for (quint32 j = 0;
+         j < shaderCount && stream.status() == QDataStream::Ok; j++) {
+      Shader shader{};
+      stream >> shader.name >> shader.line >> shader.images;
+      script.shaders.append(shader);
+    }
+
+    loaded.scripts.insert(key, script);
+  }
+
+  if (stream.status() == QDataStream::Ok) {
+    setSnapshot(loaded);
+  }
+}
+
+void ShaderIndex::save() const {
+  QSaveFile file(FileSystem::getCacheFilePath(shaderIndexFilename));
+
+  if (!file.open(QIODevice::WriteOnly)) {
+    return;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_2);
+  stream << SHADER_INDEX_MAGIC << SHADER_INDEX_VERSION << snapshot.root
+         << static_cast<quint32>(snapshot.scripts.size());
+
+  for (auto it = snapshot.scripts.cbegin(); it != snapshot.scripts.cend();
+       ++it) {
+    stream << it.key() << it->version
+           << static_cast<quint32>(it->shaders.size());
+
+    for (const auto &shader : it->shaders) {
+      stream << shader.name << shader.line << shader.images;
+    }
+  }
+
+  file.commit();
+}
+
+void ShaderIndex::refresh() {
+  if (scanWatcher->isRunning()) {
+    refreshPending = true;
+    return;
+  }
+
+  const QString mapsPath =
+      preferences.readSetting(Preferences::Settings::MAPS_PATH).toString();
+
+  if (mapsPath.isEmpty()) {
+    setSnapshot({});
+    pendingMap.clear();
+    return;
+  }
+
+  const QString root = QDir::cleanPath(QDir::fromNativeSeparators(mapsPath));
+  scanningMap = pendingMap;
+  pendingMap.clear();
+
+  scanWatcher->setFuture(QtConcurrent::run(
+      [root, previous = snapshot, mapPath = scanningMap] {
+        return scan(root, previous, mapPath);
+      }));
+}
+
+bool ShaderIndex::isRefreshing() const { return scanWatcher->isRunning(); }
+
+void ShaderIndex::checkMap(const QString &mapPath) {
+  pendingMap = mapPath;
+  refresh();
+}
+
+qsizetype ShaderIndex::size() const { return definitions.size(); }
+
+QList<ShaderIndex::Definition>
+ShaderIndex::lookup(const QString &name) const {
+  return definitions.value(name.toLower());
+}
+
+const ShaderIndex::Definitions &ShaderIndex::allDefinitions() const {
+  return definitions;
+}
+
+/*
+ * Shader scripts are a list of 'name { ... }' blocks, where nested blocks
+ * are the stages of the shader. Only the name and the images referenced
+ * by the shader are of interest here, everything else is skipped.
+ */
+QList<ShaderIndex::Shader>
+ShaderIndex::parseShaders(const QByteArrayView script) {
+  enum Expect {
+    EXPECT_KEYWORD,
+    EXPECT_IMAGE,
+    EXPECT_ANIMMAP_FREQUENCY,
+    EXPECT_ANIMMAP_IMAGES,
+  };
+
+  QList<Shader> shaders{};
+  Tokenizer tokenizer(script);
+  Token token{};
+  Token name{};
+  bool haveName = false;
+  bool inShader = false;
+  int depth = 0;
+  Expect expect = EXPECT_KEYWORD;
+  qint32 keywordLine = 0;
+
+  while (tokenizer.next(token)) {
+    if (token.text == "{") {
+      if (depth == 0 && haveName) {
+        Shader shader{};
+        shader.name = QString::fromLatin1(name.text);
+        shader.line = name.line;
+        shaders.append(shader);
+        inShader = true;
+      }
+
+      haveName = false;
+      depth++;
+      expect = EXPECT_KEYWORD;
+      continue;
+    }
+
+    if (token.text == "}") {
+      depth = qMax(0, depth - 1);
+      inShader = inShader && depth > 0;
+      expect = EXPECT_KEYWORD;
+      continue;
+    }
+
+    if (depth == 0) {
+      name = token;
+      haveName = true;
+      continue;
+    }
+
+    if (!inShader) {
+      continue;
+    }
+
+    // arguments of a keyword are on the same line as the keyword
+    if (token.line != keywordLine) {
+      expect = EXPECT_KEYWORD;
+    }
+
+    switch (expect) {
+    case EXPECT_IMAGE:
+      addImage(shaders.last(), token.text);
+      expect = EXPECT_KEYWORD;
+      continue;
+    case EXPECT_ANIMMAP_FREQUENCY:
+      expect = EXPECT_ANIMMAP_IMAGES;
+      continue;
+    case EXPECT_ANIMMAP_IMAGES:
+      addImage(shaders.last(), token.text);
+      continue;
+    case EXPECT_KEYWORD:
+      break;
+    }
+
+    if (isImageKeyword(token.text)) {
+      expect = EXPECT_IMAGE;
+      keywordLine = token.line;
+    } else if (token.text.compare("animmap", Qt::CaseInsensitive) == 0) {
+      expect = EXPECT_ANIMMAP_FREQUENCY;
+      keywordLine = token.line;
+    }
+  }
+
+  return shaders;
+}
+
+/*
+ * Brush faces have the shader after the plane points, or after the texture
+ * matrix for brushDef, so it's always the first token after the last ')'.
+ * Patches have the shader on its own line, after the opening brace.
+ */
+QStringList ShaderIndex::mapShaders(const QString &mapPath, QString &error) {
+  enum PatchState {
+    PATCH_NONE,
+    PATCH_EXPECT_BRACE,
+    PATCH_EXPECT_SHADER,
+  };
+
+  QFile file(mapPath);
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    error = file.errorString();
+    return {};
+  }
+
+  QSet<QString> shaders{};
+  PatchState patchState = PATCH_NONE;
+
+  while (!file.atEnd()) {
+    const QByteArray line = file.readLine().trimmed();
+
+    if (line.isEmpty()) {
+      continue;
+    }
+
+    if (patchState == PATCH_EXPECT_SHADER) {
+      shaders.insert(normalizeShaderName(line.left(line.indexOf(' '))));
+      patchState = PATCH_NONE;
+    } else if (patchState == PATCH_EXPECT_BRACE) {
+      patchState = line == "{" ? PATCH_EXPECT_SHADER : PATCH_NONE;
+    } else if (line.startsWith("patchDef")) {
+      patchState = PATCH_EXPECT_BRACE;
+    } else if (line.startsWith('(')) {
+      const QByteArray rest = line.mid(line.lastIndexOf(')') + 1).trimmed();
+
+      if (!rest.isEmpty()) {
+        shaders.insert(normalizeShaderName(rest.left(rest.indexOf(' '))));
+      }
+    }
+  }
+
+  QStringList result = shaders.values();
+  result.sort();
+  return result;
+}
+
+ShaderIndex::ScanResult ShaderIndex::scan(const QString &root,
+                                          const Snapshot &previous,
+                                          const QString &mapPath) {
+  struct Work {
+    QString key;
+    QString filePath;      // loose scripts
+    qsizetype archive{-1}; // scripts in pk3s
+    qsizetype entry{-1};
+    qint64 version{};
+  };
+
+  ScanResult result{};
+  result.snapshot.root = root;
+
+  const bool sameRoot = previous.root == root;
+  QList<Work> changed{};
+  std::vector<std::unique_ptr<Pk3Archive>> archives{};
+
+  const auto addScript = [&](const Work &work) {
+    const auto cached = previous.scripts.constFind(work.key);
+
+    if (sameRoot && cached != previous.scripts.cend() &&
+        cached->version == work.version) {
+      result.snapshot.scripts.insert(work.key, *cached);
+    } else {
+      changed.append(work);
+    }
+  };
+
+  const QDir rootDir(root);
+  QStringList scriptDirs = {"scripts"};
+
+  for (const auto &pk3dir : rootDir.entryList(
+           {"*.pk3dir"}, QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name)) {
+    scriptDirs.append(pk3dir + "/scripts");
+  }
+
+  for (const auto &dir : scriptDirs) {
+    for (const auto &info : QDir(root + "/" + dir)
+                                .entryInfoList({"*.shader"}, QDir::Files)) {
+      addScript({dir + "/" + info.fileName(), info.filePath(), -1, -1,
+                 info.lastModified().toMSecsSinceEpoch()});
+    }
+  }
+
+  // pk3s are only kept open if they have changed scripts to parse
+  for (const auto &pk3 : rootDir.entryList({"*.pk3"}, QDir::Files)) {
+    auto archive = std::make_unique<Pk3Archive>(root + "/" + pk3);
+
+    if (!archive->open()) {
+      continue;
+    }
+
+    const qsizetype changedBefore = changed.size();
+    const auto &entries = archive->entries();
+
+    for (qsizetype i = 0; i < entries.size(); i++) {
+      const QString &name = entries[i].name;
+
+      if (name.startsWith("scripts/", Qt::CaseInsensitive) &&
+          name.endsWith(".shader", Qt::CaseInsensitive) &&
+          name.indexOf('/', 8) == -1) {
+        addScript({pk3 + "/" + name, {},
+                   static_cast<qsizetype>(archives.size()), i,
+                   entries[i].crc32});
+      }
+    }
+
+    if (changed.size() > changedBefore) {
+      archives.push_back(std::move(archive));
+    }
+  }
+
+  const auto parsed =
+      QtConcurrent::blockingMapped<QList<QPair<QString, Script>>>(
+          changed, [&archives](const Work &work) {
+            Script script{};
+            QByteArray contents{};
+            bool ok = false;
+
+            if (work.archive == -1) {
+              QFile file(work.filePath);
+              ok = file.open(QIODevice::ReadOnly);
+              contents = file.readAll();
+            } else {
+              const Pk3Archive &archive = *archives[work.archive];
+              ok = archive.extract(archive.entries()[work.entry], contents);
+            }
+
+            // unreadable scripts are tried again on the next refresh
+            script.version = ok ? work.version : -1;
+            script.shaders = parseShaders(contents);
+            return qMakePair(work.key, script);
+          });
+
+  for (const auto &[key, script] : parsed) {
+    result.snapshot.scripts.insert(key, script);
+  }
+
+  result.parsedCount = changed.size();
+
+  if (!mapPath.isEmpty()) {
+    result.mapShaders = mapShaders(mapPath, result.mapError);
+  }
+
+  return result;
+}
+
+void ShaderIndex::setSnapshot(const Snapshot &newSnapshot) {
+  snapshot = newSnapshot;
+  definitions.clear();
+
+  // definitions in the order the scripts are listed in
+  QStringList keys = snapshot.scripts.keys();
+  keys.sort(Qt::CaseInsensitive);
+
+  for (const auto &key : keys) {
+    for (const auto &shader : snapshot.scripts[key].shaders) {
+      definitions[shader.name.toLower()].append(
+          {shader.name, key, shader.line, shader.images});
+    }
+  }
+
+  emit indexUpdated();
+}
+
+void ShaderIndex::reportMap(const ScanResult &result) {
+  const auto line = [](const QString &text) {
+    return ("[shaders] " + text).toUtf8();
+  };
+
+  emit outputLine(line(tr("Indexed %n shader(s) from %1 scripts, "
+                          "%2 parsed since the last refresh",
+                          "", static_cast<int>(definitions.size()))
+                           .arg(snapshot.scripts.size())
+                           .arg(result.parsedCount)));
+
+  const QString mapName = QFileInfo(scanningMap).fileName();
+
+  if (!result.mapError.isEmpty()) {
+    emit outputLine(line(
+        tr("Unable to read %1: %2").arg(mapName, result.mapError)));
+    return;
+  }
+
+  QStringList undefined{};
+  QStringList ambiguous{};
+  QSet<QString> images{};
+
+  for (const auto &name : result.mapShaders) {
+    const QList<Definition> found = lookup(name);
+
+    if (found.isEmpty()) {
+      undefined.append(name);
+      continue;
+    }
+
+    if (found.size() > 1) {
+      QStringList scripts{};
+
+      for (const auto &definition : found) {
+        scripts.append(definition.script);
+      }
+
+      ambiguous.append(name + " (" + scripts.join(", ") + ")");
+    }
+
+    for (const auto &image : found.first().images) {
+      images.insert(image);
+    }
+  }
+
+  emit outputLine(line(tr("%1 uses %2 shaders, %3 defined in shader scripts "
+                          "referencing %4 images")
+                           .arg(mapName)
+                           .arg(result.mapShaders.size())
+                           .arg(result.mapShaders.size() - undefined.size())
+                           .arg(images.size())));
+
+  const auto list = [&](const QString &title, const QStringList &names) {
+    if (names.isEmpty()) {
+      return;
+    }
+
+    emit outputLine(line(title));
+
+    for (qsizetype i = 0; i < qMin(names.size(), MAX_LISTED); i++) {
+      emit outputLine(line("  " + names[i]));
+    }
+
+    if (names.size() > MAX_LISTED) {
+      emit outputLine(
+          line(tr("  ...and %1 more").arg(names.size() - MAX_LISTED)));
+    }
+  };
+
+  list(tr("Not defined in any shader script, these must exist as images:"),
+       undefined);
+  list(tr("Defined in more than one script:"), ambiguous);
+}
@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QObject>
+
+// Index of every shader defined in the mapping install, from loose shader
+// scripts, scripts in pk3dirs and scripts inside pk3s, mapping each shader
+// name to the script defining it and the images its stages reference.
+//
+// The index is saved to the cache directory, and a refresh only parses
+// scripts which changed since the previous one, so editing one script only
+// costs re-parsing that script. Changed scripts are parsed in parallel.
+class ShaderIndex : public QObject {
+  Q_OBJECT
+
+public:
+  struct Shader {
+    QString name; // in the case it's written in
+    qint32 line{};
+    QStringList images;
+  };
+
+  struct Definition {
+    QString name;   // in the case it's written in
+    QString script; // relative to the maps path, pk3 entries as pk3/entry
+    qint32 line{};
+    QStringList images;
+  };
+
+  // keyed by lowercase shader name, definitions are in script load order
+  using Definitions = QHash<QString, QList<Definition>>;
+
+  explicit ShaderIndex(QObject *parent);
+
+  void load();
+  void refresh();
+  bool isRefreshing() const;
+
+  // refreshes the index and reports which shaders used by the map
+  // are defined in scripts, through outputLine()
+  void checkMap(const QString &mapPath);
+
+  qsizetype size() const;
+  // every definition of a shader, the name is case-insensitive
+  QList<Definition> lookup(const QString &name) const;
+  const Definitions &allDefinitions() const;
+
+  // shader parsing is exposed so it can be used for single scripts
+  static QList<Shader> parseShaders(QByteArrayView script);
+  // shaders used by brushes and patches of a map, with 'textures/' prefix,
+  // in the case they're written in
+  static QStringList mapShaders(const QString &mapPath, QString &error);
+
+signals:
+  void indexUpdated();
+  void outputLine(const QByteArray &line);
+
+private:
+  struct Script {
+    // modification time of loose scripts, CRC32 of scripts in pk3s
+    qint64 version{};
+    QList<Shader> shaders;
+  };
+
+  struct Snapshot {
+    QString root;
+    QHash<QString, Script> scripts;
+  };
+
+  struct ScanResult {
+    Snapshot snapshot;
+    qsizetype parsedCount{};
+    QStringList mapShaders;
+    QString mapError;
+  };
+
+  static ScanResult scan(const QString &root, const Snapshot &previous,
+                         const QString &mapPath);
+
+  void setSnapshot(const Snapshot &newSnapshot);
+  void save() const;
+  void reportMap(const ScanResult &result);
+
+  Snapshot snapshot;
+  Definitions definitions;
+
+  QFutureWatcher<ScanResult> *scanWatcher;
+  bool refreshPending{};
+  QString pendingMap;
+  QString scanningMap;
+};
@@ -0,0 +1,213 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "speculative_dry_run.h"
+#include "pack3r_output_parser.h"
+#include "process_priority.h"
+#include "runtime_profile.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSet>
+#include <QtConcurrent>
+
+SpeculativeDryRun::SpeculativeDryRun(QObject *parent)
+    : QObject(parent), watcher(new QFutureWatcher<Result>(this)) {
+  connect(watcher, &QFutureWatcher<Result>::finished, this, [&] {
+    if (watcher->future().resultCount() == 0 ||
+        parseGeneration != generation) {
+      return;
+    }
+
+    cached = watcher->result();
+    hasResult = true;
+    emit finished();
+  });
+}
+
+void SpeculativeDryRun::start(const QPair<QString, QStringList> &command,
+                              const QString &mapPath) {
+  const auto dryRun = dryRunCommand(command);
+  Result existing{};
+
+  if (dryRun.first.isEmpty() || mapPath.isEmpty() || isRunning(dryRun) ||
+      result(dryRun, existing)) {
+    return;
+  }
+
+  cancel();
+
+  pending = {};
+  pending.command = dryRun;
+  pending.mapPath = mapPath;
+  pending.mapModified = mapModified(mapPath);
+  processOutput.clear();
+
+  process = new QProcess(this);
+  process->setProgram(dryRun.first);
+  process->setArguments(dryRun.second);
+  process->setProcessChannelMode(QProcess::MergedChannels);
+  ProcessPriority::apply(process, ProcessPriority::background());
+  RuntimeProfile::apply(process, RuntimeProfile::selected());
+
+  connect(process, &QProcess::readyReadStandardOutput, this,
+          [&] { processOutput += process->readAllStandardOutput(); });
+  connect(process, &QProcess::finished, this,
+          [&](const int exitCode, const QProcess::ExitStatus status) {
+            processFinished(status == QProcess::NormalExit ? exitCode : -1);
+          });
+  connect(process, &QProcess::errorOccurred, this,
+          [&](const QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart) {
+              cancel();
+            }
+          });
+
+  process->start();
+
+  // nothing is written, so there's never anything to answer
+  process->closeWriteChannel();
+}
+
+void SpeculativeDryRun::invalidate(
+    const QPair<QString, QStringList> &command) {
+  const auto dryRun = dryRunCommand(command);
+
+  if (process && pending.command != dryRun) {
+    cancel();
+  }
+
+  if (hasResult && cached.command != dryRun) {
+    hasResult = false;
+    cached = {};
+  }
+}
+
+void SpeculativeDryRun::cancel() {
+  generation++;
+
+  if (!process) {
+    return;
+  }
+
+  process->disconnect(this);
+  process->kill();
+  process->deleteLater();
+  process = nullptr;
+  processOutput.clear();
+}
+
+bool SpeculativeDryRun::isRunning(
+    const QPair<QString, QStringList> &command) const {
+  const auto dryRun = dryRunCommand(command);
+  return pending.command == dryRun &&
+         (process || (watcher->isRunning() && parseGeneration == generation));
+}
+
+bool SpeculativeDryRun::result(const QPair<QString, QStringList> &command,
+                               Result &out) const {
+  if (!hasResult || cached.command != dryRunCommand(command) ||
+      cached.mapModified != mapModified(cached.mapPath)) {
+    return false;
+  }
+
+  out = cached;
+  return true;
+}
+
+QPair<QString, QStringList>
+SpeculativeDryRun::dryRunCommand(const QPair<QString, QStringList> &command) {
+  QStringList arguments{};
+
+  for (qsizetype i = 0; i < command.second.size(); i++) {
+    const QString &argument = command.second[i];
+
+    if (argument == "-o") {
+      i++;
+    } else if (argument != "-f" && argument != "-d") {
+      arguments.append(argument);
+    }
+  }
+
+  arguments.append("-d");
+  return {command.first, arguments};
+}
+
+void SpeculativeDryRun::processFinished(const int exitCode) {
+  pending.exitCode = exitCode;
+  pending.finishedAt = QDateTime::currentMSecsSinceEpoch();
+
+  process->deleteLater();
+  process = nullptr;
+
+  parseGeneration = generation;
+  watcher->setFuture(QtConcurrent::run(&SpeculativeDryRun::parse, pending,
+                                       std::move(processOutput)));
+  processOutput.clear();
+}
+
+// the output goes through the same parser as interactive runs, so it can be
+// shown as is. Lines which are nothing but a relative path with an extension
+// are the assets Pack3r would pack.
+SpeculativeDryRun::Result SpeculativeDryRun::parse(Result result,
+                                                   const QByteArray &output) {
+  static const QRegularExpression assetPattern(
+      R"(^[\w\-.]+(/[\w\-.]+)*/[\w\-.]+\.\w{2,4}$)");
+
+  Pack3rOutputParser parser(nullptr);
+  QSet<QString> seen{};
+
+  QObject::connect(
+      &parser, &Pack3rOutputParser::pack3rOutputProcessed,
+      [&result, &seen](const QByteArrayView line) {
+        result.lines.append(line);
+        result.lines.append('\n');
+
+        QString path = QString::fromUtf8(line);
+
+        if (Pack3rOutputParser::logLevel(line) !=
+            Pack3rOutputParser::LOG_NONE) {
+          path = path.mid(path.indexOf(']') + 1);
+        }
+
+        path = path.trimmed();
+
+        if (assetPattern.match(path).hasMatch() &&
+            !seen.contains(path.toLower())) {
+          seen.insert(path.toLower());
+          result.assets.append(path);
+        }
+      });
+
+  parser.processOutput(output);
+  parser.flush();
+
+  result.assets.sort(Qt::CaseInsensitive);
+  return result;
+}
+
+qint64 SpeculativeDryRun::mapModified(const QString &mapPath) {
+  return QFileInfo(mapPath).lastModified().toMSecsSinceEpoch();
+}
@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QProcess>
+
+// Dry run of the selected map, started in the background at the background
+// priority as soon as the map is selected, so the output and the list of
+// assets Pack3r would pack are already known by the time they're needed.
+//
+// Only the result of the latest command is kept. Starting a different
+// command or invalidating the current one kills the process right away.
+class SpeculativeDryRun : public QObject {
+  Q_OBJECT
+
+public:
+  struct Result {
+    QPair<QString, QStringList> command;
+    QString mapPath;
+    qint64 mapModified{};
+    qint64 finishedAt{};
+    int exitCode{};
+    QByteArray lines; // '\n' terminated lines of parsed output
+    QStringList assets;
+  };
+
+  explicit SpeculativeDryRun(QObject *parent);
+
+  // 'command' is turned into a dry run with dryRunCommand()
+  void start(const QPair<QString, QStringList> &command,
+             const QString &mapPath);
+  // drops the run and the result unless they're for 'command'
+  void invalidate(const QPair<QString, QStringList> &command);
+  void cancel();
+
+  bool isRunning(const QPair<QString, QStringList> &command) const;
+  // false if there's no result for 'command' or the map changed since
+  bool result(const QPair<QString, QStringList> &command,
+              Result &out) const;
+
+  // same command with -d, without the output path and overwrite flag,
+  // as a dry run doesn't write anything
+  static QPair<QString, QStringList>
+  dryRunCommand(const QPair<QString, QStringList> &command);
+
+signals:
+  void finished();
+
+private:
+  void processFinished(int exitCode);
+  static Result parse(Result result, const QByteArray &output);
+  static qint64 mapModified(const QString &mapPath);
+
+  QProcess *process{};
+  QByteArray processOutput;
+  Result pending;
+
+  QFutureWatcher<Result> *watcher;
+  Result cached;
+  bool hasResult{};
+
+  // parse results of invalidated runs are dropped
+  quint64 generation{};
+  quint64 parseGeneration{};
+};
@@ -0,0 +1,130 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "system_memory.h"
+
+#include <QFile>
+#include <QHash>
+
+#ifdef Q_OS_LINUX
+#include <sys/resource.h>
+#endif
+
+namespace {
+// values of the 'Name:   1234 kB' lines of a /proc file
+QHash<QByteArray, qint64> readKbFields(const QString &path) {
+  QHash<QByteArray, qint64> fields{};
+
+#ifdef Q_OS_LINUX
+  QFile file(path);
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    return fields;
+  }
+
+  for (const auto &line : file.readAll().split('\n')) {
+    const qsizetype colon = line.indexOf(':');
+
+    if (colon > 0) {
+      const QByteArray value = line.mid(colon + 1).simplified();
+      fields.insert(line.left(colon),
+                    value.left(value.indexOf(' ')).toLongLong());
+    }
+  }
+#else
+  Q_UNUSED(path)
+#endif
+
+  return fields;
+}
+} // namespace
+
+bool SystemMemory::isSupported() {
+#ifdef Q_OS_LINUX
+  return true;
+#else
+  return false;
+#endif
+}
+
+qint64 SystemMemory::totalKb() {
+  return readKbFields("/proc/meminfo").value("MemTotal", -1);
+}
+
+qint64 SystemMemory::availableKb() {
+  return readKbFields("/proc/meminfo").value("MemAvailable", -1);
+}
+
+// the first line is 'some avg10=1.23 avg60=0.50 avg300=0.10 total=12345'
+double SystemMemory::pressure() {
+#ifdef Q_OS_LINUX
+  QFile file("/proc/pressure/memory");
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    return -1;
+  }
+
+  const QByteArray line = file.readLine();
+
+  if (!line.startsWith("some ")) {
+    return -1;
+  }
+
+  for (const auto &field : line.simplified().split(' ')) {
+    if (field.startsWith("avg10=")) {
+      bool ok = false;
+      const double value = field.mid(6).toDouble(&ok);
+      return ok ? value : -1;
+    }
+  }
+#endif
+
+  return -1;
+}
+
+SystemMemory::ProcessMemory SystemMemory::process(const qint64 pid) {
+  ProcessMemory memory{};
+
+  if (pid <= 0) {
+    return memory;
+  }
+
+  const auto fields = readKbFields(QString("/proc/%1/status").arg(pid));
+  memory.rssKb = fields.value("VmRSS", -1);
+  memory.peakKb = fields.value("VmHWM", -1);
+  return memory;
+}
+
+// ru_maxrss is in kilobytes on Linux
+qint64 SystemMemory::childrenPeakKb() {
+#ifdef Q_OS_LINUX
+  rusage usage{};
+
+  if (getrusage(RUSAGE_CHILDREN, &usage) == 0) {
+    return usage.ru_maxrss;
+  }
+#endif
+
+  return -1;
+}
@@ -0,0 +1,53 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+// Memory usage of the system and of processes, read from /proc.
+// Only implemented on Linux, elsewhere every value is unknown.
+class SystemMemory {
+public:
+  struct ProcessMemory {
+    qint64 rssKb{-1};
+    qint64 peakKb{-1}; // peak resident set size since the process started
+  };
+
+  static bool isSupported();
+
+  // -1 if unknown
+  static qint64 totalKb();
+  static qint64 availableKb();
+
+  // share of the last 10 seconds some task was stalled waiting for memory,
+  // in percent, -1 if the kernel doesn't report pressure stall information
+  static double pressure();
+
+  static ProcessMemory process(qint64 pid);
+
+  // largest peak resident set size of all child processes which have
+  // exited and been reaped, -1 if unknown
+  static qint64 childrenPeakKb();
+};
@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * compiler_standin.cpp
+ * Stand-in for a map compiler such as q3map2, used to test the pre-pack
+ * command without compiling a real map.
+ *
+ * Set the pre-pack command in QtPack3r to this executable followed by
+ * "{map}". The map is "compiled" by writing an empty .bsp next to it.
+ * Timing and the result are configured with environment variables:
+ *
+ *   COMPILER_STANDIN_MSECS       how long the compile takes (default 2000)
+ *   COMPILER_STANDIN_STEPS       number of progress lines printed during
+ *                                the compile (default 10)
+ *   COMPILER_STANDIN_EXIT_CODE   exit code, anything but 0 also skips
+ *                                writing the .bsp (default 0)
+ */
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+int envInt(const char *name, const int defaultValue) {
+  bool ok = false;
+  const int value = qEnvironmentVariableIntValue(name, &ok);
+  return ok ? value : defaultValue;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  QCoreApplication app(argc, argv);
+  const QStringList args = QCoreApplication::arguments().mid(1);
+
+  // the map is the last argument, like with q3map2
+  if (args.isEmpty() || args.last().startsWith('-')) {
+    fprintf(stderr, "No map given\n");
+    return EXIT_FAILURE;
+  }
+
+  const QFileInfo map(args.last());
+  const int msecs = qMax(0, envInt("COMPILER_STANDIN_MSECS", 2000));
+  const int steps = qMax(1, envInt("COMPILER_STANDIN_STEPS", 10));
+  const int exitCode = envInt("COMPILER_STANDIN_EXIT_CODE", 0);
+
+  printf("Compiling %s\n", qUtf8Printable(map.fileName()));
+  fflush(stdout);
+
+  for (int i = 1; i <= steps; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(msecs / steps));
+    printf("--- Step %d/%d ---\n", i, steps);
+    fflush(stdout);
+  }
+
+  if (exitCode != 0) {
+    fprintf(stderr, "Compile failed\n");
+    return exitCode;
+  }
+
+  const QString bspPath =
+      map.absolutePath() + '/' + map.completeBaseName() + ".bsp";
+  QFile bsp(bspPath);
+
+  if (!bsp.open(QIODevice::WriteOnly)) {
+    fprintf(stderr, "Unable to write %s\n", qUtf8Printable(bspPath));
+    return EXIT_FAILURE;
+  }
+
+  printf("Wrote %s\n", qUtf8Printable(bspPath));
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,262 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Aciz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * pack3r_standin.cpp
+ * Stand-in for Pack3r which emulates its command line and output, used to
+ * load test output handling of QtPack3r without depending on a real map.
+ *
+ * Set the Pack3r path in QtPack3r to this executable. Output is configured
+ * with environment variables:
+ *
+ *   PACK3R_STANDIN_LINES         number of lines to print (default 10000)
+ *   PACK3R_STANDIN_RATE          lines per second, 0 for unlimited (default 0)
+ *   PACK3R_STANDIN_LINE_LENGTH   length of each line (default 100)
+ *   PACK3R_STANDIN_PROGRESS      print a burst of carriage return progress
+ *                                updates every N lines, 0 for none
+ *                                (default 500)
+ *   PACK3R_STANDIN_REPLAY        replay a recording made with
+ *                                QTPACK3R_RECORD_OUTPUT instead
+ *   PACK3R_STANDIN_REPLAY_SPEED  replay speed multiplier, 0 for as fast as
+ *                                possible (default 1)
+ */
+
+#include "output_recording.h"
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+// Pack3r prints this without a newline and waits for an answer
+constexpr char OVERWRITE_PROMPT[] = "Overwrite? Y/N";
+
+// options which take a value, the rest are flags
+const QStringList valueOptions = {"-o", "-r", "-v", "-ns", "-np", "-m"};
+
+const QList<QByteArray> severities = {"[INF] ", "[DBG] ", "[TRC] ", "[INF] ",
+                                      "[WRN] ", "[DBG] ", "[TRC] ", "[ERR] "};
+
+struct Arguments {
+  QString mapPath;
+  QString outputPath;
+  bool dryRun{};
+  bool overwrite{};
+};
+
+int envInt(const char *name, const int defaultValue) {
+  bool ok = false;
+  const int value = qEnvironmentVariableIntValue(name, &ok);
+  return ok ? value : defaultValue;
+}
+
+void writeOut(const QByteArrayView data) {
+  fwrite(data.data(), 1, data.size(), stdout);
+}
+
+Arguments parseArguments(const QStringList &args) {
+  Arguments parsed{};
+
+  for (qsizetype i = 0; i < args.size(); i++) {
+    if (valueOptions.contains(args[i])) {
+      if (args[i] == "-o" && i + 1 < args.size()) {
+        parsed.outputPath = args[i + 1];
+      }
+
+      i++;
+    } else if (args[i] == "-d") {
+      parsed.dryRun = true;
+    } else if (args[i] == "-f") {
+      parsed.overwrite = true;
+    } else if (!args[i].startsWith('-') && parsed.mapPath.isEmpty()) {
+      parsed.mapPath = args[i];
+    }
+  }
+
+  if (parsed.outputPath.isEmpty()) {
+    const QFileInfo map(parsed.mapPath);
+    parsed.outputPath =
+        map.absolutePath() + "/../" + map.completeBaseName() + ".pk3";
+  }
+
+  return parsed;
+}
+
+// asks the same question as Pack3r when the output exists,
+// returns false if the answer is no
+bool confirmOverwrite() {
+  writeOut(OVERWRITE_PROMPT);
+  fflush(stdout);
+
+  char answer[16]{};
+
+  if (!fgets(answer, sizeof(answer), stdin)) {
+    return false;
+  }
+
+  return answer[0] == 'y' || answer[0] == 'Y';
+}
+
+void emulateOutput(const QString &mapName) {
+  const int lines = envInt("PACK3R_STANDIN_LINES", 10000);
+  const int rate = envInt("PACK3R_STANDIN_RATE", 0);
+  const int lineLength = qMax(16, envInt("PACK3R_STANDIN_LINE_LENGTH", 100));
+  const int progressInterval = envInt("PACK3R_STANDIN_PROGRESS", 500);
+
+  const auto start = std::chrono::steady_clock::now();
+  QByteArray line{};
+  line.reserve(lineLength + 1);
+
+  for (int i = 0; i < lines; i++) {
+    if (rate > 0) {
+      std::this_thread::sleep_until(
+          start + std::chrono::microseconds(1000000LL * i / rate));
+    }
+
+    const QByteArray &severity = severities[i % severities.size()];
+    line = severity;
+    line += QString("textures/%1/asset_%2.tga referenced by shader %3")
+                .arg(mapName)
+                .arg(i)
+                .arg(i % 97)
+                .toUtf8();
+
+    if (line.size() < lineLength) {
+      line.append(lineLength - line.size(), '.');
+    } else {
+      line.truncate(lineLength);
+    }
+
+    line += '\n';
+    writeOut(line);
+
+    if (progressInterval > 0 && i % progressInterval == 0) {
+      for (int percent = 0; percent <= 100; percent += 10) {
+        writeOut(QString("\rParsing assets... %1%").arg(percent).toUtf8());
+      }
+
+      writeOut("\n");
+    }
+
+    // flush in roughly pipe sized pieces, like a real process would
+    if (rate > 0 || i % 64 == 0) {
+      fflush(stdout);
+    }
+  }
+}
+
+bool replay(const QString &path) {
+  QList<OutputRecording::Chunk> chunks{};
+  QString error{};
+
+  if (!OutputRecording::read(path, chunks, error)) {
+    fprintf(stderr, "Unable to replay %s: %s\n", qUtf8Printable(path),
+            qUtf8Printable(error));
+    return false;
+  }
+
+  bool ok = false;
+  double speed =
+      qEnvironmentVariable("PACK3R_STANDIN_REPLAY_SPEED").toDouble(&ok);
+
+  if (!ok) {
+    speed = 1.0;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (const auto &chunk : chunks) {
+    if (speed > 0) {
+      std::this_thread::sleep_until(
+          start + std::chrono::nanoseconds(
+                      static_cast<qint64>(chunk.nsecs / speed)));
+    }
+
+    // the recording has the prompt, but not the answer to it
+    if (chunk.data.contains(OVERWRITE_PROMPT)) {
+      writeOut(chunk.data);
+      fflush(stdout);
+
+      char answer[16]{};
+
+      if (!fgets(answer, sizeof(answer), stdin) ||
+          (answer[0] != 'y' && answer[0] != 'Y')) {
+        return true;
+      }
+
+      continue;
+    }
+
+    writeOut(chunk.data);
+    fflush(stdout);
+  }
+
+  return true;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  QCoreApplication app(argc, argv);
+  const QStringList args = QCoreApplication::arguments().mid(1);
+
+  if (args.contains("--version")) {
+    writeOut("0.0.0+standin\n");
+    return EXIT_SUCCESS;
+  }
+
+  const QString replayPath = qEnvironmentVariable("PACK3R_STANDIN_REPLAY");
+
+  if (!replayPath.isEmpty()) {
+    return replay(replayPath) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  const Arguments parsed = parseArguments(args);
+
+  if (parsed.mapPath.isEmpty()) {
+    fprintf(stderr, "No map given\n");
+    return EXIT_FAILURE;
+  }
+
+  if (!parsed.dryRun && !parsed.overwrite &&
+      QFileInfo::exists(parsed.outputPath) && !confirmOverwrite()) {
+    return EXIT_SUCCESS;
+  }
+
+  emulateOutput(QFileInfo(parsed.mapPath).completeBaseName());
+
+  if (!parsed.dryRun) {
+    QFile output(parsed.outputPath);
+
+    if (!output.open(QIODevice::WriteOnly)) {
+      fprintf(stderr, "Unable to write %s\n",
+              qUtf8Printable(parsed.outputPath));
+      return EXIT_FAILURE;
+    }
+  }
+
+  writeOut("[INF] Done\n");
+  return EXIT_SUCCESS;
+}